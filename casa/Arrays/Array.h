@@ -160,7 +160,7 @@ public:
     // Create an array of the given shape, i.e. after construction
     // array.ndim() == shape.nelements() and array.shape() == shape.
     // The origin of the Array is zero.
-    // Storage is allocated by <src>DefaultAllocator<T></src>.
+    // Storage is allocated (64-byte aligned) by <src>ArrayMemoryPool</src>.
     // Without initPolicy parameter, the initialization of elements depends on type <src>T</src>.
     // When <src>T</src> is a fundamental type like <src>int</src>, elements are NOT initialized.
     // When <src>T</src> is a class type like <src>casacore::Complex</src> or <src>std::string</src>, elements are initialized.
@@ -172,7 +172,7 @@ public:
 
     // Create an array of the given shape and initialize it with the
     // initial value.
-    // Storage is allocated by <src>DefaultAllocator<T></src>.
+    // Storage is allocated (64-byte aligned) by <src>ArrayMemoryPool</src>.
     Array(const IPosition &shape, const T &initialValue);
     
     // This is a tag for the constructor that may be used to construct an uninitialized Array.
@@ -200,7 +200,8 @@ public:
 
     // Create an Array of a given shape from a pointer.
     // If <src>policy</src> is <src>COPY</src>, storage of a new copy is allocated by <src>DefaultAllocator<T></src>.
-    // If <src>policy</src> is <src>TAKE_OVER</src>, <src>storage</src> will be destructed and released by the specified allocator.
+    // If <src>policy</src> is <src>TAKE_OVER</src>, <src>storage</src> will be destructed and freed
+    // by <src>ArrayMemoryPool</src>, so it must have been allocated by <src>DefaultAllocator<T></src> or <src>getStorage</src>.
     // <srcblock>
     //   FILE *fp = ...;
     //   typedef DefaultAllocator<int> Alloc;
@@ -645,7 +646,8 @@ public:
     // is 1.
     // <group>
     // If <src>policy</src> is <src>COPY</src>, storage of a new copy is allocated by <src>allocator</src>.
-    // If <src>policy</src> is <src>TAKE_OVER</src>, <src>storage</src> will be destructed and released by <src>allocator</src>.
+    // If <src>policy</src> is <src>TAKE_OVER</src>, <src>storage</src> will be destructed and freed
+    // by <src>ArrayMemoryPool</src>, so it must have been allocated by <src>DefaultAllocator<T></src> or <src>getStorage</src>.
     virtual void takeStorage(const IPosition &shape, T *storage,
         StorageInitPolicy policy = COPY);
 
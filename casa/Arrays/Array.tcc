@@ -32,6 +32,7 @@
 #include "ArrayError.h"
 #include "ArrayIter.h"
 #include "ArrayPosIter.h"
+#include "ArrayRuns.h"
 #include "Memory.h"
 #include "MaskedArray.h"
 #include "Slicer.h"
@@ -305,30 +306,12 @@ template<class T> void Array<T>::copyToContiguousStorage(T *storage, Array<T> co
     // Special case which can be quite common (e.g. row in a matrix).
     copy_n_with_stride(src.begin_p, src.length_p(1), storage, 1U,
       src.originalLength_p(0) * src.inc_p(1));
-  } else if (src.length_p(0) <= 25) {
-    // If not many elements on a line, it's better to use this loop.
-    T* ptr = storage;
-    const_iterator iterend = src.end();
-    for (const_iterator iter = src.begin(); iter != iterend; ++iter) {
-      *ptr++ = *iter;
-    }
   } else {
-    // Step through Vector by Vector
-    // The output is guaranteed to have all incs set to 1
-    ArrayPositionIterator ai(src.shape(), 1);
-    IPosition index(src.ndim());
-    size_t count = 0;
-    size_t const size = src.length_p(0);
-    while (!ai.pastEnd()) {
-      index = ai.pos();
-      size_t offset = ArrayIndexOffset(src.ndim(),
-        src.originalLength_p.storage(), src.inc_p.storage(),
-        index);
-      copy_n_with_stride(src.begin_p + offset, size, storage + count * size,
-        1U, src.inc_p(0));
-      ai.next();
-      count++;
-    }
+    // Step through the array in runs; the output is contiguous.
+    T* ptr = storage;
+    arrayForEachRun (src, [&ptr](const T* from, ssize_t incr, size_t n)
+                     { copy_n_with_stride (from, n, ptr, 1U, incr);
+                       ptr += n; });
   }
 }
 
@@ -356,9 +339,6 @@ Array<T>& Array<T>::assign_conforming_implementation(const Array<T>& other, std:
   if (!Conform  &&  nelements() != 0) {
     validateConformance(other);  // We can't overwrite, so throw exception
   }
-  size_t offset, offset2;
-  IPosition index(other.ndim());
-
   if (Conform == true) { // Copy in place
     if (ndim() == 0) {
 	    return *this;
@@ -371,29 +351,12 @@ Array<T>& Array<T>::assign_conforming_implementation(const Array<T>& other, std:
       copy_n_with_stride(other.begin_p, length_p(1), begin_p,
         originalLength_p(0)*inc_p(1),
         other.originalLength_p(0)*other.inc_p(1));
-    } else if (length_p(0) <= 25) {
-      // If not many elements on a line, it's better to use this loop.
-      const_iterator from(other.begin());
-      iterator iterend=end();
-      for (iterator iter=begin(); iter!=iterend; ++iter)
-      {
-        *iter = *from;
-        ++from;
-      }
     } else {
-      ArrayPositionIterator ai(other.shape(), 1);
-      // Step through Vector by Vector
-      while (! ai.pastEnd()) {
-        index = ai.pos();
-        offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-          inc_p.storage(), index);
-        offset2 = ArrayIndexOffset(other.ndim(),
-        other.originalLength_p.storage(),
-        other.inc_p.storage(), index);
-        copy_n_with_stride(other.begin_p+offset2, length_p(0),
-          begin_p+offset, inc_p(0), other.inc_p(0));
-        ai.next();
-      }
+      // Step through both arrays in runs.
+      arrayForEachRun (*this, other,
+                       [](T* to, ssize_t toIncr,
+                          const T* from, ssize_t fromIncr, size_t n)
+                       { copy_n_with_stride (from, n, to, toIncr, fromIncr); });
     }
   } else {
     // Array was empty; make a new copy and reference it.
@@ -460,8 +423,6 @@ template<class T> void Array<T>::set(const T &Value)
 
   // Ultimately we should go to RawFillAll functions
   // RawFillAll(ndim(), begin_p, inc_p.storage(), length_p.storage(), Value);
-  // Step through Vector by Vector
-  size_t offset;
   if (ndim() == 0) {
       return;
   } else if (contiguousStorage()) {
@@ -472,24 +433,10 @@ template<class T> void Array<T>::set(const T &Value)
     // Special case which can be quite common (e.g. row in a matrix).
     fill_n_with_stride (begin_p, length_p(1), Value,
       originalLength_p(0)*inc_p(1));
-  } else if (length_p(0) <= 25) {
-      // If not many elements on a line, it's better to use this loop.
-      iterator iterend=end();
-      for (iterator iter=begin(); iter!=iterend; ++iter) {
-    *iter = Value;
-    }
   } else {
-    // Step through Vector by Vector
-    ArrayPositionIterator ai(shape(), 1);
-    IPosition index(ndim());
-    while (! ai.pastEnd())
-    {
-      index = ai.pos();
-      offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-              inc_p.storage(), index);
-      fill_n_with_stride(begin_p+offset, length_p(0), Value, inc_p(0));
-      ai.next();
-    }
+    // Step through the array in runs.
+    arrayForEachRun (*this, [&Value](T* to, ssize_t incr, size_t n)
+                     { fill_n_with_stride (to, n, Value, incr); });
   }
 }
 
@@ -508,23 +455,12 @@ void Array<T>::apply(Callable function)
 	    begin_p[i] = function(begin_p[i]);
 	}
     } else {
-	// Step through Vector by Vector
-	ArrayPositionIterator ai(shape(), 1);
-	IPosition index(ndim());
-
-	size_t len  = length_p(0);
-	size_t incr = inc_p(0);
-	size_t offset;
-
-	while (! ai.pastEnd()) {
-	    index = ai.pos();
-	    offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-				      inc_p.storage(), index);
-	    for (size_t i=0; i < len; i++) {
-		begin_p[offset+i*incr] = function(begin_p[offset+i*incr]);
+	// Step through the array in runs.
+	arrayForEachRun (*this, [&function](T* p, ssize_t incr, size_t n) {
+	    for (size_t i=0; i<n; i++, p+=incr) {
+		*p = function(*p);
 	    }
-	    ai.next();
-	}
+	});
     }
 }
 
@@ -951,7 +887,9 @@ T* Array<T>::getStorage(bool& deleteIt)
 
   // We need to do a copy
   size_t n = nelements();
-  T* storage = std::allocator<T>().allocate(n);
+  // The copy is not cached, because caching can be switched on before
+  // freeStorage is called.
+  T* storage = arrays_internal::Storage<T>::allocate(n, false);
   try {
     for(size_t i=0; i!=n; ++i)
       new (&storage[i]) T();
@@ -960,7 +898,7 @@ T* Array<T>::getStorage(bool& deleteIt)
     // TODO To be correct, the destructors of the already
     // constructed object should be called, but this is
     // a border case so ignored for now.
-    std::allocator<T>().deallocate(storage, nelements());
+    arrays_internal::Storage<T>::deallocate(storage, nelements(), false);
     throw;
   }
   deleteIt = true;
@@ -982,27 +920,12 @@ template<class T> void Array<T>::putStorage(T *&storage, bool deleteAndCopy)
     // Special case which can be quite common (e.g. row in a matrix).
     move_n_with_stride(storage, length_p(1), begin_p,
       originalLength_p(0)*inc_p(1), 1U);
-  } else if (length_p(0) <= 25) {
-    // If not many elements on a line, it's better to use this loop.
-    T* ptr = storage;
-    iterator iterend=end();
-    for (iterator iter=begin(); iter!=iterend; ++iter) {
-      *iter = std::move(*ptr);
-      ++ptr;
-    }
   } else {
-    ArrayPositionIterator ai(this->shape(), 1);
-    size_t offset;
-    IPosition index(ndim());
-    size_t count=0;
-    while (! ai.pastEnd()) {
-      index = ai.pos();
-      offset = ArrayIndexOffset(ndim(), originalLength_p.storage(),
-        inc_p.storage(), index);
-      move_n_with_stride(storage+count*length_p(0), length_p(0), begin_p+offset, inc_p(0), 1U);
-      ai.next();
-      count++;
-    }
+    // Step through the array in runs; the storage is contiguous.
+    T* ptr = storage;
+    arrayForEachRun (*this, [&ptr](T* to, ssize_t incr, size_t n)
+                     { move_n_with_stride (ptr, n, to, incr, 1U);
+                       ptr += n; });
   }
   T const * &fakeStorage = const_cast<T const *&>(storage);
   freeStorage(fakeStorage, deleteAndCopy);
@@ -1020,10 +943,7 @@ void Array<T>::freeStorage(const T*&storage, bool deleteIt) const
     size_t n = nelements();
     for(size_t i=0; i!=n; ++i)
       ptr[i].~T();
-    // TODO this is only allowed when allocator is always equal, but is done for
-    // now to keep the method const.
-    // see e.g. std::allocator_traits<allocator_type>::is_always_equal
-    std::allocator<T>().deallocate(ptr, n);
+    arrays_internal::Storage<T>::deallocate(ptr, n, false);
   }
   storage = nullptr;
 }
@@ -1078,9 +998,11 @@ void Array<T>::takeStorage(const IPosition &shape, T *storage,
   if(policy == TAKE_OVER)
   {
     // TODO this is not consistent with old behaviour
+    // The storage is freed like the storage of getStorage or
+    // DefaultAllocator (i.e. uncached by ArrayMemoryPool).
     for(size_t i=0; i!=new_nels; ++i)
       storage[new_nels-i-1].~T();
-    std::allocator<T>().deallocate(storage, new_nels);
+    arrays_internal::Storage<T>::deallocate(storage, new_nels, false);
   }
   
   // Call OK at the end rather than the beginning since this might
@@ -27,6 +27,7 @@
 #include "ArrayError.h"
 #include "Matrix.h"
 
+#include <cmath>
 #include <complex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -91,16 +92,60 @@ void imag(Array<double> &rarray, const Array<std::complex<double>> &carray)
   arrayTransform (carray, rarray, [](std::complex<double> v) { return std::imag(v); });
 }
 
+namespace {
+  // Calculate the amplitudes with the given function of the real and
+  // imaginary part, which avoids the call to hypot done by std::abs and
+  // can be vectorized. Results for which <src>isExact(result,value)</src>
+  // is false (e.g. due to overflow or NaN) are redone with std::abs.
+  template<typename T, typename Func, typename Check>
+  void amplitudeRuns (Array<T> &rarray, const Array<std::complex<T>> &carray,
+                      Func func, Check isExact)
+  {
+    arrayForEachRun (carray, rarray,
+                     [&func,&isExact](const std::complex<T>* c, ssize_t cincr,
+                                      T* r, ssize_t rincr, size_t n) {
+      // A std::complex<T> has the layout of T[2].
+      const T* p = reinterpret_cast<const T*>(c);
+      if (cincr == 1  &&  rincr == 1) {
+        for (size_t i=0; i<n; ++i) {
+          r[i] = func (p[2*i], p[2*i+1]);
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          r[i*rincr] = func (p[2*i*cincr], p[2*i*cincr+1]);
+        }
+      }
+      for (size_t i=0; i<n; ++i) {
+        if (! isExact (r[i*rincr], c[i*cincr])) {
+          r[i*rincr] = std::abs (c[i*cincr]);
+        }
+      }
+    });
+  }
+}
+
 void amplitude(Array<float> &rarray, const Array<std::complex<float>> &carray)
 {
   checkArrayShapes (carray, rarray, "amplitude");
-  arrayTransform (carray, rarray, std::abs<float>);
+  // In double precision the squares cannot overflow or underflow, so
+  // only NaN (which can be Inf for std::abs) needs to be redone.
+  amplitudeRuns (rarray, carray,
+                 [](float re, float im)
+                 { return float(std::sqrt (double(re)*re + double(im)*im)); },
+                 [](float v, const std::complex<float>&)
+                 { return !std::isnan(v); });
 }
 
 void amplitude(Array<double> &rarray, const Array<std::complex<double>> &carray)
 {
   checkArrayShapes (carray, rarray, "amplitude");
-  arrayTransform (carray, rarray, std::abs<double>);
+  // Redo results that might suffer from overflow or underflow of the
+  // squares, and NaN. Zeros (e.g. flagged data) are exact.
+  amplitudeRuns (rarray, carray,
+                 [](double re, double im) { return std::sqrt (re*re + im*im); },
+                 [](double v, const std::complex<double>& c)
+                 { return (v >= 1e-150  &&  v <= 1e150)  ||
+                          (c.real() == 0  &&  c.imag() == 0); });
 }
 
 void phase(Array<float> &rarray, const Array<std::complex<float>> &carray)
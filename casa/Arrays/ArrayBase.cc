@@ -728,14 +728,14 @@ void ArrayBase::checkVectorShape()
     // Check if all elements are 1 or nels_p. In this way we are sure that
     // only one axis remains (i.e. at most one axis has length > 1).
     // Keep original increment and length of the remaining axis.
-    int inc   = 1;
-    int orLen = 1;
-    int skippedVolume = 1;
+    ssize_t inc   = 1;
+    ssize_t orLen = 1;
+    ssize_t skippedVolume = 1;
     for (size_t i=0; i<ndim(); ++i) {
       if (length_p[i] == 1) {
 	skippedVolume *= originalLength_p(i);
       } else {
-	if (length_p[i] != int(nels_p)) {
+	if (length_p[i] != ssize_t(nels_p)) {
 	  throw(ArrayNDimError(1, ndim(),
 			       "Vector<T>: ndim of other array > 1"));
 	}
@@ -0,0 +1,571 @@
+//# ArrayExpr.h: Lazy, fused element-wise expressions of Arrays
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYEXPR_2_H
+#define CASA_ARRAYEXPR_2_H
+
+#include "Array.h"
+#include "ArrayBase.h"
+#include "ArrayRuns.h"
+#include "IPosition.h"
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Lazy, fused element-wise expressions of Arrays.
+// </summary>
+// <!-- <reviewed reviewer="UNKNOWN" date="" tests="tArrayExpr"> -->
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+//   <li> <linkto group="ArrayMath.h#Array mathematical operations">ArrayMath</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// The operators and functions in ArrayMath.h are eager: each of them
+// creates a temporary Array holding its result. Thus an expression like
+// <src>abs(a*b + c) * w</src> allocates and traverses an array for each
+// operation, which is expensive for large arrays.
+//
+// The classes and functions in this file form an opt-in alternative.
+// An expression is started by wrapping an Array with the function
+// <src>arrayExpr</src>. Applying the operators and functions below to it
+// does not calculate anything, but builds an expression object
+// (an <src>ArrayExpr</src>) referencing the operand arrays.
+// The expression is evaluated in a single loop over the elements when it
+// is assigned to (or converted to) an Array, or when it is evaluated into
+// an existing Array using <src>evaluateArrayExpr</src>.
+// The latter does not create any temporary array at all.
+// <br>Contiguous operands are accessed directly, while non-contiguous
+// ones (e.g. array sections) are accessed using their STL-style iterators.
+//
+// The arithmetic operators +, -, *, / can be applied to two expressions,
+// an expression and an Array, and an expression and a scalar of its
+// value type. Furthermore the usual element-wise mathematical functions
+// are defined for expressions.
+// As with the eager functions, the shapes of the operands must be equal;
+// otherwise an ArrayConformanceError exception is thrown.
+//
+// Note that the expression references the data of its operands, so they
+// should not be resized before the expression is evaluated.
+// An operand can be the same array as the result, provided it is not
+// a differently positioned section of the same data.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Cube<Complex> a, b, c;
+//   Cube<Float> w, res;
+//   ...
+//   // Evaluate in a single loop into a new array.
+//   Array<Float> res1 = abs(arrayExpr(a)*b + c) * w;
+//   // Evaluate into the existing array res without any temporary array.
+//   evaluateArrayExpr (res, abs(arrayExpr(a)*b + c) * w);
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Avoid the temporary arrays and multiple passes through memory for
+// compound expressions on large arrays (e.g. visibility data).
+// </motivation>
+//
+// <group name="Array expressions">
+
+// Base class (using the CRTP idiom) of all array expression nodes.
+// T is the value type of the expression; E the type of the actual node.
+template<typename T, typename E>
+class ArrayExpr
+{
+public:
+  typedef T value_type;
+
+  // Get the actual expression node.
+  const E& node() const
+    { return static_cast<const E&>(*this); }
+
+  // Get the shape of the expression.
+  IPosition shape() const
+    { return node().shape(); }
+
+  // Evaluate the expression into a new Array.
+  Array<T> evaluate() const
+  {
+    Array<T> result (makeResult (node().shape(), std::is_trivial<T>()));
+    evaluateInto (result);
+    return result;
+  }
+
+  // Converting to an Array evaluates the expression, so an expression
+  // can be assigned to an Array.
+  operator Array<T>() const
+    { return evaluate(); }
+
+  // Evaluate the expression into an existing Array which must have the
+  // same shape or be empty (in which case it is resized).
+  template<typename U>
+  void evaluateInto (Array<U>& result) const;
+
+private:
+  // Create the result array; only trivial types can be left uninitialized.
+  // <group>
+  static Array<T> makeResult (const IPosition& shape, std::true_type)
+    { return Array<T> (shape, typename Array<T>::uninitializedType()); }
+  static Array<T> makeResult (const IPosition& shape, std::false_type)
+    { return Array<T> (shape); }
+  // </group>
+};
+
+// Evaluate an expression into an existing Array which must have the same
+// shape as the expression or be empty (in which case it is resized).
+template<typename U, typename T, typename E>
+inline Array<U>& evaluateArrayExpr (Array<U>& result,
+                                    const ArrayExpr<T,E>& expr)
+{
+  expr.evaluateInto (result);
+  return result;
+}
+
+// </group>
+
+
+namespace arrays_internal {
+
+  // Leaf of an expression referencing an Array.
+  template<typename T>
+  class ArrayExprLeaf : public ArrayExpr<T, ArrayExprLeaf<T>>
+  {
+  public:
+    static constexpr bool isScalar = false;
+    class Cursor
+    {
+    public:
+      explicit Cursor (const Array<T>& arr)
+        : iter_p (arr.begin())
+      {}
+      const T& value() const
+        { return *iter_p; }
+      void next()
+        { ++iter_p; }
+    private:
+      typename Array<T>::const_iterator iter_p;
+    };
+
+    explicit ArrayExprLeaf (const Array<T>& arr)
+      : arr_p    (arr),
+        data_p   (arr_p.data()),
+        contig_p (arr_p.contiguousStorage())
+    {}
+    IPosition shape() const
+      { return arr_p.shape(); }
+    bool contiguous() const
+      { return contig_p; }
+    // Get the i-th value; only valid for contiguous arrays.
+    const T& at (size_t i) const
+      { return data_p[i]; }
+    Cursor cursor() const
+      { return Cursor(arr_p); }
+  private:
+    //# Keep a reference (not a copy) of the array alive in the expression.
+    Array<T> arr_p;
+    const T* data_p;
+    bool     contig_p;
+  };
+
+  // Leaf of an expression containing a scalar.
+  template<typename T>
+  class ArrayExprScalar
+  {
+  public:
+    typedef T value_type;
+    static constexpr bool isScalar = true;
+    class Cursor
+    {
+    public:
+      explicit Cursor (const T& value)
+        : value_p (value)
+      {}
+      const T& value() const
+        { return value_p; }
+      void next()
+      {}
+    private:
+      T value_p;
+    };
+
+    explicit ArrayExprScalar (const T& value)
+      : value_p (value)
+    {}
+    IPosition shape() const
+      { return IPosition(); }
+    bool contiguous() const
+      { return true; }
+    const T& at (size_t) const
+      { return value_p; }
+    Cursor cursor() const
+      { return Cursor(value_p); }
+  private:
+    T value_p;
+  };
+
+  // Result type of applying a unary or binary operator.
+  // <group>
+  template<typename Op, typename T>
+  struct ArrayExprUnaryResult
+  {
+    typedef typename std::decay<decltype(std::declval<Op>()
+                                         (std::declval<T>()))>::type type;
+  };
+  template<typename Op, typename L, typename R>
+  struct ArrayExprBinaryResult
+  {
+    typedef typename std::decay<decltype(std::declval<Op>()
+                                         (std::declval<L>(),
+                                          std::declval<R>()))>::type type;
+  };
+  // </group>
+
+  // Node applying a unary operator to an expression.
+  template<typename E, typename Op>
+  class ArrayExprUnary
+    : public ArrayExpr<typename ArrayExprUnaryResult
+                         <Op, typename E::value_type>::type,
+                       ArrayExprUnary<E,Op>>
+  {
+  public:
+    typedef typename ArrayExprUnaryResult
+      <Op, typename E::value_type>::type value_type;
+    static constexpr bool isScalar = false;
+    class Cursor
+    {
+    public:
+      Cursor (const typename E::Cursor& cursor, const Op& op)
+        : cursor_p (cursor),
+          op_p     (op)
+      {}
+      value_type value() const
+        { return op_p (cursor_p.value()); }
+      void next()
+        { cursor_p.next(); }
+    private:
+      typename E::Cursor cursor_p;
+      Op                 op_p;
+    };
+
+    ArrayExprUnary (const E& expr, const Op& op)
+      : expr_p (expr),
+        op_p   (op)
+    {}
+    IPosition shape() const
+      { return expr_p.shape(); }
+    bool contiguous() const
+      { return expr_p.contiguous(); }
+    value_type at (size_t i) const
+      { return op_p (expr_p.at(i)); }
+    Cursor cursor() const
+      { return Cursor (expr_p.cursor(), op_p); }
+  private:
+    E  expr_p;
+    Op op_p;
+  };
+
+  // Node applying a binary operator to two expressions
+  // (of which at most one can be a scalar).
+  template<typename L, typename R, typename Op>
+  class ArrayExprBinary
+    : public ArrayExpr<typename ArrayExprBinaryResult
+                         <Op, typename L::value_type,
+                          typename R::value_type>::type,
+                       ArrayExprBinary<L,R,Op>>
+  {
+  public:
+    typedef typename ArrayExprBinaryResult
+      <Op, typename L::value_type, typename R::value_type>::type value_type;
+    static constexpr bool isScalar = false;
+    class Cursor
+    {
+    public:
+      Cursor (const typename L::Cursor& left,
+              const typename R::Cursor& right, const Op& op)
+        : left_p  (left),
+          right_p (right),
+          op_p    (op)
+      {}
+      value_type value() const
+        { return op_p (left_p.value(), right_p.value()); }
+      void next()
+        { left_p.next(); right_p.next(); }
+    private:
+      typename L::Cursor left_p;
+      typename R::Cursor right_p;
+      Op                 op_p;
+    };
+
+    ArrayExprBinary (const L& left, const R& right, const Op& op,
+                     const char* name)
+      : left_p  (left),
+        right_p (right),
+        op_p    (op)
+    {
+      if (!L::isScalar  &&  !R::isScalar) {
+        IPosition lshape = left_p.shape();
+        IPosition rshape = right_p.shape();
+        if (! lshape.isEqual (rshape)) {
+          throwArrayShapes (lshape, rshape, name);
+        }
+      }
+    }
+    IPosition shape() const
+      { return L::isScalar ? right_p.shape() : left_p.shape(); }
+    bool contiguous() const
+      { return left_p.contiguous()  &&  right_p.contiguous(); }
+    value_type at (size_t i) const
+      { return op_p (left_p.at(i), right_p.at(i)); }
+    Cursor cursor() const
+      { return Cursor (left_p.cursor(), right_p.cursor(), op_p); }
+  private:
+    L  left_p;
+    R  right_p;
+    Op op_p;
+  };
+
+  // The operators used in the expression nodes.
+  // They are templated on the operand types, so they work for mixed
+  // types (e.g. complex and real) as well.
+  // <group>
+#define CASA_ARRAYEXPR_BINOP(NAME, EXPR) \
+  struct NAME \
+  { \
+    template<typename A, typename B> \
+    auto operator() (const A& a, const B& b) const -> decltype(EXPR) \
+      { return EXPR; } \
+  };
+  CASA_ARRAYEXPR_BINOP (ExprPlus,     a + b)
+  CASA_ARRAYEXPR_BINOP (ExprMinus,    a - b)
+  CASA_ARRAYEXPR_BINOP (ExprMultiply, a * b)
+  CASA_ARRAYEXPR_BINOP (ExprDivide,   a / b)
+  CASA_ARRAYEXPR_BINOP (ExprPow,      std::pow(a, b))
+  CASA_ARRAYEXPR_BINOP (ExprAtan2,    std::atan2(a, b))
+  CASA_ARRAYEXPR_BINOP (ExprMin,      (b < a ? b : a))
+  CASA_ARRAYEXPR_BINOP (ExprMax,      (a < b ? b : a))
+#undef CASA_ARRAYEXPR_BINOP
+
+#define CASA_ARRAYEXPR_UNOP(NAME, EXPR) \
+  struct NAME \
+  { \
+    template<typename A> \
+    auto operator() (const A& a) const -> decltype(EXPR) \
+      { return EXPR; } \
+  };
+  CASA_ARRAYEXPR_UNOP (ExprNegate,  -a)
+  CASA_ARRAYEXPR_UNOP (ExprSquare,  a * a)
+  CASA_ARRAYEXPR_UNOP (ExprCube,    a * a * a)
+  CASA_ARRAYEXPR_UNOP (ExprAbs,     std::abs(a))
+  CASA_ARRAYEXPR_UNOP (ExprSqrt,    std::sqrt(a))
+  CASA_ARRAYEXPR_UNOP (ExprExp,     std::exp(a))
+  CASA_ARRAYEXPR_UNOP (ExprLog,     std::log(a))
+  CASA_ARRAYEXPR_UNOP (ExprLog10,   std::log10(a))
+  CASA_ARRAYEXPR_UNOP (ExprSin,     std::sin(a))
+  CASA_ARRAYEXPR_UNOP (ExprCos,     std::cos(a))
+  CASA_ARRAYEXPR_UNOP (ExprTan,     std::tan(a))
+  CASA_ARRAYEXPR_UNOP (ExprAsin,    std::asin(a))
+  CASA_ARRAYEXPR_UNOP (ExprAcos,    std::acos(a))
+  CASA_ARRAYEXPR_UNOP (ExprAtan,    std::atan(a))
+  CASA_ARRAYEXPR_UNOP (ExprSinh,    std::sinh(a))
+  CASA_ARRAYEXPR_UNOP (ExprCosh,    std::cosh(a))
+  CASA_ARRAYEXPR_UNOP (ExprTanh,    std::tanh(a))
+  CASA_ARRAYEXPR_UNOP (ExprFloor,   std::floor(a))
+  CASA_ARRAYEXPR_UNOP (ExprCeil,    std::ceil(a))
+  CASA_ARRAYEXPR_UNOP (ExprReal,    std::real(a))
+  CASA_ARRAYEXPR_UNOP (ExprImag,    std::imag(a))
+  CASA_ARRAYEXPR_UNOP (ExprConj,    std::conj(a))
+  CASA_ARRAYEXPR_UNOP (ExprNorm,    std::norm(a))
+  CASA_ARRAYEXPR_UNOP (ExprArg,     std::arg(a))
+#undef CASA_ARRAYEXPR_UNOP
+  // </group>
+
+} //# NAMESPACE arrays_internal
+
+
+template<typename T, typename E>
+template<typename U>
+void ArrayExpr<T,E>::evaluateInto (Array<U>& result) const
+{
+  const E& expr = node();
+  IPosition shp = expr.shape();
+  if (result.nelements() == 0) {
+    result.resize (shp);
+  } else if (! result.shape().isEqual (shp)) {
+    throwArrayShapes (result.shape(), shp, "evaluateArrayExpr");
+  }
+  size_t n = result.nelements();
+  if (result.contiguousStorage()) {
+    U* out = result.data();
+    if (expr.contiguous()) {
+      //# The simple loop can be vectorized by the compiler.
+      for (size_t i=0; i<n; ++i) {
+        out[i] = expr.at(i);
+      }
+    } else {
+      typename E::Cursor cursor = expr.cursor();
+      for (size_t i=0; i<n; ++i) {
+        out[i] = cursor.value();
+        cursor.next();
+      }
+    }
+  } else {
+    typename E::Cursor cursor = expr.cursor();
+    arrayForEachRun (result, [&cursor](U* out, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, out+=incr) {
+                         *out = cursor.value();
+                         cursor.next();
+                       }
+                     });
+  }
+}
+
+
+// <group name="Array expression operators">
+
+// Start an expression from an Array.
+template<typename T>
+inline arrays_internal::ArrayExprLeaf<T> arrayExpr (const Array<T>& arr)
+{
+  return arrays_internal::ArrayExprLeaf<T> (arr);
+}
+
+// Define the binary operators and functions for the combinations of
+// two expressions, an expression and an Array, and an expression and
+// a scalar (of the expression's value type).
+#define CASA_ARRAYEXPR_BINARY(FUNC, OP, NAME) \
+template<typename TL, typename EL, typename TR, typename ER> \
+inline arrays_internal::ArrayExprBinary<EL, ER, arrays_internal::OP> \
+FUNC (const ArrayExpr<TL,EL>& left, const ArrayExpr<TR,ER>& right) \
+{ \
+  return arrays_internal::ArrayExprBinary<EL, ER, arrays_internal::OP> \
+    (left.node(), right.node(), arrays_internal::OP(), NAME); \
+} \
+template<typename TL, typename EL, typename TR> \
+inline arrays_internal::ArrayExprBinary \
+  <EL, arrays_internal::ArrayExprLeaf<TR>, arrays_internal::OP> \
+FUNC (const ArrayExpr<TL,EL>& left, const Array<TR>& right) \
+{ \
+  return arrays_internal::ArrayExprBinary \
+    <EL, arrays_internal::ArrayExprLeaf<TR>, arrays_internal::OP> \
+    (left.node(), arrays_internal::ArrayExprLeaf<TR>(right), \
+     arrays_internal::OP(), NAME); \
+} \
+template<typename TL, typename TR, typename ER> \
+inline arrays_internal::ArrayExprBinary \
+  <arrays_internal::ArrayExprLeaf<TL>, ER, arrays_internal::OP> \
+FUNC (const Array<TL>& left, const ArrayExpr<TR,ER>& right) \
+{ \
+  return arrays_internal::ArrayExprBinary \
+    <arrays_internal::ArrayExprLeaf<TL>, ER, arrays_internal::OP> \
+    (arrays_internal::ArrayExprLeaf<TL>(left), right.node(), \
+     arrays_internal::OP(), NAME); \
+} \
+template<typename TL, typename EL> \
+inline arrays_internal::ArrayExprBinary \
+  <EL, arrays_internal::ArrayExprScalar<TL>, arrays_internal::OP> \
+FUNC (const ArrayExpr<TL,EL>& left, \
+      const typename ArrayExpr<TL,EL>::value_type& right) \
+{ \
+  return arrays_internal::ArrayExprBinary \
+    <EL, arrays_internal::ArrayExprScalar<TL>, arrays_internal::OP> \
+    (left.node(), arrays_internal::ArrayExprScalar<TL>(right), \
+     arrays_internal::OP(), NAME); \
+} \
+template<typename TR, typename ER> \
+inline arrays_internal::ArrayExprBinary \
+  <arrays_internal::ArrayExprScalar<TR>, ER, arrays_internal::OP> \
+FUNC (const typename ArrayExpr<TR,ER>::value_type& left, \
+      const ArrayExpr<TR,ER>& right) \
+{ \
+  return arrays_internal::ArrayExprBinary \
+    <arrays_internal::ArrayExprScalar<TR>, ER, arrays_internal::OP> \
+    (arrays_internal::ArrayExprScalar<TR>(left), right.node(), \
+     arrays_internal::OP(), NAME); \
+}
+
+CASA_ARRAYEXPR_BINARY (operator+, ExprPlus,     "+")
+CASA_ARRAYEXPR_BINARY (operator-, ExprMinus,    "-")
+CASA_ARRAYEXPR_BINARY (operator*, ExprMultiply, "*")
+CASA_ARRAYEXPR_BINARY (operator/, ExprDivide,   "/")
+CASA_ARRAYEXPR_BINARY (pow,       ExprPow,      "pow")
+CASA_ARRAYEXPR_BINARY (atan2,     ExprAtan2,    "atan2")
+CASA_ARRAYEXPR_BINARY (min,       ExprMin,      "min")
+CASA_ARRAYEXPR_BINARY (max,       ExprMax,      "max")
+#undef CASA_ARRAYEXPR_BINARY
+
+// Define the unary operators and functions for an expression.
+// Note that <src>amplitude</src> and <src>phase</src> are the same as
+// <src>abs</src> and <src>arg</src>.
+#define CASA_ARRAYEXPR_UNARY(FUNC, OP) \
+template<typename T, typename E> \
+inline arrays_internal::ArrayExprUnary<E, arrays_internal::OP> \
+FUNC (const ArrayExpr<T,E>& expr) \
+{ \
+  return arrays_internal::ArrayExprUnary<E, arrays_internal::OP> \
+    (expr.node(), arrays_internal::OP()); \
+}
+
+CASA_ARRAYEXPR_UNARY (operator-, ExprNegate)
+CASA_ARRAYEXPR_UNARY (square,    ExprSquare)
+CASA_ARRAYEXPR_UNARY (cube,      ExprCube)
+CASA_ARRAYEXPR_UNARY (abs,       ExprAbs)
+CASA_ARRAYEXPR_UNARY (amplitude, ExprAbs)
+CASA_ARRAYEXPR_UNARY (sqrt,      ExprSqrt)
+CASA_ARRAYEXPR_UNARY (exp,       ExprExp)
+CASA_ARRAYEXPR_UNARY (log,       ExprLog)
+CASA_ARRAYEXPR_UNARY (log10,     ExprLog10)
+CASA_ARRAYEXPR_UNARY (sin,       ExprSin)
+CASA_ARRAYEXPR_UNARY (cos,       ExprCos)
+CASA_ARRAYEXPR_UNARY (tan,       ExprTan)
+CASA_ARRAYEXPR_UNARY (asin,      ExprAsin)
+CASA_ARRAYEXPR_UNARY (acos,      ExprAcos)
+CASA_ARRAYEXPR_UNARY (atan,      ExprAtan)
+CASA_ARRAYEXPR_UNARY (sinh,      ExprSinh)
+CASA_ARRAYEXPR_UNARY (cosh,      ExprCosh)
+CASA_ARRAYEXPR_UNARY (tanh,      ExprTanh)
+CASA_ARRAYEXPR_UNARY (floor,     ExprFloor)
+CASA_ARRAYEXPR_UNARY (ceil,      ExprCeil)
+CASA_ARRAYEXPR_UNARY (real,      ExprReal)
+CASA_ARRAYEXPR_UNARY (imag,      ExprImag)
+CASA_ARRAYEXPR_UNARY (conj,      ExprConj)
+CASA_ARRAYEXPR_UNARY (norm,      ExprNorm)
+CASA_ARRAYEXPR_UNARY (arg,       ExprArg)
+CASA_ARRAYEXPR_UNARY (phase,     ExprArg)
+#undef CASA_ARRAYEXPR_UNARY
+
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
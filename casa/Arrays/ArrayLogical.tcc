@@ -41,6 +41,8 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// A non-contiguous array is stepped through in runs (see ArrayRuns.h).
+// Once the result is known, the remaining runs are skipped.
 template<typename T, typename CompareOperator>
 bool arrayCompareAll (const Array<T>& left, const Array<T>& right,
                       CompareOperator op)
@@ -48,9 +50,16 @@ bool arrayCompareAll (const Array<T>& left, const Array<T>& right,
   if (! left.conform(right)) return false;
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     return arrays_internal::compareAll (left.cbegin(), left.cend(), right.cbegin(), op);
-  } else {
-    return arrays_internal::compareAll (left.begin(),  left.end(),  right.begin(),  op);
   }
+  bool result = true;
+  arrayForEachRun (left, right,
+                   [&result,&op](const T* l, ssize_t linc,
+                                 const T* r, ssize_t rinc, size_t n)
+                   { for (size_t i=0; i<n && result; ++i, l+=linc, r+=rinc) {
+                       result = op(*l, *r);
+                     }
+                   });
+  return result;
 }
 
 template<typename T, typename CompareOperator>
@@ -59,9 +68,15 @@ bool arrayCompareAll (const Array<T>& left, T right,
 {
   if (left.contiguousStorage()) {
     return arrays_internal::compareAllRight (left.cbegin(), left.cend(), right, op);
-  } else {
-    return arrays_internal::compareAllRight (left.begin(), left.end(), right, op);
   }
+  bool result = true;
+  arrayForEachRun (left, [&result,&right,&op](const T* l, ssize_t incr,
+                                              size_t n)
+                   { for (size_t i=0; i<n && result; ++i, l+=incr) {
+                       result = op(*l, right);
+                     }
+                   });
+  return result;
 }
 
 template<typename T, typename CompareOperator>
@@ -70,9 +85,15 @@ bool arrayCompareAll (T left, const Array<T>& right,
 {
   if (right.contiguousStorage()) {
     return arrays_internal::compareAllLeft (right.cbegin(), right.cend(), left, op);
-  } else {
-    return arrays_internal::compareAllLeft (right.begin(), right.end(), left, op);
   }
+  bool result = true;
+  arrayForEachRun (right, [&result,&left,&op](const T* r, ssize_t incr,
+                                              size_t n)
+                   { for (size_t i=0; i<n && result; ++i, r+=incr) {
+                       result = op(left, *r);
+                     }
+                   });
+  return result;
 }
 
 template<typename T, typename CompareOperator>
@@ -82,9 +103,16 @@ bool arrayCompareAny (const Array<T>& left, const Array<T>& right,
   if (! left.conform(right)) return false;
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     return arrays_internal::compareAny (left.cbegin(), left.cend(), right.cbegin(), op);
-  } else {
-    return arrays_internal::compareAny (left.begin(),  left.end(),  right.begin(),  op);
   }
+  bool result = false;
+  arrayForEachRun (left, right,
+                   [&result,&op](const T* l, ssize_t linc,
+                                 const T* r, ssize_t rinc, size_t n)
+                   { for (size_t i=0; i<n && !result; ++i, l+=linc, r+=rinc) {
+                       result = op(*l, *r);
+                     }
+                   });
+  return result;
 }
 
 template<typename T, typename CompareOperator>
@@ -93,9 +121,15 @@ bool arrayCompareAny (const Array<T>& left, T right,
 {
   if (left.contiguousStorage()) {
     return arrays_internal::compareAnyRight (left.cbegin(), left.cend(), right, op);
-  } else {
-    return arrays_internal::compareAnyRight (left.begin(), left.end(), right, op);
   }
+  bool result = false;
+  arrayForEachRun (left, [&result,&right,&op](const T* l, ssize_t incr,
+                                              size_t n)
+                   { for (size_t i=0; i<n && !result; ++i, l+=incr) {
+                       result = op(*l, right);
+                     }
+                   });
+  return result;
 }
 
 template<typename T, typename CompareOperator>
@@ -104,9 +138,15 @@ bool arrayCompareAny (T left, const Array<T>& right,
 {
   if (right.contiguousStorage()) {
     return arrays_internal::compareAnyLeft (right.cbegin(), right.cend(), left, op);
-  } else {
-    return arrays_internal::compareAnyLeft (right.begin(), right.end(), left, op);
   }
+  bool result = false;
+  arrayForEachRun (right, [&result,&left,&op](const T* r, ssize_t incr,
+                                              size_t n)
+                   { for (size_t i=0; i<n && !result; ++i, r+=incr) {
+                       result = op(left, *r);
+                     }
+                   });
+  return result;
 }
 
 
@@ -27,6 +27,7 @@
 #define CASA_ARRAYMATH_2_H
 
 #include "Array.h"
+#include "ArrayRuns.h"
 
 #include <algorithm>
 #include <cassert>
@@ -180,6 +181,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <group>
 // Transform left and right to a result using the binary operator.
 // Result MUST be a contiguous array.
+// <br>Non-contiguous operands with the same shape are stepped through
+// in runs (see ArrayRuns.h), which is much faster than using their
+// iterators.
 template<typename L, typename R, typename RES, typename BinaryOperator>
 inline void arrayContTransform (const Array<L>& left, const Array<R>& right,
                                 Array<RES>& result, BinaryOperator op)
@@ -188,6 +192,15 @@ inline void arrayContTransform (const Array<L>& left, const Array<R>& right,
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     std::transform (left.cbegin(), left.cend(), right.cbegin(),
                     result.cbegin(), op);
+  } else if (left.shape().isEqual (right.shape())) {
+    RES* res = result.data();
+    arrayForEachRun (left, right,
+                     [&res,&op](const L* l, ssize_t linc,
+                                const R* r, ssize_t rinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=linc, r+=rinc) {
+                         *res++ = op(*l, *r);
+                       }
+                     });
   } else {
     std::transform (left.begin(), left.end(), right.begin(),
                     result.cbegin(), op);
@@ -207,10 +220,13 @@ inline void arrayContTransform (const Array<L>& left, R right,
     ////    std::transform (left.cbegin(), left.cend(),
     ////                    result.cbegin(), bind2nd(op, right));
   } else {
-    myrtransform (left.begin(), left.end(),
-                 result.cbegin(), right, op);
-    ////    std::transform (left.begin(), left.end(),
-    ////                    result.cbegin(), bind2nd(op, right));
+    RES* res = result.data();
+    arrayForEachRun (left, [&res,&right,&op](const L* l, ssize_t incr,
+                                             size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=incr) {
+                         *res++ = op(*l, right);
+                       }
+                     });
   }
 }
 
@@ -227,10 +243,13 @@ inline void arrayContTransform (L left, const Array<R>& right,
     ////    std::transform (right.cbegin(), right.cend(),
     ////                    result.cbegin(), bind1st(op, left));
   } else {
-    myltransform (right.begin(), right.end(),
-                  result.cbegin(), left, op);
-    ////    std::transform (right.begin(), right.end(),
-    ////                    result.cbegin(), bind1st(op, left));
+    RES* res = result.data();
+    arrayForEachRun (right, [&res,&left,&op](const R* r, ssize_t incr,
+                                             size_t n)
+                     { for (size_t i=0; i<n; ++i, r+=incr) {
+                         *res++ = op(left, *r);
+                       }
+                     });
   }
 }
 
@@ -244,7 +263,12 @@ inline void arrayContTransform (const Array<T>& arr,
   if (arr.contiguousStorage()) {
     std::transform (arr.cbegin(), arr.cend(), result.cbegin(), op);
   } else {
-    std::transform (arr.begin(), arr.end(), result.cbegin(), op);
+    RES* res = result.data();
+    arrayForEachRun (arr, [&res,&op](const T* p, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=incr) {
+                         *res++ = op(*p);
+                       }
+                     });
   }
 }
 
@@ -301,6 +325,14 @@ inline void arrayTransformInPlace (Array<L>& left, const Array<R>& right,
 {
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     std::transform(left.cbegin(), left.cend(), right.cbegin(), left.cbegin(), op);
+  } else if (left.shape().isEqual (right.shape())) {
+    arrayForEachRun (left, right,
+                     [&op](L* l, ssize_t linc,
+                           const R* r, ssize_t rinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=linc, r+=rinc) {
+                         *l = op(*l, *r);
+                       }
+                     });
   } else {
     std::transform(left.begin(), left.end(), right.begin(), left.begin(), op);
   }
@@ -315,8 +347,11 @@ inline void arrayTransformInPlace (Array<L>& left, R right, BinaryOperator op)
     myiptransform (left.cbegin(), left.cend(), right, op);
     ////    transformInPlace (left.cbegin(), left.cend(), bind2nd(op, right));
   } else {
-    myiptransform (left.begin(), left.end(), right, op);
-    ////    transformInPlace (left.begin(), left.end(), bind2nd(op, right));
+    arrayForEachRun (left, [&right,&op](L* l, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=incr) {
+                         *l = op(*l, right);
+                       }
+                     });
   }
 }
 
@@ -329,7 +364,11 @@ inline void arrayTransformInPlace (Array<T>& arr, UnaryOperator op)
   if (arr.contiguousStorage()) {
     std::transform(arr.cbegin(), arr.cend(), arr.cbegin(), op);
   } else {
-    std::transform(arr.begin(), arr.end(), arr.begin(), op);
+    arrayForEachRun (arr, [&op](T* p, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=incr) {
+                         *p = op(*p);
+                       }
+                     });
   }
 }
 // </group>
@@ -669,13 +708,16 @@ template<typename T> T rms(const Array<T> &a);
 // the default for takeEvenMean is false if the array has > 100 elements,
 // otherwise it is true.
 // <br>If "sorted"==true we assume the data is already sorted and we
-// compute the median directly. Otherwise the function GenSort::kthLargest
-// is used to find the median (kthLargest is about 6 times faster
-// than a full quicksort).
+// compute the median directly. Otherwise std::nth_element
+// is used to find the median (which is much faster than a full sort).
 // <br>Finding the median means that the array has to be (partially)
 // sorted. By default a copy will be made, but if "inPlace" is in effect,
 // the data themselves will be sorted. That should only be used if the
 // data are used not thereafter.
+// <br>If casacore is built with OpenMP support, the median of a large
+// contiguous array of real values is found by a parallel histogram
+// selection, which does not need a copy and leaves the data unchanged.
+// It gives exactly the same result (NaNs result in a serial selection).
 // <note>The function kthLargest in class GenSortIndirect can be used to
 // obtain the index of the median in an array. </note>
 // <group>
@@ -718,7 +760,8 @@ template<typename T> inline T madfmInPlace(const Array<T> &a, bool sorted=false)
 // It returns the value at the given fraction of the array.
 // A fraction of 0.5 is the same as the median, be it that no mean of
 // the two middle elements is taken if the array has an even nr of elements.
-// It uses kthLargest if the array is not sorted yet.
+// It uses std::nth_element (or the parallel selection described
+// for the median) if the array is not sorted yet.
 // <note>The function kthLargest in class GenSortIndirect can be used to
 // obtain the index of the fractile in an array. </note>
 // TODO shouldn't take a const Array for in place sorting
@@ -922,6 +965,11 @@ void         imag(Array<double> &rarray, const Array<std::complex<double>> &carr
 // Extracts the amplitude (i.e. sqrt(re*re + im*im)) from an array
 // of complex numbers. N.B. this is presently called "fabs" for a single
 // complex number.
+// <br>The result for <src>std::complex<float></src> is the same as
+// <src>std::abs</src> (i.e. hypot). For <src>std::complex<double></src>
+// it can differ 1 ulp from <src>std::abs</src>, because the square root of
+// the sum of squares is used (with hypot only where the squares could
+// overflow or underflow).
 // <group>
 Array<float>  amplitude(const Array<std::complex<float>> &carray);
 Array<double> amplitude(const Array<std::complex<double>> &carray);
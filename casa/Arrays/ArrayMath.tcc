@@ -39,6 +39,12 @@
 #include <cassert>
 #include <cmath>
 #include <functional>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -48,6 +54,15 @@ void arrayTransform (const Array<L>& left, const Array<R>& right,
 {
   if (result.contiguousStorage()) {
     arrayContTransform (left, right, result, op);
+  } else if (left.shape().isEqual (right.shape())  &&
+             left.shape().isEqual (result.shape())) {
+    arrayForEachRun (left, right, result,
+                     [&op](const L* l, ssize_t linc, const R* r, ssize_t rinc,
+                           RES* res, ssize_t resinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=linc, r+=rinc, res+=resinc) {
+                         *res = op(*l, *r);
+                       }
+                     });
   } else {
     if (left.contiguousStorage()  &&  right.contiguousStorage()) {
       std::transform (left.cbegin(), left.cend(), right.cbegin(),
@@ -65,6 +80,14 @@ void arrayTransform (const Array<L>& left, R right,
 {
   if (result.contiguousStorage()) {
     arrayContTransform (left, right, result, op);
+  } else if (left.shape().isEqual (result.shape())) {
+    arrayForEachRun (left, result,
+                     [&right,&op](const L* l, ssize_t linc,
+                                  RES* res, ssize_t resinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, l+=linc, res+=resinc) {
+                         *res = op(*l, right);
+                       }
+                     });
   } else {
     if (left.contiguousStorage()) {
       myrtransform (left.cbegin(), left.cend(), result.begin(), right, op);
@@ -80,6 +103,14 @@ void arrayTransform (L left, const Array<R>& right,
 {
   if (result.contiguousStorage()) {
     arrayContTransform (left, right, result, op);
+  } else if (right.shape().isEqual (result.shape())) {
+    arrayForEachRun (right, result,
+                     [&left,&op](const R* r, ssize_t rinc,
+                                 RES* res, ssize_t resinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, r+=rinc, res+=resinc) {
+                         *res = op(left, *r);
+                       }
+                     });
   } else {
     if (right.contiguousStorage()) {
       myltransform (right.cbegin(), right.cend(), result.begin(), left, op);
@@ -95,6 +126,14 @@ void arrayTransform (const Array<T>& arr,
 {
   if (result.contiguousStorage()) {
     arrayContTransform (arr, result, op);
+  } else if (arr.shape().isEqual (result.shape())) {
+    arrayForEachRun (arr, result,
+                     [&op](const T* p, ssize_t pinc,
+                           RES* res, ssize_t resinc, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=pinc, res+=resinc) {
+                         *res = op(*p);
+                       }
+                     });
   } else {
     if (arr.contiguousStorage()) {
       std::transform (arr.cbegin(), arr.cend(), result.begin(), op);
@@ -617,16 +656,16 @@ template<typename T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
   } else {
     T minv = array.data()[0];
     T maxv = minv;
-    typename Array<T>::const_iterator iterEnd = array.end();
-    for (typename Array<T>::const_iterator iter = array.begin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      }
-      if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
+    arrayForEachRun (array, [&minv,&maxv](const T* p, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=incr) {
+                         if (*p < minv) {
+                           minv = *p;
+                         }
+                         if (*p > maxv) {
+                           maxv = *p;
+                         }
+                       }
+                     });
     maxVal = maxv;
     minVal = minv;
   }
@@ -913,19 +952,34 @@ template<typename T> Array<T> floormod(const Array<T> &a, const T &b)
 // <thrown>
 //    </item> ArrayError
 // </thrown>
+namespace arrays_internal {
+  // Accumulate the elements of an array like std::accumulate.
+  // A non-contiguous array is stepped through in runs, but the order
+  // of the elements is the same, so the result is the same.
+  template<typename T, typename BinaryOperator>
+  inline T accumulateArray (const Array<T>& a, T init, BinaryOperator op)
+  {
+    if (a.contiguousStorage()) {
+      return std::accumulate (a.cbegin(), a.cend(), init, op);
+    }
+    arrayForEachRun (a, [&init,&op](const T* p, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=incr) {
+                         init = op(init, *p);
+                       }
+                     });
+    return init;
+  }
+}
+
 template<typename T> T sum(const Array<T> &a)
 {
-  return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
-    std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
+  return arrays_internal::accumulateArray (a, T(), std::plus<T>());
 }
 
 template<typename T> T sumsqr(const Array<T> &a)
 {
   auto sumsqr = [](T left, T right) { return left + right*right;};
-  return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), sumsqr) :
-    std::accumulate(a.begin(),  a.end(),  T(), sumsqr);
+  return arrays_internal::accumulateArray (a, T(), sumsqr);
 }
 
 // <thrown>
@@ -972,9 +1026,8 @@ template<typename T> T pvariance(const Array<T> &a, T mean, size_t ddof)
                      std::to_string(ddof+1) + 
                      " elements"));
   }
-  T sum = a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), arrays_internal::SumSqrDiff<T>(mean)) :
-    std::accumulate(a.begin(),  a.end(),  T(), arrays_internal::SumSqrDiff<T>(mean));
+  T sum = arrays_internal::accumulateArray (a, T(),
+                                            arrays_internal::SumSqrDiff<T>(mean));
   return T(sum/T(1.0*a.nelements() - ddof));
 }
 template<typename T> T variance(const Array<T> &a, T mean)
@@ -1038,9 +1091,7 @@ template<typename T> T avdev(const Array<T> &a, T mean)
 			 "element"));
     }
     auto sumabsdiff = [mean](T left, T right) { return left + std::abs(right-mean); };
-    T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), sumabsdiff) :
-      std::accumulate(a.begin(),  a.end(),  T(), sumabsdiff);
+    T sum = arrays_internal::accumulateArray (a, T(), sumabsdiff);
     return T(sum/T(1.0*a.nelements()));
 }
 
@@ -1054,12 +1105,219 @@ template<typename T> T rms(const Array<T> &a)
 			 "element"));
     }
     auto sumsqr = [](T left, T right) { return left + right*right; };
-  T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), sumsqr) :
-      std::accumulate(a.begin(),  a.end(),  T(), sumsqr);
+    T sum = arrays_internal::accumulateArray (a, T(), sumsqr);
     return T(std::sqrt(sum/T(1.0*a.nelements())));
 }
 
+namespace arrays_internal {
+
+  // Minimum number of elements for which median, fractile and madfm
+  // select in parallel.
+  constexpr size_t parallelSelectMin = 1048576;
+
+  // Selecting in a candidate set of this size is done serially.
+  constexpr size_t parallelSelectSmall = 65536;
+
+  template<typename T>
+  bool parallelKthValue (const T*, size_t, size_t, T&, std::false_type)
+    { return false; }
+
+  template<typename T>
+  bool parallelKthValue (const T* data, size_t n, size_t k, T& value,
+                         std::true_type)
+  {
+#ifndef _OPENMP
+    (void)data; (void)n; (void)k; (void)value;
+    return false;
+#else
+    int nthr = omp_get_max_threads();
+    if (nthr < 2  ||  n < parallelSelectMin) {
+      return false;
+    }
+    // Each pass histograms the candidates in nbucket equally wide buckets
+    // (in a monotone way) and keeps the candidates in the bucket holding
+    // the k-th value, until few enough are left to select serially.
+    const size_t nbucket = 4096;
+    std::vector<T> cand, next;
+    std::vector<T> tmin(nthr), tmax(nthr);
+    std::vector<char> tnan(nthr);
+    std::vector<size_t> hist(nthr*nbucket);
+    std::vector<size_t> offset(nthr+1);
+    const T* src = data;
+    size_t nsrc = n;
+    bool hasNaN = false;
+    while (nsrc > parallelSelectSmall) {
+      T lo = src[0];
+      T hi = src[0];
+      double scale = 0;
+      size_t bucket = 0;
+      size_t nprev = nsrc;
+      std::fill (tnan.begin(), tnan.end(), 0);
+      std::fill (hist.begin(), hist.end(), 0);
+#pragma omp parallel num_threads(nthr)
+      {
+        int nt = omp_get_num_threads();
+        int t  = omp_get_thread_num();
+        size_t st  = nsrc*t/nt;
+        size_t end = nsrc*(t+1)/nt;
+        T mn = src[st];
+        T mx = mn;
+        bool nan = false;
+        for (size_t i=st; i<end; ++i) {
+          T v = src[i];
+          if (v != v) {
+            nan = true;
+          } else {
+            if (v < mn) mn = v;
+            if (v > mx) mx = v;
+          }
+        }
+        tmin[t] = mn;
+        tmax[t] = mx;
+        tnan[t] = nan;
+#pragma omp barrier
+#pragma omp single
+        {
+          for (int i=0; i<nt; ++i) {
+            hasNaN = hasNaN || tnan[i];
+            if (tmin[i] < lo) lo = tmin[i];
+            if (tmax[i] > hi) hi = tmax[i];
+          }
+          double range = double(hi) - double(lo);
+          if (!hasNaN  &&  lo < hi  &&  std::isfinite(range)) {
+            scale = nbucket / range;
+            if (!std::isfinite(scale)) {
+              scale = 0;
+            }
+          }
+        }
+        // Fill the histogram of this thread's part.
+        size_t* h = hist.data() + t*nbucket;
+        if (scale > 0) {
+          for (size_t i=st; i<end; ++i) {
+            size_t b = size_t((double(src[i]) - double(lo)) * scale);
+            h[b < nbucket ? b : nbucket-1]++;
+          }
+        }
+#pragma omp barrier
+#pragma omp single
+        {
+          if (scale > 0) {
+            // Find the bucket containing the k-th value.
+            size_t below = 0;
+            for (bucket=0; bucket<nbucket; ++bucket) {
+              size_t nb = 0;
+              for (int i=0; i<nt; ++i) {
+                nb += hist[i*nbucket + bucket];
+              }
+              if (below + nb > k) {
+                break;
+              }
+              below += nb;
+            }
+            k -= below;
+            offset[0] = 0;
+            for (int i=0; i<nt; ++i) {
+              offset[i+1] = offset[i] + hist[i*nbucket + bucket];
+            }
+            next.resize (offset[nt]);
+          }
+        }
+        // Gather the candidates in the order of the input.
+        if (scale > 0) {
+          T* out = next.data() + offset[t];
+          for (size_t i=st; i<end; ++i) {
+            size_t b = size_t((double(src[i]) - double(lo)) * scale);
+            if ((b < nbucket ? b : nbucket-1) == bucket) {
+              *out++ = src[i];
+            }
+          }
+        }
+      }
+      if (hasNaN) {
+        // The ordering is undefined; leave it to nth_element.
+        return false;
+      }
+      if (scale == 0) {
+        if (!(lo < hi)) {
+          // All candidates are equal.
+          value = lo;
+          return true;
+        }
+        break;
+      }
+      cand.swap (next);
+      src = cand.data();
+      nsrc = cand.size();
+      if (nsrc == nprev) {
+        break;
+      }
+    }
+    if (src == data) {
+      cand.assign (data, data+nsrc);
+    }
+    std::nth_element (cand.begin(), cand.begin()+k, cand.end());
+    value = cand[k];
+    return true;
+#endif
+  }
+
+  // Get in parallel the value of the element at index k as it would be
+  // after std::nth_element(data, data+k, data+n) without changing the data.
+  // It returns false (and does nothing) if the data should be selected
+  // serially, because OpenMP is not used, the array is small or the data
+  // type is not a real type. NaNs also result in false.
+  template<typename T>
+  bool parallelKthValue (const T* data, size_t n, size_t k, T& value)
+  {
+    return parallelKthValue (data, n, k, value,
+                             std::integral_constant<bool,
+                             std::is_arithmetic<T>::value  &&
+                             !std::is_same<T,bool>::value>());
+  }
+
+  // Get the value of the element at index k+1 as it would be after
+  // std::nth_element, given the value at index k.
+  template<typename T>
+  T nextKthValue (const T* data, size_t n, size_t k, T value)
+  {
+    size_t nle = 0;
+    T nextv = value;
+    bool found = false;
+#ifdef _OPENMP
+#pragma omp parallel if (n >= parallelSelectMin)
+#endif
+    {
+      size_t tnle = 0;
+      T tnext = value;
+      bool tfound = false;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+      for (long long i=0; i<(long long)n; ++i) {
+        if (!(value < data[i])) {
+          ++tnle;
+        } else if (!tfound  ||  data[i] < tnext) {
+          tnext = data[i];
+          tfound = true;
+        }
+      }
+#ifdef _OPENMP
+#pragma omp critical(casa_nextKthValue)
+#endif
+      {
+        nle += tnle;
+        if (tfound  &&  (!found  ||  tnext < nextv)) {
+          nextv = tnext;
+          found = true;
+        }
+      }
+    }
+    return (nle > k+1 ? value : nextv);
+  }
+
+} //# NAMESPACE ARRAYS_INTERNAL
+
 // <thrown>
 //    </item> ArrayError
 // </thrown>
@@ -1075,6 +1333,16 @@ template<typename T> T median(const Array<T> &a, std::vector<T>& scratch, bool s
   if (nelem%2 != 0) {
     takeEvenMean = false;
   }
+  size_t n2 = (nelem - 1)/2;
+  // Large arrays are selected in parallel without copying.
+  if (!sorted  &&  a.contiguousStorage()  &&
+      arrays_internal::parallelKthValue (a.data(), nelem, n2, medval)) {
+    if (takeEvenMean) {
+      medval = T(0.5 * (medval + arrays_internal::nextKthValue
+                        (a.data(), nelem, n2, medval)));
+    }
+    return medval;
+  }
   // A copy is needed if not contiguous or if not in place.
   const T* storage;
   if (!a.contiguousStorage() || !inPlace)
@@ -1086,7 +1354,6 @@ template<typename T> T median(const Array<T> &a, std::vector<T>& scratch, bool s
     storage = a.data();
   }
   T* data = const_cast<T*>(storage);
-  size_t n2 = (nelem - 1)/2;
   if (!sorted)
   {
     std::nth_element(data, data+n2, data+nelem);
@@ -1113,21 +1380,32 @@ template<typename T> T median(const Array<T> &a, std::vector<T>& scratch, bool s
 template<typename T> T madfm(const Array<T> &a, std::vector<T>& scratch, bool sorted,
   bool takeEvenMean, bool inPlace)
 {
+  scratch.clear();
   T med = median(a, scratch, sorted, takeEvenMean, inPlace);
   Array<T> atmp;
+  const T* src;
   if (inPlace  &&  a.contiguousStorage()) {
     atmp.reference (a);   // remove constness
+    src = atmp.data();
   } else {
-    // A copy of a has been made to scratch.
-    // Using it saves computing.
-    // (this was changed for array2: sharing storage is no longer possible)
-    assert(a.size() == scratch.size());
     atmp.resize(a.shape());
-    atmp.assign_conforming (Array<T>(a.shape(), scratch.data()));
+    if (scratch.size() == a.size()) {
+      // A copy of a has been made to scratch.
+      // Using it saves computing.
+      src = scratch.data();
+    } else {
+      // The median was selected in parallel without making a copy.
+      atmp.assign_conforming (a);
+      src = atmp.data();
+    }
   }
   T* aptr = atmp.data();
-  for (size_t i=0; i<atmp.size(); ++i) {
-    aptr[i] = std::abs(aptr[i] - med);
+  long long n = atmp.size();
+#ifdef _OPENMP
+#pragma omp parallel for if (n >= (long long)arrays_internal::parallelSelectMin)
+#endif
+  for (long long i=0; i<n; ++i) {
+    aptr[i] = std::abs(src[i] - med);
   }
   return median(atmp, scratch, false, takeEvenMean, true);
 }
@@ -1146,6 +1424,13 @@ template<typename T> T fractile(const Array<T> &a, std::vector<T>& scratch, floa
     throw(ArrayError("::fractile(const Array<T>&) - Need at least 1 "
       "elements"));
   }
+  size_t n2 = size_t((nelem - 1) * double(fraction) + 0.01);
+  // Large arrays are selected in parallel without copying.
+  T value;
+  if (!sorted  &&  a.contiguousStorage()  &&
+      arrays_internal::parallelKthValue (a.data(), nelem, n2, value)) {
+    return value;
+  }
   // A copy is needed if not contiguous or if not in place.
   const T* storage = a.data();
   if (!a.contiguousStorage() || !inPlace)
@@ -1154,7 +1439,6 @@ template<typename T> T fractile(const Array<T> &a, std::vector<T>& scratch, floa
     storage = scratch.data();
   }
   T* data = const_cast<T*>(storage);
-  size_t n2 = size_t((nelem - 1) * double(fraction) + 0.01);
   if (!sorted)
   {
     std::nth_element(data, data+n2, data+nelem);
@@ -1172,14 +1456,14 @@ T interFractileRange(const Array<T> &a, std::vector<T>& scratch,
   if (!(fraction>0  &&  fraction<0.5))
     throw std::runtime_error("interFractileRange: invalid parameter");
   T hex1, hex2;
+  scratch.clear();
   hex1 = fractile(a, scratch, fraction, sorted, inPlace);
-  if (inPlace  &&  a.contiguousStorage()) {  
+  if ((inPlace  &&  a.contiguousStorage())  ||  a.size() != scratch.size()) {
+    // No copy has been made (also if selected in parallel).
     hex2 = fractile(a, scratch, 1-fraction, sorted, inPlace);
   } else {
     // In this case a copy of a has been made to scratch.
     // Using it saves making another copy.
-    if (a.size() != scratch.size())
-      throw std::runtime_error("interFractileRange: array sizes don't match");
     Array<T> atmp(a.shape(), scratch.data(), SHARE);
     hex2 = fractile(atmp, scratch, 1-fraction, sorted, inPlace);
   }
@@ -1251,13 +1535,13 @@ void convertArray(Array<T> &to, const Array<U> &from)
 	arrays_internal::convertScalar (*iterTo, *iterFrom);
       }
     } else {
-      typename Array<U>::const_iterator endFrom = from.end();
-      typename Array<U>::const_iterator iterFrom = from.begin();
-      for (typename Array<T>::iterator iterTo = to.begin();
-	   iterFrom != endFrom;
-	   ++iterFrom, ++iterTo) {
-	arrays_internal::convertScalar (*iterTo, *iterFrom);
-      }
+      arrayForEachRun (to, from,
+                       [](T* pto, ssize_t toIncr,
+                          const U* pfrom, ssize_t fromIncr, size_t n)
+                       { for (size_t i=0; i<n; ++i, pto+=toIncr, pfrom+=fromIncr) {
+                           arrays_internal::convertScalar (*pto, *pfrom);
+                         }
+                       });
     }
 }
 
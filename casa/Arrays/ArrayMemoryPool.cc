@@ -0,0 +1,209 @@
+//# ArrayMemoryPool.cc: Thread-local pool for Array storage
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include "ArrayMemoryPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // Blocks up to 2^24 bytes are pooled; each power of 2 is divided
+  // into 4 size classes. Class 0 is for blocks up to 64 bytes.
+  const int maxPooledLog2 = 24;
+  const int nsizeClass = 1 + 4*(maxPooledLog2 - 6);
+  // The limits of the cache of a thread.
+  const int maxBlocksPerClass = 8;
+  const size_t maxCachedBytes = size_t(64) << 20;
+
+  std::atomic<bool> theirCaching (false);
+
+  // Set when the cache of a thread has been destructed at thread exit.
+  // Storage freed thereafter (e.g. by other thread_local objects) is
+  // returned to the system.
+  thread_local bool theirCacheDestructed = false;
+
+  // Get the size class and rounded size of a block.
+  // -1 is returned for a block too large to be pooled.
+  int sizeClass (size_t nbytes, size_t& rounded)
+  {
+    if (nbytes <= ArrayMemoryPool::alignment) {
+      rounded = ArrayMemoryPool::alignment;
+      return 0;
+    }
+    // Find p such that 2^(p-1) < nbytes <= 2^p.
+    int p = 0;
+    for (size_t n=nbytes-1; n>0; n>>=1) {
+      ++p;
+    }
+    if (p > maxPooledLog2) {
+      rounded = nbytes;
+      return -1;
+    }
+    // Round up to a quarter of 2^(p-1).
+    size_t granule = size_t(1) << (p-3);
+    size_t nq = (nbytes + granule - 1) / granule;      // 5, 6, 7 or 8
+    rounded = nq * granule;
+    return 1 + 4*(p-7) + int(nq-5);
+  }
+
+  class ThreadCache
+  {
+  public:
+    ThreadCache()
+      : itsNBytes (0)
+    {
+      std::fill (itsNBlocks, itsNBlocks+nsizeClass, 0);
+    }
+
+    ~ThreadCache()
+    {
+      release();
+      theirCacheDestructed = true;
+    }
+
+    void* get (int cls, size_t rounded)
+    {
+      if (itsNBlocks[cls] == 0) {
+        return 0;
+      }
+      itsNBytes -= rounded;
+      return itsBlocks[cls][--itsNBlocks[cls]];
+    }
+
+    bool put (void* ptr, int cls, size_t rounded)
+    {
+      if (itsNBlocks[cls] == maxBlocksPerClass  ||
+          itsNBytes + rounded > maxCachedBytes) {
+        return false;
+      }
+      itsNBytes += rounded;
+      itsBlocks[cls][itsNBlocks[cls]++] = ptr;
+      return true;
+    }
+
+    void release()
+    {
+      for (int cls=0; cls<nsizeClass; ++cls) {
+        for (int i=0; i<itsNBlocks[cls]; ++i) {
+          free (itsBlocks[cls][i]);
+        }
+        itsNBlocks[cls] = 0;
+      }
+      itsNBytes = 0;
+    }
+
+    size_t nbytes() const
+      { return itsNBytes; }
+
+  private:
+    void*  itsBlocks[nsizeClass][maxBlocksPerClass];
+    int    itsNBlocks[nsizeClass];
+    size_t itsNBytes;
+  };
+
+  ThreadCache& threadCache()
+  {
+    static thread_local ThreadCache cache;
+    return cache;
+  }
+
+} //# end anonymous namespace
+
+
+void* ArrayMemoryPool::allocate (size_t nbytes, bool cache)
+{
+  if (nbytes == 0) {
+    return 0;
+  }
+  // Only a block that can be cached is rounded up to its size class.
+  size_t size = nbytes;
+  if (cache) {
+    int cls = sizeClass (nbytes, size);
+    if (cls >= 0  &&  !theirCacheDestructed) {
+      void* ptr = threadCache().get (cls, size);
+      if (ptr) {
+        return ptr;
+      }
+    }
+  }
+  void* ptr = 0;
+  if (posix_memalign (&ptr, alignment, size) != 0) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void ArrayMemoryPool::deallocate (void* ptr, size_t nbytes, bool cache)
+{
+  if (ptr == 0) {
+    return;
+  }
+  if (cache  &&  !theirCacheDestructed) {
+    size_t rounded;
+    int cls = sizeClass (nbytes, rounded);
+    if (cls >= 0  &&  threadCache().put (ptr, cls, rounded)) {
+      return;
+    }
+  }
+  free (ptr);
+}
+
+void ArrayMemoryPool::setCaching (bool enable)
+{
+  theirCaching = enable;
+}
+
+bool ArrayMemoryPool::caching()
+{
+  return theirCaching;
+}
+
+void ArrayMemoryPool::releaseCache()
+{
+  if (!theirCacheDestructed) {
+    threadCache().release();
+  }
+}
+
+size_t ArrayMemoryPool::cachedBytes()
+{
+  return (theirCacheDestructed  ?  0 : threadCache().nbytes());
+}
+
+size_t ArrayMemoryPool::roundedSize (size_t nbytes)
+{
+  size_t rounded = 0;
+  if (nbytes > 0) {
+    sizeClass (nbytes, rounded);
+  }
+  return rounded;
+}
+
+} //# NAMESPACE CASACORE - END
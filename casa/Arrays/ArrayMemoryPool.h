@@ -0,0 +1,113 @@
+//# ArrayMemoryPool.h: Thread-local pool for Array storage
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYMEMORYPOOL_2_H
+#define CASA_ARRAYMEMORYPOOL_2_H
+
+#include <cstddef>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Thread-local pool of aligned memory blocks for Array storage
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="tAllocator.cc" demos="">
+// </reviewed>
+
+// <synopsis>
+// ArrayMemoryPool allocates the storage of Arrays and of Blocks using
+// PooledAllocator. All memory is aligned at 64 bytes (a cache line and
+// suitable for all SIMD instruction sets).
+// <p>
+// If caching is enabled, sizes are rounded up to a size class (4 classes
+// per power of 2) and a freed block is kept in a cache of the
+// thread freeing it and reused for the next allocation of the same size
+// class in that thread. This avoids going to the system allocator (and
+// its locks) for the many short-lived Arrays of equal size created in
+// loops, for example when getting data from table columns or when
+// iterating through a lattice. Large blocks and blocks exceeding the
+// cache limits are returned to the system.
+// <p>
+// Caching is disabled by default for Array storage. It can be enabled
+// for the entire process using <src>setCaching</src>. Storage of Blocks
+// with a <linkto class=PooledAllocator>PooledAllocator</linkto> is always
+// cached.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   ArrayMemoryPool::setCaching (true);
+//   for (rownr_t row=0; row<nrow; ++row) {
+//     Matrix<Complex> data = dataCol(row);   // storage reused from cache
+//     ...
+//   }
+// </srcblock>
+// </example>
+
+class ArrayMemoryPool
+{
+public:
+  // The alignment of all blocks.
+  static constexpr size_t alignment = 64;
+
+  // Allocate a block of at least <src>nbytes</src> bytes.
+  // If <src>cache</src> is true, the size is rounded up to its size class
+  // and the block can be taken from the cache of this thread. Otherwise
+  // exactly <src>nbytes</src> bytes are allocated.
+  // A null pointer is returned if <src>nbytes</src> is 0.
+  // std::bad_alloc is thrown if no memory is available.
+  static void* allocate (size_t nbytes, bool cache);
+
+  // Free a block allocated with the given size.
+  // If <src>cache</src> is true, the block is kept in the cache of this
+  // thread (if within the limits). It must have the same value as used
+  // when allocating the block.
+  // <br>Memory allocated by other means using <src>malloc</src> or
+  // <src>posix_memalign</src> can be freed with <src>cache=false</src>.
+  static void deallocate (void* ptr, size_t nbytes, bool cache);
+
+  // Enable or disable caching of freed Array storage (default disabled).
+  // It only applies to Arrays created thereafter.
+  // <group>
+  static void setCaching (bool enable);
+  static bool caching();
+  // </group>
+
+  // Return the blocks cached by the calling thread to the system.
+  static void releaseCache();
+
+  // Get the number of bytes cached by the calling thread.
+  static size_t cachedBytes();
+
+  // Get the size a block of <src>nbytes</src> is rounded up to if cached.
+  static size_t roundedSize (size_t nbytes);
+};
+
+} //# NAMESPACE CASACORE - END
+
+#endif
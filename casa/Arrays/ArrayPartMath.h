@@ -252,6 +252,9 @@ template<typename T> Array<T> partialInterQuartileRanges (const Array<T>& array,
     virtual ~MedianFunc() {}
     virtual T operator() (const Array<T>& arr) const final override
       { return median(arr, itsTmp, itsSorted, itsTakeEvenMean, itsInPlace); }
+    bool sorted() const       { return itsSorted; }
+    bool takeEvenMean() const { return itsTakeEvenMean; }
+    bool inPlace() const      { return itsInPlace; }
   private:
     bool     itsSorted;
     bool     itsTakeEvenMean;
@@ -266,6 +269,9 @@ template<typename T> Array<T> partialInterQuartileRanges (const Array<T>& array,
     virtual ~MadfmFunc() {}
     virtual T operator()(const Array<T>& arr) const final override
       { return madfm(arr, itsTmp, itsSorted, itsTakeEvenMean, itsInPlace); }
+    bool sorted() const       { return itsSorted; }
+    bool takeEvenMean() const { return itsTakeEvenMean; }
+    bool inPlace() const      { return itsInPlace; }
   private:
     bool     itsSorted;
     bool     itsTakeEvenMean;
@@ -280,6 +286,9 @@ template<typename T> Array<T> partialInterQuartileRanges (const Array<T>& array,
     virtual ~FractileFunc() {}
     virtual T operator() (const Array<T>& arr) const final override
       { return fractile(arr, itsTmp, itsFraction, itsSorted, itsInPlace); }
+    float fraction() const { return itsFraction; }
+    bool sorted() const    { return itsSorted; }
+    bool inPlace() const   { return itsInPlace; }
   private:
     float    itsFraction;
     bool     itsSorted;
@@ -382,10 +391,16 @@ template<typename T> Array<T> partialInterQuartileRanges (const Array<T>& array,
 // no full boxes can be made. true means it is set to zero; false means
 // that the edge is removed, thus the output array is smaller than the
 // input array.
-// <note> This brute-force method of determining the medians outperforms
-// all kinds of smart implementations. For a vector it is about as fast
-// as casacore class MedianSlider, for a 2D array
-// it is much, much faster.
+// <note> For the functors SumFunc, SumSqrFunc, MeanFunc, RmsFunc, MinFunc,
+// MaxFunc, MedianFunc, MadfmFunc and FractileFunc (the latter three not
+// sorted or in place) the result is calculated incrementally while
+// moving the box along the first axis. Sums are kept as running sums,
+// the others keep the box values in sorted order. The lines along the
+// first axis are processed in parallel if OpenMP is used.
+// Other functors are applied to each box by brute force.
+// Running sums can give slightly different rounding errors; order
+// statistics give exactly the same results. Lines containing NaNs or
+// infinities are done by brute force.
 // </note>
   template<typename T>
   inline Array<T> slidingArrayMath (const Array<T>& a,
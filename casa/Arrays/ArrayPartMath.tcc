@@ -27,11 +27,239 @@
 #include "ArrayIter.h"
 #include "ArrayError.h"
 
+#include <algorithm>
 #include <cassert>
 #include <complex>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+namespace arrays_internal {
+
+  // Arrays with fewer elements are reduced by a single thread.
+  const size_t partialParallelMin = 65536;
+
+  // The accumulation functors used by the partialXXX functions.
+  // Argument k is the index of the result element (needed to find the
+  // mean belonging to it).
+  template<typename T> struct PartSumOp {
+    void operator() (T& acc, const T& v, size_t) const
+      { acc += v; }
+  };
+  template<typename T> struct PartSumSqrOp {
+    void operator() (T& acc, const T& v, size_t) const
+      { acc += v*v; }
+  };
+  template<typename T> struct PartProductOp {
+    void operator() (T& acc, const T& v, size_t) const
+      { acc *= v; }
+  };
+  template<typename T> struct PartMinOp {
+    void operator() (T& acc, const T& v, size_t) const
+      { if (v < acc) acc = v; }
+  };
+  template<typename T> struct PartMaxOp {
+    void operator() (T& acc, const T& v, size_t) const
+      { if (v > acc) acc = v; }
+  };
+  template<typename T> struct PartVarianceOp {
+    explicit PartVarianceOp (const T* mean) : itsMean(mean) {}
+    void operator() (T& acc, const T& v, size_t k) const
+      { T var = v - itsMean[k]; acc += var*var; }
+    const T* itsMean;
+  };
+  template<typename T> struct PartComplexVarianceOp {
+    explicit PartComplexVarianceOp (const std::complex<T>* mean)
+      : itsMean(mean) {}
+    void operator() (std::complex<T>& acc, const std::complex<T>& v,
+                     size_t k) const
+      { std::complex<T> var = v - itsMean[k];
+        acc += var.real()*var.real() + var.imag()*var.imag(); }
+    const std::complex<T>* itsMean;
+  };
+  template<typename T> struct PartAvdevOp {
+    explicit PartAvdevOp (const T* mean) : itsMean(mean) {}
+    void operator() (T& acc, const T& v, size_t k) const
+      { acc += std::abs(v - itsMean[k]); }
+    const T* itsMean;
+  };
+
+  // Accumulate the data into the result for axes 0 till nax.
+  // If cont, the first axes are collapsed and contiguous, so n0 values
+  // can be accumulated into a single result element. Otherwise axis 0
+  // is not collapsed and res is incremented for each value.
+  template<typename T, typename RES, typename OP>
+  void partialWalk (const T* data, RES* res, const RES* resBase,
+                    const IPosition& shape, const IPosition& incr,
+                    size_t stax, size_t nax, bool cont, size_t n0,
+                    const OP& op)
+  {
+    int incr0 = incr(0);
+    IPosition pos(nax, 0);
+    while (true) {
+      if (cont) {
+        RES tmp = *res;
+        size_t k = res - resBase;
+        for (size_t i=0; i<n0; i++) {
+          op (tmp, data[i], k);
+        }
+        data += n0;
+        *res = tmp;
+      } else {
+        for (size_t i=0; i<n0; i++) {
+          op (*res, *data++, res - resBase);
+          res += incr0;
+        }
+      }
+      size_t ax;
+      for (ax=stax; ax<nax; ax++) {
+        res += incr(ax);
+        if (++pos(ax) < shape(ax)) {
+          break;
+        }
+        pos(ax) = 0;
+      }
+      if (ax == nax) {
+        break;
+      }
+    }
+  }
+
+  // Accumulate the data into the result (which must be initialized).
+  // If OpenMP is used and the array is large enough, the work is split
+  // over the last non-collapsed axis, so each thread fills its own part
+  // of the result. Each result element gets its values in the same order
+  // as in the serial case, thus the results do not depend on the number
+  // of threads.
+  template<typename T, typename RES, typename OP>
+  void partialReduce (const T* data, RES* res, const IPosition& shape,
+                      const IPosition& collapseAxes, const IPosition& incr,
+                      size_t stax, int nelemCont, const OP& op)
+  {
+    size_t ndim = shape.nelements();
+    bool cont = true;
+    size_t n0 = nelemCont;
+    if (nelemCont <= 1) {
+      cont = false;
+      n0 = shape(0);
+      stax = 1;
+    }
+    IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
+    int nthr = 1;
+    size_t splitAx = 0;
+#ifdef _OPENMP
+    if (resAxes.nelements() > 0) {
+      splitAx = resAxes[resAxes.nelements() - 1];
+      if (splitAx >= stax  &&  shape(splitAx) > 1  &&
+          size_t(shape.product()) >= partialParallelMin) {
+        nthr = std::min (omp_get_max_threads(), int(shape(splitAx)));
+      }
+    }
+#endif
+    if (nthr <= 1) {
+      partialWalk (data, res, res, shape, incr, stax, ndim, cont, n0, op);
+      return;
+    }
+    // All axes after splitAx are collapsed.
+    size_t nr = shape(splitAx);
+    size_t ninner = 1;
+    for (size_t i=0; i<splitAx; ++i) {
+      ninner *= shape(i);
+    }
+    size_t nouter = 1;
+    for (size_t i=splitAx+1; i<ndim; ++i) {
+      nouter *= shape(i);
+    }
+    size_t nresInner = 1;
+    for (size_t i=0; i<resAxes.nelements()-1; ++i) {
+      nresInner *= shape(resAxes[i]);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr)
+#endif
+    for (int t=0; t<nthr; ++t) {
+      size_t rst = t*nr/nthr;
+      size_t rend = (t+1)*nr/nthr;
+      for (size_t o=0; o<nouter; ++o) {
+        for (size_t r=rst; r<rend; ++r) {
+          partialWalk (data + (o*nr + r)*ninner, res + r*nresInner, res,
+                       shape, incr, stax, splitAx, cont, n0, op);
+        }
+      }
+    }
+  }
+
+  // Apply a function (e.g. median) to each section of the array given
+  // by the collapse axes. The sections are independent, so they can be
+  // handled in parallel. Each thread uses its own scratch vector.
+  template<typename T, typename FUNC>
+  Array<T> partialSectionMath (const Array<T>& array,
+                               const IPosition& collapseAxes,
+                               bool inPlace, FUNC func)
+  {
+    // Need to make shallow copy because operator() is non-const.
+    Array<T> arr = array;
+    // Is there anything to collapse?
+    if (collapseAxes.nelements() == 0) {
+      return (inPlace  ?  array : array.copy());
+    }
+    const IPosition& shape = array.shape();
+    size_t ndim = shape.nelements();
+    if (ndim == 0) {
+      return Array<T>();
+    }
+    // Get the remaining axes.
+    // It also checks if axes are specified correctly.
+    IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
+    size_t ndimRes = resAxes.nelements();
+    // Create the result shape.
+    IPosition resShape(ndimRes);
+    for (size_t i=0; i<ndimRes; ++i) {
+      resShape[i] = shape[resAxes[i]];
+    }
+    if (ndimRes == 0) {
+      resShape.resize(1);
+      resShape[0] = 1;
+    }
+    Array<T> result (resShape);
+    size_t nres = result.nelements();
+    bool deleteRes;
+    T* resData = result.getStorage (deleteRes);
+#ifdef _OPENMP
+    int nthr = 1;
+    if (nres > 1  &&  array.nelements() >= partialParallelMin) {
+      nthr = std::min (size_t(omp_get_max_threads()), nres);
+    }
+#pragma omp parallel num_threads(nthr) if (nthr > 1)
+#endif
+    {
+      std::vector<T> tmp;
+      // Create blc and trc to step through the input array.
+      IPosition blc(ndim, 0);
+      IPosition trc(shape-1);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for (long long i=0; i<(long long)nres; ++i) {
+        size_t rest = i;
+        for (size_t ax=0; ax<ndimRes; ++ax) {
+          blc[resAxes[ax]] = trc[resAxes[ax]] = rest % resShape[ax];
+          rest /= resShape[ax];
+        }
+        resData[i] = func (arr(blc,trc), tmp);
+      }
+    }
+    result.putStorage (resData, deleteRes);
+    return result;
+  }
+
+} //# NAMESPACE ARRAYS_INTERNAL
+
 template<typename T> Array<T> partialSums (const Array<T>& array,
 					const IPosition& collapseAxes)
 {
@@ -51,49 +279,10 @@ template<typename T> Array<T> partialSums (const Array<T>& array,
   result = 0;
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	tmp += *data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res += *data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartSumOp<T>());
   array.freeStorage (arrData, deleteData);
   result.putStorage (resData, deleteRes);
   return result;
@@ -118,51 +307,10 @@ template<typename T> Array<T> partialSumSqrs (const Array<T>& array,
   result = 0;
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	tmp += *data * *data;
-        data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res += *data * *data;
-        data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartSumSqrOp<T>());
   array.freeStorage (arrData, deleteData);
   result.putStorage (resData, deleteRes);
   return result;
@@ -187,49 +335,10 @@ template<typename T> Array<T> partialProducts (const Array<T>& array,
   result = T(1);
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	tmp *= *data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res *= *data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartProductOp<T>());
   array.freeStorage (arrData, deleteData);
   result.putStorage (resData, deleteRes);
   return result;
@@ -254,9 +363,7 @@ template<typename T> Array<T> partialMins (const Array<T>& array,
   result = 0;
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
   // Initialize the minima with the first value of collapsed axes.
   IPosition end(shape-1);
   for (size_t i=0; i<collapseAxes.nelements(); i++) {
@@ -266,52 +373,9 @@ template<typename T> Array<T> partialMins (const Array<T>& array,
   Array<T> tmp(array);           // to get a non-const array for operator()
   Array<T> scratch(result);
   result.assign_conforming( tmp(IPosition(ndim,0), end).reform (resShape) );
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	if (*data < tmp) {
-	  tmp = *data;
-	}
-	data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	if (*data < *res) {
-	  *res = *data;
-	}
-	data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartMinOp<T>());
   array.freeStorage (arrData, deleteData);
   result.putStorage (resData, deleteRes);
   return result;
@@ -336,9 +400,7 @@ template<typename T> Array<T> partialMaxs (const Array<T>& array,
   result = 0;
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
   // Initialize the maxima with the first value of collapsed axes.
   IPosition end(shape-1);
   for (size_t i=0; i<collapseAxes.nelements(); i++) {
@@ -347,52 +409,9 @@ template<typename T> Array<T> partialMaxs (const Array<T>& array,
   }
   Array<T> tmp(array);           // to get a non-const array for operator()
   result.assign_conforming( tmp(IPosition(ndim,0), end).reform (resShape) );
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	if (*data > tmp) {
-	  tmp = *data;
-	}
-	data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	if (*data > *res) {
-	  *res = *data;
-	}
-	data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartMaxOp<T>());
   array.freeStorage (arrData, deleteData);
   result.putStorage (resData, deleteRes);
   return result;
@@ -452,57 +471,12 @@ template<typename T> Array<T> partialVariances (const Array<T>& array,
   }
   bool deleteData, deleteRes, deleteMean;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   const T* meanData = means.getStorage (deleteMean);
-  const T* mean = meanData;
   T* resData = result.getStorage (deleteRes);
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartVarianceOp<T>(meanData));
   T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      T tmpm = *mean;
-      for (size_t i=0; i<n0; i++) {
-	T var = *data++ - tmpm;
-	tmp += var*var;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	T var = *data++ - *mean;
-	*res += var*var;
-	res += incr0;
-	mean += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      mean += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
-  res = resData;
   for (size_t i=0; i<nr; i++) {
     res[i] /= 1.0 * factor;
   }
@@ -539,57 +513,12 @@ Array<std::complex<T>> partialVariances (const Array<std::complex<T>>& array,
   }
   bool deleteData, deleteRes, deleteMean;
   const std::complex<T>* arrData = array.getStorage (deleteData);
-  const std::complex<T>* data = arrData;
   const std::complex<T>* meanData = means.getStorage (deleteMean);
-  const std::complex<T>* mean = meanData;
   std::complex<T>* resData = result.getStorage (deleteRes);
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartComplexVarianceOp<T>(meanData));
   std::complex<T>* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      std::complex<T> tmp = *res;
-      std::complex<T> tmpm = *mean;
-      for (size_t i=0; i<n0; i++) {
-        std::complex<T> var = *data++ - tmpm;
-	tmp += var.real()*var.real() + var.imag()*var.imag();
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-        std::complex<T> var = *data++ - *mean;
-	*res += var.real()*var.real() + var.imag()*var.imag();
-	res += incr0;
-	mean += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      mean += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
-  res = resData;
   for (size_t i=0; i<nr; i++) {
     res[i] /= 1.0 * factor;
   }
@@ -622,55 +551,12 @@ template<typename T> Array<T> partialAvdevs (const Array<T>& array,
   size_t factor = array.nelements() / nr;
   bool deleteData, deleteRes, deleteMean;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   const T* meanData = means.getStorage (deleteMean);
-  const T* mean = meanData;
   T* resData = result.getStorage (deleteRes);
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartAvdevOp<T>(meanData));
   T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      T tmpm = *mean;
-      for (size_t i=0; i<n0; i++) {
-	tmp += std::abs(*data++ - tmpm);
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res += std::abs(*data++ - *mean);
-	res += incr0;
-	mean += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      mean += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
-  res = resData;
   for (size_t i=0; i<nr; i++) {
     res[i] /= 1.0 * factor;
   }
@@ -701,52 +587,11 @@ template<typename T> Array<T> partialRmss (const Array<T>& array,
   size_t factor = array.nelements() / nr;
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
+  arrays_internal::partialReduce (arrData, resData, shape, collapseAxes,
+                                  incr, stax, nelemCont,
+                                  arrays_internal::PartSumSqrOp<T>());
   T* res = resData;
-  // Find out how contiguous the data is, i.e. if some contiguous data
-  // end up in the same output element.
-  // cont tells if any data are contiguous.
-  // stax gives the first non-contiguous axis.
-  // n0 gives the number of contiguous elements.
-  bool cont = true;
-  size_t n0 = nelemCont;
-  int incr0 = incr(0);
-  if (nelemCont <= 1) {
-    cont = false;
-    n0 = shape(0);
-    stax = 1;
-  }
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	tmp += *data * *data;
-	data++;
-      }
-      *res = tmp;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res += *data * *data;
-	data++;
-	res += incr0;
-      }
-    }
-    size_t ax;
-    for (ax=stax; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
-      }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
-    }
-  }
-  res = resData;
   for (size_t i=0; i<nr; i++) {
     res[i] = T(std::sqrt (res[i] / factor));
   }
@@ -760,60 +605,10 @@ template<typename T> Array<T> partialMedians (const Array<T>& array,
 					   bool takeEvenMean,
 					   bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  size_t ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  size_t ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (size_t i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  std::vector<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (true) {
-    *res++ = median(arr(blc,trc), tmp, false, takeEvenMean, inPlace);
-    size_t ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-	blc[resAxes[ax]]++;
-	trc[resAxes[ax]]++;
-	break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return arrays_internal::partialSectionMath
+    (array, collapseAxes, inPlace,
+     [=] (const Array<T>& a, std::vector<T>& tmp)
+     { return median (a, tmp, false, takeEvenMean, inPlace); });
 }
 
 template<typename T> Array<T> partialMadfms (const Array<T>& array,
@@ -821,60 +616,10 @@ template<typename T> Array<T> partialMadfms (const Array<T>& array,
                                          bool takeEvenMean,
                                          bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  size_t ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  size_t ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (size_t i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  std::vector<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (true) {
-    *res++ = madfm(arr(blc,trc), tmp, false, takeEvenMean, inPlace);
-    size_t ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-       blc[resAxes[ax]]++;
-       trc[resAxes[ax]]++;
-       break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return arrays_internal::partialSectionMath
+    (array, collapseAxes, inPlace,
+     [=] (const Array<T>& a, std::vector<T>& tmp)
+     { return madfm (a, tmp, false, takeEvenMean, inPlace); });
 }
 
 template<typename T> Array<T> partialFractiles (const Array<T>& array,
@@ -885,60 +630,10 @@ template<typename T> Array<T> partialFractiles (const Array<T>& array,
   if (fraction < 0  ||  fraction > 1) {
     throw(ArrayError("::fractile(const Array<T>&) - fraction <0 or >1 "));
   }    
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  size_t ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  size_t ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (size_t i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  std::vector<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (true) {
-    *res++ = fractile(arr(blc,trc), tmp, fraction, false, inPlace);
-    size_t ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-	blc[resAxes[ax]]++;
-	trc[resAxes[ax]]++;
-	break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return arrays_internal::partialSectionMath
+    (array, collapseAxes, inPlace,
+     [=] (const Array<T>& a, std::vector<T>& tmp)
+     { return fractile (a, tmp, fraction, false, inPlace); });
 }
 
 template<typename T> Array<T> partialInterFractileRanges (const Array<T>& array,
@@ -946,60 +641,10 @@ template<typename T> Array<T> partialInterFractileRanges (const Array<T>& array,
                                                        float fraction,
                                                        bool inPlace)
 {
-  // Need to make shallow copy because operator() is non-const.
-  Array<T> arr = array;
-  // Is there anything to collapse?
-  if (collapseAxes.nelements() == 0) {
-    return (inPlace  ?  array : array.copy());
-  }
-  const IPosition& shape = array.shape();
-  size_t ndim = shape.nelements();
-  if (ndim == 0) {
-    return Array<T>();
-  }
-  // Get the remaining axes.
-  // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (ndim, collapseAxes);
-  size_t ndimRes = resAxes.nelements();
-  // Create the result shape.
-  // Create blc and trc to step through the input array.
-  IPosition resShape(ndimRes);
-  IPosition blc(ndim, 0);
-  IPosition trc(shape-1);
-  for (size_t i=0; i<ndimRes; ++i) {
-    resShape[i] = shape[resAxes[i]];
-    trc[resAxes[i]] = 0;
-  }
-  if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  }
-  Array<T> result (resShape);
-  bool deleteRes;
-  T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  std::vector<T> tmp;
-  // Loop through all data and assemble as needed.
-  IPosition pos(ndimRes, 0);
-  while (true) {
-    *res++ = interFractileRange(arr(blc,trc), tmp, fraction, false, inPlace);
-    size_t ax;
-    for (ax=0; ax<ndimRes; ax++) {
-      if (++pos(ax) < resShape(ax)) {
-       blc[resAxes[ax]]++;
-       trc[resAxes[ax]]++;
-       break;
-      }
-      pos(ax) = 0;
-      blc[resAxes[ax]] = 0;
-      trc[resAxes[ax]] = 0;
-    }
-    if (ax == ndimRes) {
-      break;
-    }
-  }
-  result.putStorage (resData, deleteRes);
-  return result;
+  return arrays_internal::partialSectionMath
+    (array, collapseAxes, inPlace,
+     [=] (const Array<T>& a, std::vector<T>& tmp)
+     { return interFractileRange (a, tmp, fraction, false, inPlace); });
 }
 
 
@@ -1057,6 +702,450 @@ void boxedArrayMath (Array<RES>& result,
   }
 }
 
+namespace arrays_internal {
+
+  // The reductions slidingArrayMath can do incrementally.
+  enum SlidingKind {SlidingNone, SlidingSum, SlidingSumSqr, SlidingMean,
+                    SlidingRms, SlidingMin, SlidingMax, SlidingMedian,
+                    SlidingMadfm, SlidingFractile};
+
+  // Tell if a value is finite; (v-v) is 0 for finite values and NaN for
+  // infinities and NaNs (also for complex values).
+  template<typename T> inline bool slidingFinite (const T& v)
+    { return v-v == v-v; }
+
+  // Determine the kind of reduction done by a functor.
+  // By default it cannot be done incrementally.
+  template<typename T, typename RES>
+  SlidingKind slidingKind (const ArrayFunctorBase<T,RES>&, bool&, float&)
+    { return SlidingNone; }
+
+  // The order statistics can only be done incrementally for real values.
+  template<typename T>
+  SlidingKind slidingOrderKind (const ArrayFunctorBase<T>&, bool&, float&,
+                                std::false_type)
+    { return SlidingNone; }
+
+  template<typename T>
+  SlidingKind slidingOrderKind (const ArrayFunctorBase<T>& func,
+                                bool& takeEvenMean, float& fraction,
+                                std::true_type)
+  {
+    if (dynamic_cast<const MinFunc<T>*>(&func)) return SlidingMin;
+    if (dynamic_cast<const MaxFunc<T>*>(&func)) return SlidingMax;
+    // Sorted or in place sliding medians make no sense, so leave them as is.
+    if (const MedianFunc<T>* f = dynamic_cast<const MedianFunc<T>*>(&func)) {
+      takeEvenMean = f->takeEvenMean();
+      return (f->sorted() || f->inPlace()  ?  SlidingNone : SlidingMedian);
+    }
+    if (const MadfmFunc<T>* f = dynamic_cast<const MadfmFunc<T>*>(&func)) {
+      takeEvenMean = f->takeEvenMean();
+      return (f->sorted() || f->inPlace()  ?  SlidingNone : SlidingMadfm);
+    }
+    if (const FractileFunc<T>* f = dynamic_cast<const FractileFunc<T>*>(&func)) {
+      fraction = f->fraction();
+      return (f->sorted() || f->inPlace()  ?  SlidingNone : SlidingFractile);
+    }
+    return SlidingNone;
+  }
+
+  template<typename T>
+  SlidingKind slidingKind (const ArrayFunctorBase<T>& func,
+                           bool& takeEvenMean, float& fraction)
+  {
+    if (std::is_same<T,bool>::value) return SlidingNone;
+    if (dynamic_cast<const SumFunc<T>*>(&func))    return SlidingSum;
+    if (dynamic_cast<const SumSqrFunc<T>*>(&func)) return SlidingSumSqr;
+    if (dynamic_cast<const MeanFunc<T>*>(&func))   return SlidingMean;
+    if (dynamic_cast<const RmsFunc<T>*>(&func))    return SlidingRms;
+    return slidingOrderKind (func, takeEvenMean, fraction,
+                             std::integral_constant<bool,
+                             std::is_arithmetic<T>::value>());
+  }
+
+  // Scratch buffers used by a thread to process a line.
+  template<typename T> struct SlidingScratch {
+    std::vector<T> colAcc;     // reduced values per column
+    std::vector<T> win;        // sorted values in the box
+    std::vector<T> next;
+    std::vector<T> out;        // sorted values of the column leaving the box
+    std::vector<T> in;         // sorted values of the column entering the box
+    std::vector<size_t> deque;
+    std::vector<T> tmp;
+  };
+
+  // Get the value of a sum-like reduction from the sum.
+  template<typename T>
+  inline T slidingSumResult (SlidingKind kind, const T& sum, size_t n)
+  {
+    switch (kind) {
+    case SlidingMean:
+      return T(sum/T(1.0*n));
+    case SlidingRms:
+      return T(std::sqrt(sum/T(1.0*n)));
+    default:
+      return sum;
+    }
+  }
+
+  // Get the median of the sorted values (as done by function median).
+  template<typename T>
+  inline T slidingMedian (const T* data, size_t n, bool takeEvenMean)
+  {
+    size_t n2 = (n - 1)/2;
+    if (n%2 != 0  ||  !takeEvenMean) {
+      return data[n2];
+    }
+    return T(0.5 * (data[n2] + data[n2+1]));
+  }
+
+  // Get the madfm of the sorted values (as done by function madfm).
+  // The absolute deviations left and right of the median are sorted
+  // sequences, so the median of their merge can be found directly.
+  template<typename T>
+  T slidingMadfm (const T* data, size_t n, bool takeEvenMean)
+  {
+    T med = slidingMedian (data, n, takeEvenMean);
+    size_t split = std::lower_bound (data, data+n, med) - data;
+    size_t n2 = (n - 1)/2;
+    bool takeMean = (n%2 == 0  &&  takeEvenMean);
+    size_t l = split;
+    size_t r = split;
+    T dev = T();
+    for (size_t i=0; i<=n2+1; ++i) {
+      if (l > 0  &&  (r == n  ||  med - data[l-1] < data[r] - med)) {
+        --l;
+        dev = med - data[l];
+      } else {
+        dev = data[r] - med;
+        ++r;
+      }
+      if (i == n2) {
+        if (!takeMean) {
+          return dev;
+        }
+        med = dev;
+      }
+    }
+    return T(0.5 * (med + dev));
+  }
+
+  // Get the result of a reduction for a single box by brute force.
+  // It is used for boxes containing NaNs or infinities.
+  template<typename T>
+  T slidingSumDirect (SlidingKind kind, const Array<T>& box)
+  {
+    switch (kind) {
+    case SlidingSum:
+      return sum(box);
+    case SlidingSumSqr:
+      return sumsqr(box);
+    case SlidingMean:
+      return mean(box);
+    default:
+      return rms(box);
+    }
+  }
+
+  template<typename T>
+  T slidingOrderDirect (SlidingKind kind, const Array<T>& box,
+                        std::vector<T>& tmp, bool takeEvenMean,
+                        float fraction)
+  {
+    switch (kind) {
+    case SlidingMin:
+      return min(box);
+    case SlidingMax:
+      return max(box);
+    case SlidingMedian:
+      return median(box, tmp, false, takeEvenMean, false);
+    case SlidingMadfm:
+      return madfm(box, tmp, false, takeEvenMean, false);
+    default:
+      return fractile(box, tmp, fraction, false, false);
+    }
+  }
+
+  // Process a line for a reduction based on sums.
+  // The box values are first summed per column (i.e., over all axes
+  // but the first). A running sum over the columns gives the result. To
+  // bound rounding errors the running sum is recalculated each time the
+  // box has moved over its full width.
+  template<typename T>
+  void slidingSumLine (T* res, const T* data, const Array<T>& array,
+                       const IPosition& blc, const IPosition& boxEnd,
+                       const std::vector<size_t>& colOff, size_t nres,
+                       SlidingKind kind, SlidingScratch<T>& scratch)
+  {
+    size_t nx = nres + boxEnd[0];
+    size_t w = boxEnd[0] + 1;
+    size_t n = w * colOff.size();
+    std::vector<T>& colAcc = scratch.colAcc;
+    colAcc.assign (nx, T());
+    bool finite = true;
+    for (size_t j=0; j<colOff.size(); ++j) {
+      const T* line = data + colOff[j];
+      if (kind == SlidingSumSqr  ||  kind == SlidingRms) {
+        for (size_t x=0; x<nx; ++x) {
+          colAcc[x] += line[x] * line[x];
+        }
+      } else {
+        for (size_t x=0; x<nx; ++x) {
+          colAcc[x] += line[x];
+        }
+      }
+    }
+    for (size_t x=0; x<nx; ++x) {
+      finite = finite && slidingFinite(colAcc[x]);
+    }
+    if (!finite) {
+      IPosition b(blc);
+      IPosition e(blc + boxEnd);
+      for (size_t i=0; i<nres; ++i, ++b[0], ++e[0]) {
+        res[i] = slidingSumDirect (kind, array(b, e));
+      }
+      return;
+    }
+    T sum = T();
+    for (size_t i=0; i<nres; ++i) {
+      if (i % w == 0) {
+        sum = T();
+        for (size_t x=i; x<i+w; ++x) {
+          sum += colAcc[x];
+        }
+      } else {
+        sum += colAcc[i+w-1];
+        sum -= colAcc[i-1];
+      }
+      res[i] = slidingSumResult (kind, sum, n);
+    }
+  }
+
+  // Gather the sorted values of column x.
+  template<typename T>
+  inline void slidingColumn (std::vector<T>& col, const T* data, size_t x,
+                             const std::vector<size_t>& colOff)
+  {
+    col.resize (colOff.size());
+    for (size_t j=0; j<colOff.size(); ++j) {
+      col[j] = data[colOff[j] + x];
+    }
+    std::sort (col.begin(), col.end());
+  }
+
+  // Process a line for an order statistic.
+  // Minima and maxima are taken per column, whereafter a monotonic deque
+  // gives the running minimum or maximum over the columns.
+  // For the other statistics the sorted box values are kept. When moving
+  // the box, the sorted values of the column leaving and entering the box
+  // are merged in.
+  template<typename T>
+  void slidingOrderLine (T*, const T*, const Array<T>&,
+                         const IPosition&, const IPosition&,
+                         const std::vector<size_t>&, size_t,
+                         SlidingKind, bool, float,
+                         SlidingScratch<T>&, std::false_type)
+    {}
+
+  template<typename T>
+  void slidingOrderLine (T* res, const T* data, const Array<T>& array,
+                         const IPosition& blc, const IPosition& boxEnd,
+                         const std::vector<size_t>& colOff, size_t nres,
+                         SlidingKind kind, bool takeEvenMean, float fraction,
+                         SlidingScratch<T>& scratch, std::true_type)
+  {
+    size_t nx = nres + boxEnd[0];
+    size_t w = boxEnd[0] + 1;
+    size_t m = colOff.size();
+    size_t n = w * m;
+    // NaNs cannot be ordered, so use brute force if there are any.
+    bool finite = true;
+    for (size_t j=0; j<m  &&  finite; ++j) {
+      const T* line = data + colOff[j];
+      for (size_t x=0; x<nx; ++x) {
+        finite = finite && slidingFinite(line[x]);
+      }
+    }
+    if (!finite) {
+      IPosition b(blc);
+      IPosition e(blc + boxEnd);
+      for (size_t i=0; i<nres; ++i, ++b[0], ++e[0]) {
+        res[i] = slidingOrderDirect (kind, array(b, e), scratch.tmp,
+                                     takeEvenMean, fraction);
+      }
+      return;
+    }
+    if (kind == SlidingMin  ||  kind == SlidingMax) {
+      std::vector<T>& colAcc = scratch.colAcc;
+      colAcc.assign (data + colOff[0], data + colOff[0] + nx);
+      for (size_t j=1; j<m; ++j) {
+        const T* line = data + colOff[j];
+        if (kind == SlidingMin) {
+          for (size_t x=0; x<nx; ++x) {
+            if (line[x] < colAcc[x]) colAcc[x] = line[x];
+          }
+        } else {
+          for (size_t x=0; x<nx; ++x) {
+            if (line[x] > colAcc[x]) colAcc[x] = line[x];
+          }
+        }
+      }
+      // The deque holds the indices of increasing minima (or decreasing
+      // maxima) in the current box.
+      std::vector<size_t>& deque = scratch.deque;
+      deque.resize (nx);
+      size_t head = 0;
+      size_t tail = 0;
+      for (size_t x=0; x<nx; ++x) {
+        const T& v = colAcc[x];
+        while (tail > head  &&  (kind == SlidingMin  ?
+                                 !(colAcc[deque[tail-1]] < v) :
+                                 !(colAcc[deque[tail-1]] > v))) {
+          --tail;
+        }
+        deque[tail++] = x;
+        if (x + 1 >= w) {
+          size_t i = x + 1 - w;
+          if (deque[head] < i) {
+            ++head;
+          }
+          res[i] = colAcc[deque[head]];
+        }
+      }
+      return;
+    }
+    // Fill the box with the first w columns and sort it.
+    std::vector<T>& win = scratch.win;
+    win.resize (n);
+    for (size_t x=0; x<w; ++x) {
+      for (size_t j=0; j<m; ++j) {
+        win[x*m + j] = data[colOff[j] + x];
+      }
+    }
+    std::sort (win.begin(), win.end());
+    std::vector<T>& next = scratch.next;
+    next.resize (n);
+    size_t nf = size_t((n - 1) * double(fraction) + 0.01);
+    for (size_t i=0; i<nres; ++i) {
+      if (i > 0) {
+        // Remove column i-1 and add column i+w-1.
+        slidingColumn (scratch.out, data, i-1, colOff);
+        slidingColumn (scratch.in, data, i+w-1, colOff);
+        const T* out = scratch.out.data();
+        const T* in  = scratch.in.data();
+        size_t io = 0;
+        size_t ii = 0;
+        size_t k = 0;
+        for (size_t j=0; j<n; ++j) {
+          const T& v = win[j];
+          if (io < m  &&  v == out[io]) {
+            ++io;
+            continue;
+          }
+          while (ii < m  &&  in[ii] < v) {
+            next[k++] = in[ii++];
+          }
+          next[k++] = v;
+        }
+        while (ii < m) {
+          next[k++] = in[ii++];
+        }
+        win.swap (next);
+      }
+      switch (kind) {
+      case SlidingMedian:
+        res[i] = slidingMedian (win.data(), n, takeEvenMean);
+        break;
+      case SlidingMadfm:
+        res[i] = slidingMadfm (win.data(), n, takeEvenMean);
+        break;
+      default:
+        res[i] = win[nf];
+      }
+    }
+  }
+
+  // Do the sliding reduction incrementally along the first axis.
+  // Each line of the result (along the first axis) is independent, so the
+  // lines can be processed in parallel.
+  template<typename T>
+  void slidingIncremental (Array<T>& result, const Array<T>& array,
+                           const IPosition& boxEnd, SlidingKind kind,
+                           bool takeEvenMean, float fraction)
+  {
+    const IPosition& shape = array.shape();
+    const IPosition& resShape = result.shape();
+    size_t ndim = shape.size();
+    // Get the offsets of the box values in the first column.
+    IPosition steps (ndim);
+    size_t step = 1;
+    for (size_t i=0; i<ndim; ++i) {
+      steps[i] = step;
+      step *= shape[i];
+    }
+    std::vector<size_t> colOff(1, 0);
+    for (size_t ax=1; ax<ndim; ++ax) {
+      size_t nr = colOff.size();
+      for (size_t j=1; j<=size_t(boxEnd[ax]); ++j) {
+        for (size_t k=0; k<nr; ++k) {
+          colOff.push_back (colOff[k] + j*steps[ax]);
+        }
+      }
+    }
+    size_t nres = resShape[0];
+    size_t nlines = result.nelements() / nres;
+    bool deleteData, deleteRes;
+    const T* data = array.getStorage (deleteData);
+    T* res = result.getStorage (deleteRes);
+#ifdef _OPENMP
+    int nthr = 1;
+    if (nlines > 1  &&  array.nelements() >= partialParallelMin) {
+      nthr = std::min (size_t(omp_get_max_threads()), nlines);
+    }
+#pragma omp parallel num_threads(nthr) if (nthr > 1)
+#endif
+    {
+      SlidingScratch<T> scratch;
+      IPosition blc(ndim, 0);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for (long long line=0; line<(long long)nlines; ++line) {
+        size_t rest = line;
+        size_t offset = 0;
+        for (size_t ax=1; ax<ndim; ++ax) {
+          blc[ax] = rest % resShape[ax];
+          rest /= resShape[ax];
+          offset += blc[ax] * steps[ax];
+        }
+        if (kind <= SlidingRms) {
+          slidingSumLine (res + line*nres, data + offset, array, blc,
+                          boxEnd, colOff, nres, kind, scratch);
+        } else {
+          slidingOrderLine (res + line*nres, data + offset, array, blc,
+                            boxEnd, colOff, nres, kind, takeEvenMean,
+                            fraction, scratch,
+                            std::integral_constant<bool,
+                            std::is_arithmetic<T>::value>());
+        }
+      }
+    }
+    array.freeStorage (data, deleteData);
+    result.putStorage (res, deleteRes);
+  }
+
+  template<typename T, typename RES>
+  void slidingIncremental (Array<RES>&, const Array<T>&, const IPosition&,
+                           SlidingKind, bool, float)
+    {}
+
+  // Boolean arrays (e.g. slidingAlls) always use the brute force loop.
+  inline void slidingIncremental (Array<bool>&, const Array<bool>&,
+                                  const IPosition&, SlidingKind, bool, float)
+    {}
+
+} //# NAMESPACE ARRAYS_INTERNAL
+
 template <typename T, typename RES>
 void slidingArrayMath (Array<RES>& result,
                        const Array<T>& array,
@@ -1080,6 +1169,20 @@ void slidingArrayMath (Array<RES>& result,
       IPosition boxEnd2 (boxEnd/2);
       resa.reference (resa(boxEnd2, resShape+boxEnd2-1));
     }
+    // Use an incremental algorithm if possible.
+    bool takeEvenMean = false;
+    float fraction = 0;
+    arrays_internal::SlidingKind kind =
+      arrays_internal::slidingKind (funcObj, takeEvenMean, fraction);
+    if (kind > arrays_internal::SlidingMax  &&  boxEnd[0] == 0) {
+      // Nothing to gain for sorted boxes if not sliding along first axis.
+      kind = arrays_internal::SlidingNone;
+    }
+    if (kind != arrays_internal::SlidingNone) {
+      arrays_internal::slidingIncremental (resa, array, boxEnd, kind,
+                                           takeEvenMean, fraction);
+      return;
+    }
     typename Array<RES>::iterator iterarr(resa.begin());
     // Loop through all data and assemble as needed.
     IPosition blc(ndim, 0);
@@ -0,0 +1,202 @@
+//# ArrayRuns.h: Iterate through an Array in runs over the innermost axes
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYRUNS_2_H
+#define CASA_ARRAYRUNS_2_H
+
+#include "IPosition.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Iterate through (non-contiguous) Arrays in strided runs.
+// </summary>
+// <!-- <reviewed reviewer="UNKNOWN" date="" tests="tArrayRuns"> -->
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// Stepping through a non-contiguous Array (e.g. a section made with a
+// Slicer) with an Array iterator or an ArrayPositionIterator requires
+// some IPosition arithmetic per element or per line, which is much slower
+// than a loop through contiguous memory.
+// <br>The functions in this file divide the elements of one or more
+// Arrays with the same shape into runs. Each run is given by a pointer,
+// a stride, and a number of elements, so it can be processed with a
+// simple loop. Subsequent axes forming a single stride in all Arrays
+// (e.g. the first axes of a section only taking some planes of a cube)
+// are combined, so the runs are as long as possible. Axes with length 1
+// are skipped.
+// <br>The runs are given in the order of the Array elements (thus in
+// the order of the STL-style iterator), which makes it possible to
+// copy a non-contiguous Array to or from contiguous storage.
+// Nothing is done for empty Arrays.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Cube<float> cube(100,100,100);
+//   Array<float> section (cube(Slicer(IPosition(3,0,10,10),
+//                                     IPosition(3,100,50,50))));
+//   double sum = 0;
+//   arrayForEachRun (section,
+//                    [&sum](const float* p, ssize_t incr, size_t n) {
+//                      for (size_t i=0; i<n; ++i, p+=incr) sum += *p;
+//                    });
+// </srcblock>
+// </example>
+//
+// <group name="Array runs">
+
+namespace arrays_internal {
+
+  // Call <src>f(offsets, incrs, n)</src> for each run in Arrays with the
+  // given shape and steps. <src>offsets</src> and <src>incrs</src> are
+  // arrays giving the offset of the start of the run and the stride in
+  // each of the N Arrays.
+  template<size_t N, typename Func>
+  void forEachRun (const IPosition& shape,
+                   const std::array<const IPosition*,N>& steps, Func f)
+  {
+    typedef std::array<ssize_t,N> Offsets;
+    // Combine the axes. Each resulting axis has a length and a step
+    // per Array.
+    std::vector<size_t> lengths;
+    std::vector<Offsets> axSteps;
+    for (size_t ax=0; ax<shape.size(); ++ax) {
+      ssize_t len = shape[ax];
+      if (len == 0) {
+        return;
+      }
+      if (len > 1) {
+        bool combine = !lengths.empty();
+        for (size_t k=0; k<N && combine; ++k) {
+          combine = ((*steps[k])[ax] ==
+                     axSteps.back()[k] * ssize_t(lengths.back()));
+        }
+        if (combine) {
+          lengths.back() *= len;
+        } else {
+          Offsets st;
+          for (size_t k=0; k<N; ++k) {
+            st[k] = (*steps[k])[ax];
+          }
+          lengths.push_back (len);
+          axSteps.push_back (st);
+        }
+      }
+    }
+    Offsets offsets;
+    offsets.fill (0);
+    if (lengths.empty()) {
+      // A single element (or a 0-dim Array with a single element).
+      if (shape.size() > 0) {
+        Offsets incrs;
+        incrs.fill (1);
+        f (offsets, incrs, size_t(1));
+      }
+      return;
+    }
+    // Step through the outer axes like an odometer.
+    size_t nd = lengths.size();
+    std::vector<size_t> pos(nd, 0);
+    while (true) {
+      f (offsets, axSteps[0], lengths[0]);
+      size_t ax = 1;
+      for (; ax<nd; ++ax) {
+        for (size_t k=0; k<N; ++k) {
+          offsets[k] += axSteps[ax][k];
+        }
+        if (++pos[ax] < lengths[ax]) {
+          break;
+        }
+        for (size_t k=0; k<N; ++k) {
+          offsets[k] -= axSteps[ax][k] * ssize_t(lengths[ax]);
+        }
+        pos[ax] = 0;
+      }
+      if (ax == nd) {
+        break;
+      }
+    }
+  }
+
+} //# NAMESPACE arrays_internal
+
+// Call <src>f(p, incr, n)</src> for each run of elements in the Array,
+// where <src>p</src> points to the first element and <src>incr</src>
+// is the stride. <src>p</src> is a const pointer if the Array is const.
+template<typename A, typename Func>
+inline void arrayForEachRun (A& arr, Func f)
+{
+  auto data = arr.data();
+  arrays_internal::forEachRun<1>
+    (arr.shape(), {{&arr.steps()}},
+     [data,&f](const std::array<ssize_t,1>& off,
+               const std::array<ssize_t,1>& inc, size_t n)
+     { f(data+off[0], inc[0], n); });
+}
+
+// Call <src>f(p1, incr1, p2, incr2, n)</src> for each run of elements
+// in two Arrays with the same shape. The shapes are not checked.
+template<typename A1, typename A2, typename Func>
+inline void arrayForEachRun (A1& arr1, A2& arr2, Func f)
+{
+  auto data1 = arr1.data();
+  auto data2 = arr2.data();
+  arrays_internal::forEachRun<2>
+    (arr1.shape(), {{&arr1.steps(), &arr2.steps()}},
+     [data1,data2,&f](const std::array<ssize_t,2>& off,
+                      const std::array<ssize_t,2>& inc, size_t n)
+     { f(data1+off[0], inc[0], data2+off[1], inc[1], n); });
+}
+
+// Call <src>f(p1, incr1, p2, incr2, p3, incr3, n)</src> for each run of
+// elements in three Arrays with the same shape. The shapes are not checked.
+template<typename A1, typename A2, typename A3, typename Func>
+inline void arrayForEachRun (A1& arr1, A2& arr2, A3& arr3, Func f)
+{
+  auto data1 = arr1.data();
+  auto data2 = arr2.data();
+  auto data3 = arr3.data();
+  arrays_internal::forEachRun<3>
+    (arr1.shape(), {{&arr1.steps(), &arr2.steps(), &arr3.steps()}},
+     [data1,data2,data3,&f](const std::array<ssize_t,3>& off,
+                            const std::array<ssize_t,3>& inc, size_t n)
+     { f(data1+off[0], inc[0], data2+off[1], inc[1],
+         data3+off[2], inc[2], n); });
+}
+
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
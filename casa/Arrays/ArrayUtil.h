@@ -32,6 +32,7 @@
 
 #include <regex>
 #include <string>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -295,6 +296,43 @@ size_t reorderArrayHelper (IPosition& newShape, IPosition& incr,
 // </group>
 
 
+namespace arrays_internal {
+
+  // Describes how the data of a contiguous array are copied to a
+  // contiguous array with reordered axes. Axes with length 1 are left
+  // out and axes that are adjacent in both arrays are combined.
+  // Axis 0 is contiguous in the input; axis <src>outAxis</src> is
+  // contiguous in the output.
+  struct ReorderPlan
+  {
+    std::vector<size_t> length;
+    std::vector<size_t> inStride;
+    std::vector<size_t> outStride;
+    size_t outAxis;
+    size_t nelements;
+  };
+
+  // Make the plan to reorder an array with the given shape.
+  // The axes order is interpreted as in function reorderArray.
+  ReorderPlan makeReorderPlan (const IPosition& shape,
+                               const IPosition& newAxisOrder);
+
+  // Copy the data as described by the plan.
+  // If the axes contiguous in input and output differ, the data are
+  // transposed in square blocks fitting in the level 1 cache, so the
+  // reads and writes of a block use whole cache lines. Otherwise, the
+  // data are copied in contiguous runs. Large arrays are done in
+  // parallel if OpenMP is used.
+  template<typename T>
+  void reorderData (const T* in, T* out, const ReorderPlan& plan);
+
+  // Minimum number of elements for which the data are reordered in
+  // parallel.
+  constexpr size_t parallelReorderMin = 262144;
+
+} //# NAMESPACE arrays_internal
+
+
 
 } //# NAMESPACE CASACORE - END
 
@@ -78,50 +78,84 @@ Array<T> reorderArray (const Array<T>& array,
   Array<T> result(newShape);
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
-  const T* data = arrData;
   T* resData = result.getStorage (deleteRes);
-  T* res = resData;
-  // Find out the nr of contiguous elements.
-  size_t nrcont = 1;
-  if (contAxes == 0) {
-    contAxes = 1;
-  } else {
-    for (size_t i=0; i<contAxes; i++) {
-      nrcont *= shape(i);
-    }
+  arrays_internal::reorderData (arrData, resData,
+                                arrays_internal::makeReorderPlan
+                                (shape, newAxisOrder));
+  array.freeStorage (arrData, deleteData);
+  result.putStorage (resData, deleteRes);
+  return result;
+}
+
+
+
+namespace arrays_internal {
+
+template<typename T>
+void reorderData (const T* in, T* out, const ReorderPlan& plan)
+{
+  const size_t ndim = plan.length.size();
+  if (ndim <= 1  ||  plan.nelements == 0) {
+    std::copy_n (in, plan.nelements, out);
+    return;
   }
-  size_t incr0 = incr(0);
-  size_t n0 = shape(0);
-  // Loop through all data and copy as needed.
-  IPosition pos(ndim, 0);
-  while (true) {
-    if (nrcont > 1) {
-      std::copy_n(data, nrcont, res);
-      data += nrcont;
-      res += nrcont;
-    } else {
-      for (size_t i=0; i<n0; i++) {
-	*res = *data++;
-	res += incr0;
+  // Transpose axis 0 and outAxis in blocks of bsz*bsz elements.
+  // If outAxis is 0, rows are copied; bsz rows form a block.
+  const size_t bax = (plan.outAxis == 0  ?  1 : plan.outAxis);
+  size_t bsz = 64;
+  while (bsz > 8  &&  bsz*bsz*sizeof(T) > 16384) {
+    bsz /= 2;
+  }
+  const size_t n0 = plan.length[0];
+  const size_t nb = plan.length[bax];
+  const size_t nblock = (nb + bsz - 1) / bsz;
+  const size_t inStrideB  = plan.inStride[bax];
+  const size_t outStride0 = plan.outStride[0];
+  const size_t outStrideB = plan.outStride[bax];
+  const long long ntask = plan.nelements / (n0 * nb) * nblock;
+#ifdef _OPENMP
+#pragma omp parallel for if (plan.nelements >= parallelReorderMin)
+#endif
+  for (long long task=0; task<ntask; ++task) {
+    // Get the start of the block from the task number.
+    size_t inx = task / nblock;
+    const size_t b0 = (task % nblock) * bsz;
+    const size_t b1 = std::min (b0 + bsz, nb);
+    size_t inOff  = b0 * inStrideB;
+    size_t outOff = b0 * outStrideB;
+    for (size_t ax=1; ax<ndim; ++ax) {
+      if (ax != bax) {
+        size_t pos = inx % plan.length[ax];
+        inx /= plan.length[ax];
+        inOff  += pos * plan.inStride[ax];
+        outOff += pos * plan.outStride[ax];
       }
     }
-    size_t ax;
-    for (ax=contAxes; ax<ndim; ax++) {
-      res += incr(ax);
-      if (++pos(ax) < shape(ax)) {
-	break;
+    const T* from = in + inOff;
+    T* to = out + outOff;
+    if (plan.outAxis == 0) {
+      for (size_t j=b0; j<b1; ++j) {
+        std::copy_n (from, n0, to);
+        from += inStrideB;
+        to   += outStrideB;
+      }
+    } else {
+      for (size_t i0=0; i0<n0; i0+=bsz) {
+        const size_t i1 = std::min (i0 + bsz, n0);
+        for (size_t j=0; j<b1-b0; ++j) {
+          const T* f = from + j*inStrideB + i0;
+          T* t = to + j + i0*outStride0;
+          for (size_t i=i0; i<i1; ++i) {
+            *t = *f++;
+            t += outStride0;
+          }
+        }
       }
-      pos(ax) = 0;
-    }
-    if (ax == ndim) {
-      break;
     }
   }
-  array.freeStorage (arrData, deleteData);
-  result.putStorage (resData, deleteRes);
-  return result;
 }
 
+} //# NAMESPACE arrays_internal
 
 
 template<class T>
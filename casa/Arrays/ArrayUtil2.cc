@@ -161,5 +161,48 @@ size_t reorderArrayHelper (IPosition& newShape, IPosition& incr,
   return contAxes;
 }
 
+namespace arrays_internal {
+
+ReorderPlan makeReorderPlan (const IPosition& shape,
+                             const IPosition& newAxisOrder)
+{
+  size_t ndim = shape.nelements();
+  IPosition toOld = IPosition::makeAxisPath (ndim, newAxisOrder);
+  // Get the output stride of each input axis.
+  std::vector<size_t> outStride(ndim);
+  size_t volume = 1;
+  for (size_t i=0; i<ndim; i++) {
+    outStride[toOld[i]] = volume;
+    volume *= shape[toOld[i]];
+  }
+  ReorderPlan plan;
+  plan.nelements = volume;
+  plan.outAxis = 0;
+  // Leave out axes with length 1 and combine an axis with the previous
+  // one if also adjacent in the output.
+  size_t inStride = 1;
+  for (size_t i=0; i<ndim; i++) {
+    size_t len = shape[i];
+    if (len != 1) {
+      size_t nr = plan.length.size();
+      if (nr > 0  &&
+          outStride[i] == plan.outStride[nr-1] * plan.length[nr-1]) {
+        plan.length[nr-1] *= len;
+      } else {
+        plan.length.push_back (len);
+        plan.inStride.push_back (inStride);
+        plan.outStride.push_back (outStride[i]);
+        if (outStride[i] == 1) {
+          plan.outAxis = nr;
+        }
+      }
+    }
+    inStride *= len;
+  }
+  return plan;
+}
+
+} //# NAMESPACE arrays_internal
+
 } //# NAMESPACE CASACORE - END
 
@@ -28,10 +28,73 @@
 #include "Array.h"
 
 #include <cassert>
+#include <memory>
 #include <sstream>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+namespace {
+  // A flag per axis used by the axes functions below.
+  // The flags are kept on the stack for the usual number of axes, so
+  // no temporary IPosition (which allocates for more than 4 axes)
+  // is needed.
+  class AxisFlags
+  {
+  public:
+    explicit AxisFlags (size_t nrdim)
+      : flags_p (buffer_p)
+    {
+      if (nrdim > BufferLength) {
+        heap_p.reset (new bool[nrdim]);
+        flags_p = heap_p.get();
+      }
+      std::fill_n (flags_p, nrdim, false);
+    }
+    bool& operator[] (size_t axis)
+      { return flags_p[axis]; }
+    // Set the flags of the given axes. An exception is thrown if an axis
+    // is invalid or (if unique is true) given more than once.
+    void mark (size_t nrdim, const IPosition& axes, bool unique)
+    {
+      for (size_t i=0; i<axes.nelements(); ++i) {
+        ssize_t axis = axes[i];
+        if (axis < 0  ||  axis >= ssize_t(nrdim)  ||
+            (unique  &&  flags_p[axis])) {
+          throw (std::runtime_error ("IPosition::makeAxisPath: "
+                                     "invalid defined axes"));
+        }
+        flags_p[axis] = true;
+      }
+    }
+  private:
+    enum {BufferLength = 32};
+    bool buffer_p[BufferLength];
+    std::unique_ptr<bool[]> heap_p;
+    bool* flags_p;
+  };
+
+  // Remove the degenerate axes not flagged in keepAxes.
+  IPosition removeDegenerate (const IPosition& shape, AxisFlags& keepAxes)
+  {
+    size_t count = 0;
+    for (size_t i=0; i<shape.nelements(); ++i) {
+      if (keepAxes[i]  ||  shape[i] != 1) {
+        keepAxes[i] = true;
+        count++;
+      }
+    }
+    if (count == shape.nelements()) return shape;
+    IPosition nondegenerateIP(count==0 ? 1 : count, 1);
+    count = 0;
+    for (size_t i=0; i<shape.nelements(); ++i) {
+      if (keepAxes[i]) {
+        nondegenerateIP[count++] = shape[i];
+      }
+    }
+    return nondegenerateIP;
+  }
+}
+
 IPosition::IPosition (size_t length)
 : size_p (length),
   data_p (buffer_p)
@@ -187,48 +250,23 @@ IPosition IPosition::nonDegenerate (size_t startingAxis) const
     if (startingAxis >= size_p) {
         return *this;
     }
-    IPosition ignoreAxes(startingAxis);
+    AxisFlags keepAxes(size_p);
     for (size_t i=0; i<startingAxis; i++) {
-	ignoreAxes(i) = i;
+	keepAxes[i] = true;
     }
-    return nonDegenerate (ignoreAxes);
+    return removeDegenerate (*this, keepAxes);
 }
 IPosition IPosition::nonDegenerate (const IPosition& ignoreAxes) const
 {
     assert(ok());
     // First determine which axes have to be ignored, thus always be kept.
-    // Do not count here, because in theory ignoreAxes can contain the
-    // same axis more than once.
-    // To remove degenerate axes use two passes - first find out how many axes
-    // have to be kept.
-    size_t i;
-    IPosition keepAxes(size_p, 0);
-    for (i=0; i<ignoreAxes.nelements(); i++) {
+    // In theory ignoreAxes can contain the same axis more than once.
+    AxisFlags keepAxes(size_p);
+    for (size_t i=0; i<ignoreAxes.nelements(); i++) {
       if(ignoreAxes(i) >= ssize_t(size_p)) throw std::runtime_error("ignoreAxes(i) >= ssize_t(size_p)");
-      keepAxes(ignoreAxes(i)) = 1;
-    }
-    // Now count all axes to keep.
-    size_t count=0;
-    for (i=0; i<size_p; i++) {
-	if (keepAxes(i) == 1) {
-	    count++;
-	}else{
-	    if (data_p[i] != 1) {
-		keepAxes(i) = 1;
-		count++;
-	    }
-	}
-    }
-    if (count == size_p) return *this;
-    if (count == 0) count = 1;
-    IPosition nondegenerateIP(count,1);
-    count = 0;
-    for (i=0; i<size_p; i++) {
-	if (keepAxes(i)) {
-	    nondegenerateIP(count++) = data_p[i];    
-	}
+      keepAxes[ignoreAxes(i)] = true;
     }
-    return nondegenerateIP;
+    return removeDegenerate (*this, keepAxes);
 }
 
 void IPosition::resize (size_t newSize, bool copy)
@@ -368,16 +406,19 @@ IPosition IPosition::removeAxes (const IPosition& axes) const
 {
   // Get the axes to keep.
   // It also checks if axes are specified correctly.
-  IPosition resAxes = IPosition::otherAxes (size_p, axes);
-  size_t ndimRes = resAxes.nelements();
+  if (size_p < axes.nelements()) throw std::runtime_error("nrdim<axes.nelements()");
+  AxisFlags removed(size_p);
+  removed.mark (size_p, axes, true);
+  size_t ndimRes = size_p - axes.nelements();
   // Create the result shape.
-  IPosition resShape(ndimRes);
   if (ndimRes == 0) {
-    resShape.resize(1);
-    resShape[0] = 1;
-  } else {
-    for (size_t i=0; i<ndimRes; ++i) {
-      resShape[i] = data_p[resAxes[i]];
+    return IPosition(1, 1);
+  }
+  IPosition resShape(ndimRes);
+  size_t j = 0;
+  for (size_t i=0; i<size_p; ++i) {
+    if (!removed[i]) {
+      resShape[j++] = data_p[i];
     }
   }
   return resShape;
@@ -385,7 +426,21 @@ IPosition IPosition::removeAxes (const IPosition& axes) const
 
 IPosition IPosition::keepAxes (const IPosition& axes) const
 {
-  return removeAxes (otherAxes(size_p, axes));
+  // The axes are kept in their natural order.
+  if (size_p < axes.nelements()) throw std::runtime_error("nrdim<axes.nelements()");
+  AxisFlags kept(size_p);
+  kept.mark (size_p, axes, true);
+  if (axes.nelements() == 0) {
+    return IPosition(1, 1);
+  }
+  IPosition resShape(axes.nelements());
+  size_t j = 0;
+  for (size_t i=0; i<size_p; ++i) {
+    if (kept[i]) {
+      resShape[j++] = data_p[i];
+    }
+  }
+  return resShape;
 }
 
 // <thrown>
@@ -1181,20 +1236,19 @@ bool isInsideArray (const IPosition& iposition, const IPosition& shape)
 IPosition IPosition::makeAxisPath (size_t nrdim, const IPosition& partialPath)
 {
     // Check if the specified traversal axes are correct and unique.
-    if (partialPath.nelements() > nrdim)  std::runtime_error("partialPath.nelements() > nrdim");
+    if (partialPath.nelements() > nrdim) {
+        throw std::runtime_error("partialPath.nelements() > nrdim");
+    }
+    AxisFlags done(nrdim);
+    done.mark (nrdim, partialPath, true);
     IPosition path(nrdim);
-    IPosition done(nrdim, 0);
-    size_t i,j;
+    size_t i;
     for (i=0; i<partialPath.nelements(); i++) {
         path(i) = partialPath(i);
-        if (path(i) >= int(nrdim)  ||  done(path(i)) != 0) {
-            throw (std::runtime_error ("IPosition::makeAxisPath: invalid defined axes"));
-        }
-        done(path(i)) = 1;
     }
     // Fill unspecified axes with the natural order.
-    for (j=0; j<nrdim; j++) {
-        if (done(j) == 0) {
+    for (size_t j=0; j<nrdim; j++) {
+        if (!done[j]) {
             path(i++) = j;
         }
     }
@@ -1204,7 +1258,16 @@ IPosition IPosition::makeAxisPath (size_t nrdim, const IPosition& partialPath)
 IPosition IPosition::otherAxes (size_t nrdim, const IPosition& axes)
 {
    if (nrdim<axes.nelements()) throw std::runtime_error("nrdim<axes.nelements()");
-   return makeAxisPath(nrdim, axes).getLast(nrdim-axes.nelements());
+   AxisFlags done(nrdim);
+   done.mark (nrdim, axes, true);
+   IPosition other(nrdim - axes.nelements());
+   size_t i = 0;
+   for (size_t j=0; j<nrdim; j++) {
+       if (!done[j]) {
+           other(i++) = j;
+       }
+   }
+   return other;
 }
 
 void IPosition::throwIndexError() const
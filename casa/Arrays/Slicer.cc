@@ -202,10 +202,10 @@ IPosition Slicer::inferShapeFromSource (const IPosition& shp,
     end.resize (start_p.nelements());
     stride.resize (start_p.nelements());
     start  = 0;
-    end    = shp - 1;
     stride = stride_p;
     IPosition res(start_p.nelements(), 0);
     for (size_t i=0; i<start_p.nelements(); i++) {
+        end(i) = shp(i) - 1;
 	//# Fill and check start value; unspecified means 0.
 	if (start_p(i) != MimicSource) {
             start(i) = start_p(i);
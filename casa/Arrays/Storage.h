@@ -1,8 +1,11 @@
 #ifndef CASACORE_STORAGE_2_H
 #define CASACORE_STORAGE_2_H
 
+#include "ArrayMemoryPool.h"
+
 #include <cstring>
 #include <memory>
+#include <new>
   
 namespace casacore {
 
@@ -18,6 +21,7 @@ class Storage
 public:
   // Construct an empty Storage
   Storage() :
+    _isCached(ArrayMemoryPool::caching()),
     _data(nullptr),
     _end(nullptr),
     _isShared(false)
@@ -26,6 +30,7 @@ public:
   // Construct Storage with a given size.
   // The elements will be default constructed
   Storage(std::size_t n) :
+    _isCached(ArrayMemoryPool::caching()),
     _data(construct(n)),
     _end(_data + n),
     _isShared(false)
@@ -34,6 +39,7 @@ public:
   // Construct Storage with a given size.
   // The elements will be copy constructed from the given value
   Storage(std::size_t n, const T& val) :
+    _isCached(ArrayMemoryPool::caching()),
     _data(construct(n, val)),
     _end(_data + n),
     _isShared(false)
@@ -85,7 +91,7 @@ public:
     if(n == 0)
       newStorage->_data = nullptr;
     else
-      newStorage->_data = std::allocator<T>().allocate(n);
+      newStorage->_data = allocate(n, newStorage->_isCached);
     newStorage->_end = newStorage->_data + n;
     return newStorage;
   }
@@ -97,7 +103,7 @@ public:
     {
       for(size_t i=0; i!=size(); ++i)
         _data[size()-i-1].~T();
-      std::allocator<T>().deallocate(_data, size());
+      deallocate(_data, size(), _isCached);
     }
   }
     
@@ -114,6 +120,24 @@ public:
   // Returns @c true when this Storage was constructed with MakeFromSharedData().
   bool is_shared() const { return _isShared; }
   
+  // Allocate and free the memory. It is taken from the ArrayMemoryPool,
+  // so it is aligned and, if @c cache is true, freed memory is cached for
+  // reuse. The same value of @c cache has to be used for both.
+  // @{
+  static T* allocate(size_t n, bool cache)
+  {
+    static_assert(alignof(T) <= ArrayMemoryPool::alignment, "Type is overaligned");
+    if(n > size_t(-1) / sizeof(T))
+      throw std::bad_alloc();
+    return static_cast<T*>(ArrayMemoryPool::allocate(n * sizeof(T), cache));
+  }
+
+  static void deallocate(T* data, size_t n, bool cache)
+  {
+    ArrayMemoryPool::deallocate(data, n * sizeof(T), cache);
+  }
+  // @}
+
   Storage(const Storage<T>&) = delete;
   Storage(Storage<T>&&) = delete;
   Storage& operator=(const Storage&) = delete;
@@ -122,6 +146,7 @@ public:
 private:
   // Moving range constructor implementation. Parameter integral is only a place-holder.
   Storage(T* startIter, T* endIter, std::false_type /*integral*/, std::true_type /*move*/) :
+    _isCached(ArrayMemoryPool::caching()),
     _data(construct_move(startIter, endIter)),
     _end(_data + (endIter-startIter)),
     _isShared(false) 
@@ -130,6 +155,7 @@ private:
   // Copying range constructor implementation for non-integral types
   template<typename InputIterator>
   Storage(InputIterator startIter, InputIterator endIter, std::false_type /*integral*/) :
+    _isCached(ArrayMemoryPool::caching()),
     _data(construct_range(startIter, endIter)),
     _end(_data + std::distance(startIter, endIter)),
     _isShared(false)
@@ -138,6 +164,7 @@ private:
   // Copying range constructor implementation for integral types
   template<typename Integral>
   Storage(Integral n, Integral val, std::true_type /*integral*/) :
+    _isCached(ArrayMemoryPool::caching()),
     _data(construct(n, val)),
     _end(_data + n),
     _isShared(false)
@@ -153,7 +180,7 @@ private:
     if(n == 0)
       return nullptr;
     else {
-      T* data = std::allocator<T>().allocate(n);
+      T* data = allocate(n, _isCached);
       T* current = data;
        try {
         for (; current != data+n; ++current) {
@@ -165,7 +192,7 @@ private:
           --current;
           current->~T();
         }
-        std::allocator<T>().deallocate(data, n);
+        deallocate(data, n, _isCached);
         throw;
       }
       return data;
@@ -177,7 +204,7 @@ private:
     if(n == 0)
       return nullptr;
     else {
-      T* data = std::allocator<T>().allocate(n);
+      T* data = allocate(n, _isCached);
       T* current = data;
       try {
         for (; current != data+n; ++current) {
@@ -189,7 +216,7 @@ private:
           --current;
           current->~T();
         }
-        std::allocator<T>().deallocate(data, n);
+        deallocate(data, n, _isCached);
         throw;
       }
       return data;
@@ -203,7 +230,7 @@ private:
       return nullptr;
     else {
       size_t n = std::distance(startIter, endIter);
-      T* data = std::allocator<T>().allocate(n);
+      T* data = allocate(n, _isCached);
       T* current = data;
       try {
         for (; current != data+n; ++current) {
@@ -216,7 +243,7 @@ private:
           --current;
           current->~T();
         }
-        std::allocator<T>().deallocate(data, n);
+        deallocate(data, n, _isCached);
         throw;
       }
       return data;
@@ -229,7 +256,7 @@ private:
       return nullptr;
     else {
       size_t n = endIter - startIter;
-      T* data = std::allocator<T>().allocate(n);
+      T* data = allocate(n, _isCached);
       T* current = data;
       try {
         for (; current != data+n; ++current) {
@@ -242,7 +269,7 @@ private:
           --current;
           current->~T();
         }
-        std::allocator<T>().deallocate(data, n);
+        deallocate(data, n, _isCached);
         throw;
       }
       return data;
@@ -265,6 +292,9 @@ private:
     struct conjunction<B1, Bn...> 
     : std::conditional<bool(B1::value), conjunction<Bn...>, B1>::type {};
 
+  // Whether the memory can be cached by the ArrayMemoryPool; it is set at
+  // construction, so it does not change if caching is switched meanwhile.
+  bool _isCached;
   T* _data;
   T* _end;
   bool _isShared;
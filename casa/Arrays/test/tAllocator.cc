@@ -1,5 +1,7 @@
 #include "../IPosition.h"
 #include "../Array.h"
+#include "../ArrayLogical.h"
+#include "../ArrayMemoryPool.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -174,4 +176,125 @@ BOOST_AUTO_TEST_CASE(array_uninitialized)
   BOOST_CHECK(allEQ(b, 3));
 }
 
+BOOST_AUTO_TEST_CASE(memory_pool_sizes)
+{
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(0), 0);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(1), 64);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(64), 64);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(65), 80);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(128), 128);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(129), 160);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(1000), 1024);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(1025), 1280);
+  // Large blocks are not rounded.
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::roundedSize(100000001), 100000001);
+  for (size_t n=1; n<100000; n = n*3/2 + 1) {
+    void* ptr = ArrayMemoryPool::allocate(n, true);
+    BOOST_CHECK_EQUAL(size_t(ptr) % ArrayMemoryPool::alignment, 0);
+    BOOST_CHECK_GE(ArrayMemoryPool::roundedSize(n), n);
+    BOOST_CHECK_LE(ArrayMemoryPool::roundedSize(n), 2*n + 64);
+    ArrayMemoryPool::deallocate(ptr, n, false);
+    ptr = ArrayMemoryPool::allocate(n, false);
+    BOOST_CHECK_EQUAL(size_t(ptr) % ArrayMemoryPool::alignment, 0);
+    ArrayMemoryPool::deallocate(ptr, n, false);
+  }
+  BOOST_CHECK(ArrayMemoryPool::allocate(0, true) == nullptr);
+  BOOST_CHECK(ArrayMemoryPool::allocate(0, false) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(memory_pool_cache)
+{
+  ArrayMemoryPool::releaseCache();
+  void* p1 = ArrayMemoryPool::allocate(1000, true);
+  ArrayMemoryPool::deallocate(p1, 1000, true);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 1024);
+  // A block of the same size class is taken from the cache.
+  void* p2 = ArrayMemoryPool::allocate(990, true);
+  BOOST_CHECK_EQUAL(p1, p2);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 0);
+  ArrayMemoryPool::deallocate(p2, 990, true);
+  // Not for another size class.
+  void* p3 = ArrayMemoryPool::allocate(2000, true);
+  BOOST_CHECK_NE(p1, p3);
+  ArrayMemoryPool::deallocate(p3, 2000, true);
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 1024+2048);
+  ArrayMemoryPool::releaseCache();
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(array_pooled_storage)
+{
+  IPosition shape{10, 12};
+  ArrayMemoryPool::releaseCache();
+  BOOST_CHECK(!ArrayMemoryPool::caching());
+  {
+    Array<double> a(shape, 1.);
+    BOOST_CHECK_EQUAL(size_t(a.data()) % ArrayMemoryPool::alignment, 0);
+  }
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 0);
+  ArrayMemoryPool::setCaching(true);
+  const double* ptr;
+  {
+    Array<double> a(shape, 1.);
+    ptr = a.data();
+  }
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 1024);
+  {
+    // Storage of an array of the same size is reused.
+    Array<double> a(shape, 2.);
+    BOOST_CHECK_EQUAL(a.data(), ptr);
+    BOOST_CHECK(allEQ(a, 2.));
+    // Also for copies made by getStorage.
+    bool deleteIt;
+    Array<double> b(a(IPosition{0, 0}, IPosition{8, 11}));
+    const double* bptr = b.getStorage(deleteIt);
+    BOOST_CHECK(deleteIt);
+    BOOST_CHECK_EQUAL(size_t(bptr) % ArrayMemoryPool::alignment, 0);
+    BOOST_CHECK_EQUAL(bptr[0], 2.);
+    b.freeStorage(bptr, deleteIt);
+  }
+  ArrayMemoryPool::setCaching(false);
+  ArrayMemoryPool::releaseCache();
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(array_pooled_storage_switch)
+{
+  // Storage allocated while caching is off is not rounded, so it must
+  // not be cached if caching is switched on before it is freed.
+  IPosition shape{10, 12};
+  ArrayMemoryPool::releaseCache();
+  {
+    Array<double> a(shape, 1.);
+    ArrayMemoryPool::setCaching(true);
+  }
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 0);
+  {
+    Array<double> a(shape, 1.);
+    ArrayMemoryPool::setCaching(false);
+  }
+  BOOST_CHECK_EQUAL(ArrayMemoryPool::cachedBytes(), 1024);
+  ArrayMemoryPool::releaseCache();
+}
+
+BOOST_AUTO_TEST_CASE(array_take_over)
+{
+  IPosition shape{4, 5};
+  // Storage from getStorage can be taken over.
+  Array<int> a(shape);
+  int v = 0;
+  for (int& x : a) x = v++;
+  Array<int> b(a(IPosition{0, 0}, IPosition{3, 4}, IPosition{2, 2}));
+  bool deleteIt;
+  const int* bptr = b.getStorage(deleteIt);
+  BOOST_CHECK(deleteIt);
+  Array<int> c(b.shape(), const_cast<int*>(bptr), TAKE_OVER);
+  BOOST_CHECK(allEQ(c, b));
+  // And storage from malloc (as used by DefaultAllocator).
+  int* ptr = static_cast<int*>(malloc(shape.product() * sizeof(int)));
+  std::fill(ptr, ptr + shape.product(), 7);
+  Array<int> d(shape, ptr, TAKE_OVER);
+  BOOST_CHECK(allEQ(d, 7));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
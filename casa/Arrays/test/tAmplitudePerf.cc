@@ -0,0 +1,100 @@
+//# tAmplitudePerf.cc: Time the amplitude of complex Arrays
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slice.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/sstream.h>
+#include <casacore/casa/iostream.h>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+
+#include <casacore/casa/namespace.h>
+// This program times amplitude() of contiguous and strided complex Arrays
+// and compares it with applying std::abs to each element (as done before).
+// It checks that the results are the same for Complex and differ at most
+// 1 ulp for DComplex.
+// Run it as:  tAmplitudePerf [nr]
+
+template<typename T>
+void timeAmplitude (const String& name, const Vector<std::complex<T>>& data)
+{
+  size_t nr = data.size();
+  cout << name << endl;
+  Vector<T> ref(nr), res(nr);
+  Timer timer;
+  arrayTransform (data, ref, [](std::complex<T> v) { return std::abs(v); });
+  timer.show ("  std::abs  ");
+  timer.mark();
+  amplitude (res, data);
+  timer.show ("  amplitude ");
+  size_t ndiff = 0;
+  for (size_t i=0; i<nr; ++i) {
+    if (res[i] != ref[i]) {
+      AlwaysAssertExit (res[i] == std::nextafter(ref[i], T(0))  ||
+                        res[i] == std::nextafter(ref[i], std::numeric_limits<T>::max()));
+      ndiff++;
+    }
+  }
+  if (sizeof(T) == sizeof(float)) {
+    AlwaysAssertExit (ndiff == 0);
+  }
+  cout << "  " << ndiff << " of " << nr << " values differ 1 ulp" << endl;
+}
+
+template<typename T>
+void doType (const String& name, size_t nr)
+{
+  Vector<std::complex<T>> all(2*nr);
+  for (size_t i=0; i<2*nr; ++i) {
+    all[i] = std::complex<T>(T(rand()) / RAND_MAX - 0.5,
+                             T(rand()) / RAND_MAX - 0.5);
+  }
+  Vector<std::complex<T>> cont(all(Slice(0, nr)));
+  timeAmplitude (name + " contiguous", cont);
+  Vector<std::complex<T>> strided(all(Slice(0, nr, 2)));
+  timeAmplitude (name + " strided", strided);
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    size_t nr = 10000000;
+    if (argc > 1) {
+      istringstream istr(argv[1]);
+      istr >> nr;
+    }
+    doType<float> ("Complex", nr);
+    doType<double> ("DComplex", nr);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
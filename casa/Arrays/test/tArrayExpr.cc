@@ -0,0 +1,144 @@
+//# tArrayExpr.cc: This program tests the lazy Array expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../Array.h"
+#include "../ArrayExpr.h"
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../ArrayError.h"
+#include "../Cube.h"
+#include "../Slicer.h"
+#include "../Vector.h"
+
+#include <complex>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+
+BOOST_AUTO_TEST_SUITE(array_expr)
+
+BOOST_AUTO_TEST_CASE(contiguous)
+{
+  IPosition shape(3,4,5,6);
+  Array<double> a(shape), b(shape), c(shape), w(shape);
+  indgen (a, -50.);
+  indgen (b, 1., 0.5);
+  indgen (c, 3., -2.);
+  w = 0.25;
+  Array<double> exp = abs(a*b + c) * w;
+  // Assignment to a new and an existing array.
+  Array<double> res1 = abs(arrayExpr(a)*b + c) * w;
+  BOOST_CHECK (allNear (res1, exp, 1e-13));
+  Array<double> res2(shape);
+  res2 = abs(arrayExpr(a)*b + c) * w;
+  BOOST_CHECK (allNear (res2, exp, 1e-13));
+  // Evaluation in place without a temporary.
+  Array<double> res3;
+  evaluateArrayExpr (res3, abs(arrayExpr(a)*b + c) * w);
+  BOOST_CHECK (allNear (res3, exp, 1e-13));
+  // Scalars on either side.
+  res3 = 2. - arrayExpr(a) / 4. + 1.;
+  BOOST_CHECK (allNear (res3, Array<double>(2. - a/4. + 1.), 1e-13));
+  // Functions of two expressions.
+  res3 = max(arrayExpr(a), arrayExpr(c)) + pow(arrayExpr(b), 2.);
+  BOOST_CHECK (allNear (res3, Array<double>(max(a,c) + pow(b,2.)), 1e-13));
+  res3 = -sqrt(square(arrayExpr(a)));
+  BOOST_CHECK (allNear (res3, Array<double>(-abs(a)), 1e-13));
+  // The result can also be an operand.
+  res3 = a;
+  evaluateArrayExpr (res3, arrayExpr(res3) * 2. + b);
+  BOOST_CHECK (allNear (res3, Array<double>(a*2. + b), 1e-13));
+}
+
+BOOST_AUTO_TEST_CASE(non_contiguous)
+{
+  IPosition shape(3,10,11,12);
+  Cube<float> a(shape), b(shape);
+  indgen (a, -100.f);
+  indgen (b, 2.f);
+  Slicer slicer(IPosition(3,1,2,3), IPosition(3,7,8,9), IPosition(3,2),
+                Slicer::endIsLast);
+  Array<float> asl (a(slicer));
+  Array<float> bsl (b(slicer));
+  Array<float> exp = asl*bsl - 3.f;
+  // Non-contiguous operands with a contiguous and non-contiguous result.
+  Array<float> res1 = arrayExpr(asl)*bsl - 3.f;
+  BOOST_CHECK (allNear (res1, exp, 1e-6));
+  Cube<float> res2(shape, 0.f);
+  Array<float> res2sl (res2(slicer));
+  evaluateArrayExpr (res2sl, arrayExpr(asl)*bsl - 3.f);
+  BOOST_CHECK (allNear (res2sl, exp, 1e-6));
+  res2sl = 0.f;
+  BOOST_CHECK (allEQ (res2, 0.f));
+  // Mix of contiguous and non-contiguous operands.
+  Array<float> c(asl.shape());
+  indgen (c);
+  res2sl = arrayExpr(c) + asl;
+  BOOST_CHECK (allNear (res2sl, Array<float>(c + asl), 1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(complex_values)
+{
+  IPosition shape(2,7,9);
+  Array<std::complex<float>> a(shape), b(shape);
+  Array<float> w(shape);
+  indgen (a, std::complex<float>(1.f, -2.f));
+  indgen (b, std::complex<float>(-3.f, 0.5f));
+  indgen (w, 0.5f);
+  // Mixed value types (complex and real) in one expression.
+  Array<float> res = amplitude(arrayExpr(a) * conj(arrayExpr(b))) * w;
+  BOOST_CHECK (allNear (res, Array<float>(amplitude(a*conj(b)) * w), 1e-5));
+  Array<float> ph = phase(arrayExpr(a));
+  BOOST_CHECK (allNear (ph, phase(a), 1e-6));
+  Array<float> re = real(arrayExpr(a) + b);
+  BOOST_CHECK (allNear (re, real(a + b), 1e-6));
+  std::complex<float> one(1.f, 0.f);
+  Array<std::complex<float>> cres = arrayExpr(a) * b - one;
+  BOOST_CHECK (allNear (cres, Array<std::complex<float>>(a*b - one), 1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(vectors)
+{
+  Vector<int> a(10), b(10);
+  indgen (a);
+  indgen (b, 5);
+  Vector<int> res(arrayExpr(a) * 3 - b);
+  BOOST_CHECK (allEQ (res, Vector<int>(a*3 - b)));
+  res = arrayExpr(a) + 1;
+  BOOST_CHECK (allEQ (res, Vector<int>(a + 1)));
+}
+
+BOOST_AUTO_TEST_CASE(nonconforming)
+{
+  Array<double> a(IPosition(2,3,4)), b(IPosition(2,4,3));
+  BOOST_CHECK_THROW (arrayExpr(a) + b, ArrayConformanceError);
+  Array<double> res(IPosition(2,2,2));
+  BOOST_CHECK_THROW (evaluateArrayExpr (res, arrayExpr(a) * 2.),
+                     ArrayConformanceError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,12 +25,17 @@
 
 //# Includes
 #include "../Cube.h"
+#include "../Slice.h"
+#include "../Vector.h"
 #include "../ArrayMath.h"
 #include "../ArrayLogical.h"
 //#include "../ArrayIO.h"
 #include "../ElementFunctions.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -734,4 +739,115 @@ BOOST_AUTO_TEST_CASE( convert_array )
   BOOST_CHECK_EQUAL_COLLECTIONS(b.begin(), b.end(), ref.begin(), ref.end());
 }
 
+// Check median, madfm and fractile of a large array (which are selected
+// in parallel if possible) against a serial selection.
+template<typename T>
+void checkLargeSelect (const Vector<T>& vec)
+{
+  size_t n = vec.size();
+  Vector<T> orig(vec.copy());
+  std::vector<T> v(vec.begin(), vec.end());
+  size_t n2 = (n-1)/2;
+  std::nth_element (v.begin(), v.begin()+n2, v.end());
+  T med = v[n2];
+  std::nth_element (v.begin(), v.begin()+n2+1, v.end());
+  T medEven = T(0.5 * (med + v[n2+1]));
+  BOOST_CHECK_EQUAL (median(vec, false, false, false), med);
+  BOOST_CHECK_EQUAL (median(vec, false, true, false),
+                     n%2 == 0 ? medEven : med);
+  std::vector<T> dev(vec.begin(), vec.end());
+  for (size_t i=0; i<n; ++i) {
+    dev[i] = std::abs(dev[i] - med);
+  }
+  std::nth_element (dev.begin(), dev.begin()+n2, dev.end());
+  BOOST_CHECK_EQUAL (madfm(vec, false, false, false), dev[n2]);
+  size_t nf = size_t((n-1) * double(0.1f) + 0.01);
+  std::nth_element (v.begin(), v.begin()+nf, v.end());
+  T fr1 = v[nf];
+  BOOST_CHECK_EQUAL (fractile(vec, 0.1f), fr1);
+  nf = size_t((n-1) * double(0.9f) + 0.01);
+  std::nth_element (v.begin(), v.begin()+nf, v.end());
+  BOOST_CHECK_EQUAL (interFractileRange(vec, 0.1f), T(v[nf] - fr1));
+  // The input must not be changed if not in place.
+  BOOST_CHECK (std::equal (vec.begin(), vec.end(), orig.begin()));
+  // Also on a non-contiguous array.
+  Vector<T> sub (vec(Slice(0, n/2, 2)));
+  std::vector<T> vs(sub.begin(), sub.end());
+  n2 = (vs.size()-1)/2;
+  std::nth_element (vs.begin(), vs.begin()+n2, vs.end());
+  BOOST_CHECK_EQUAL (median(sub, false, false, false), vs[n2]);
+}
+
+BOOST_AUTO_TEST_CASE( large_select )
+{
+  // Many duplicates and an even number of elements.
+  Vector<double> vd(2000000);
+  for (size_t i=0; i<vd.size(); ++i) {
+    vd[i] = double((i * 7919) % 1000) * 0.25 - 20;
+  }
+  checkLargeSelect (vd);
+  // Wide range of values and an odd number of elements.
+  Vector<float> vf(1500001);
+  for (size_t i=0; i<vf.size(); ++i) {
+    vf[i] = float(std::pow(1.0001, double((i * 104729) % 300000)) *
+                  (i%3 == 0 ? -1 : 1));
+  }
+  checkLargeSelect (vf);
+  Vector<int> vi(1200000);
+  for (size_t i=0; i<vi.size(); ++i) {
+    vi[i] = int((i * 2654435761u) % 4000000) - 1000000;
+  }
+  checkLargeSelect (vi);
+  // All equal.
+  checkLargeSelect (Vector<int>(1100000, 3));
+  // In place selection gives the same result.
+  Vector<double> vd2(vd.copy());
+  BOOST_CHECK_EQUAL (medianInPlace(vd2), median(vd));
+}
+
+template<typename T>
+void checkAmplitudeSpecial()
+{
+  // Values for which the squares overflow or underflow, and Inf and NaN.
+  const T inf = std::numeric_limits<T>::infinity();
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const T big = std::numeric_limits<T>::max() / 4;
+  const T tiny = std::numeric_limits<T>::denorm_min();
+  std::vector<std::complex<T>> vals {
+    {0,0}, {-0.,0}, {3,-4}, {big,big}, {-big,1}, {tiny,tiny}, {tiny,0},
+    {inf,nan}, {nan,-inf}, {nan,1}, {inf,1}, {1e-20,3e-21}};
+  Vector<std::complex<T>> a(vals);
+  // Use a strided section as well.
+  Vector<std::complex<T>> b(2*vals.size(), std::complex<T>(1,1));
+  Vector<std::complex<T>> bs(b(Slice(1, vals.size(), 2)));
+  bs = a;
+  Vector<T> res(amplitude(a));
+  Vector<T> sres(amplitude(bs));
+  for (size_t i=0; i<vals.size(); ++i) {
+    T e = std::abs(vals[i]);
+    if (std::isnan(e)) {
+      BOOST_CHECK (std::isnan(res[i]));
+      BOOST_CHECK (std::isnan(sres[i]));
+    } else {
+      if (std::isinf(e)) {
+        BOOST_CHECK_EQUAL (res[i], e);
+      } else {
+        BOOST_CHECK_CLOSE (res[i], e, 1e-4);
+      }
+      BOOST_CHECK_EQUAL (res[i], sres[i]);
+    }
+  }
+  BOOST_CHECK_EQUAL (res[0], T(0));
+  BOOST_CHECK_EQUAL (res[2], T(5));
+  BOOST_CHECK_EQUAL (res[7], inf);
+  BOOST_CHECK_EQUAL (res[8], inf);
+  BOOST_CHECK (std::isnan(res[9]));
+}
+
+BOOST_AUTO_TEST_CASE( amplitude_special )
+{
+  checkAmplitudeSpecial<float>();
+  checkAmplitudeSpecial<double>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,8 @@
 #include "../ArrayLogical.h"
 #include "../ArrayStr.h"
 
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace casacore;
@@ -621,4 +623,52 @@ BOOST_AUTO_TEST_CASE(partial_quartile)
   BOOST_CHECK(doIt (&myPartialQuartiles, &myQuartile, true));
 }
 
+// Check the partial functions on an array large enough to be reduced by
+// multiple threads (if OpenMP is used) against the serial partialArrayMath.
+// The summation order is the same, so the results must be exactly equal.
+BOOST_AUTO_TEST_CASE(partial_large)
+{
+  IPosition shape(4, 4, 16, 32, 40);
+  Array<double> arr(shape);
+  double v = 0.1;
+  for (Array<double>::iterator iter=arr.begin(); iter!=arr.end(); ++iter) {
+    v = 4 * v * (1-v);       // chaotic sequence in ]0,1[
+    *iter = v * 1000;
+  }
+  std::vector<IPosition> axesList;
+  axesList.push_back (IPosition(1,0));
+  axesList.push_back (IPosition(1,1));
+  axesList.push_back (IPosition(1,3));
+  axesList.push_back (IPosition(2,0,1));
+  axesList.push_back (IPosition(2,1,3));
+  axesList.push_back (IPosition(3,1,2,3));
+  axesList.push_back (IPosition(3,0,1,2));
+  for (const IPosition& axes : axesList) {
+    BOOST_CHECK (allEQ (partialSums(arr, axes),
+                        partialArrayMath(arr, axes, SumFunc<double>())));
+    BOOST_CHECK (allEQ (partialSumSqrs(arr, axes),
+                        partialArrayMath(arr, axes, SumSqrFunc<double>())));
+    BOOST_CHECK (allEQ (partialMins(arr, axes),
+                        partialArrayMath(arr, axes, MinFunc<double>())));
+    BOOST_CHECK (allEQ (partialMaxs(arr, axes),
+                        partialArrayMath(arr, axes, MaxFunc<double>())));
+    BOOST_CHECK (allNear (partialVariances(arr, axes, 1),
+                          partialArrayMath(arr, axes,
+                                           VarianceFunc<double>(1)), 1e-10));
+    BOOST_CHECK (allNear (partialAvdevs(arr, axes),
+                          partialArrayMath(arr, axes, AvdevFunc<double>()),
+                          1e-10));
+    BOOST_CHECK (allEQ (partialMedians(arr, axes),
+                        partialArrayMath(arr, axes,
+                                         MedianFunc<double>(false, false))));
+    BOOST_CHECK (allEQ (partialFractiles(arr, axes, 0.3),
+                        partialArrayMath(arr, axes,
+                                         FractileFunc<double>(0.3))));
+  }
+  // In place medians must give the same result.
+  Array<double> cp = arr.copy();
+  BOOST_CHECK (allEQ (partialMedians(cp, IPosition(2,0,2), false, true),
+                      partialMedians(arr, IPosition(2,0,2))));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
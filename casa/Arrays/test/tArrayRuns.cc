@@ -0,0 +1,197 @@
+//# tArrayRuns.cc: This program tests stepping through Arrays in runs
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../Array.h"
+#include "../ArrayRuns.h"
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../Cube.h"
+#include "../Slicer.h"
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+
+namespace {
+  // Get the values of an array using the runs.
+  std::vector<int> runValues (const Array<int>& arr, size_t& nruns)
+  {
+    std::vector<int> vals;
+    nruns = 0;
+    arrayForEachRun (arr, [&](const int* p, ssize_t incr, size_t n)
+                     { for (size_t i=0; i<n; ++i, p+=incr) {
+                         vals.push_back (*p);
+                       }
+                       nruns++;
+                     });
+    return vals;
+  }
+
+  // Get the values of an array using its iterator.
+  std::vector<int> iterValues (const Array<int>& arr)
+  {
+    return std::vector<int> (arr.begin(), arr.end());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(array_runs)
+
+BOOST_AUTO_TEST_CASE(runs)
+{
+  Cube<int> cube(6,7,8);
+  indgen (cube);
+  size_t nruns;
+  // A contiguous array is a single run.
+  BOOST_CHECK (runValues (cube, nruns) == iterValues (cube));
+  BOOST_CHECK_EQUAL (nruns, 1u);
+  // Full first axes are combined.
+  Array<int> planes (cube(Slicer(IPosition(3,0,0,2), IPosition(3,6,7,3))));
+  BOOST_CHECK (runValues (planes, nruns) == iterValues (planes));
+  BOOST_CHECK_EQUAL (nruns, 1u);
+  Array<int> lines (cube(Slicer(IPosition(3,0,1,2), IPosition(3,6,4,3))));
+  BOOST_CHECK (runValues (lines, nruns) == iterValues (lines));
+  BOOST_CHECK_EQUAL (nruns, 3u);
+  // Strided sections. In the first one the stride of the first axis
+  // continues in the second axis.
+  Array<int> strided (cube(Slicer(IPosition(3,1,0,1), IPosition(3,3,7,4),
+                                  IPosition(3,2,1,2))));
+  BOOST_CHECK (runValues (strided, nruns) == iterValues (strided));
+  BOOST_CHECK_EQUAL (nruns, 4u);
+  Array<int> strided2 (cube(Slicer(IPosition(3,1,0,1), IPosition(3,2,7,4),
+                                   IPosition(3,2,1,2))));
+  BOOST_CHECK (runValues (strided2, nruns) == iterValues (strided2));
+  BOOST_CHECK_EQUAL (nruns, 7u*4u);
+  // Degenerate first axis (e.g. a row in a matrix).
+  Array<int> row (cube(Slicer(IPosition(3,2,0,0), IPosition(3,1,7,8))));
+  BOOST_CHECK (runValues (row, nruns) == iterValues (row));
+  BOOST_CHECK_EQUAL (nruns, 1u);
+  Array<int> rows (cube(Slicer(IPosition(3,2,0,0), IPosition(3,1,7,4),
+                               IPosition(3,1,1,2))));
+  BOOST_CHECK (runValues (rows, nruns) == iterValues (rows));
+  BOOST_CHECK_EQUAL (nruns, 4u);
+  // A single element and an empty array.
+  Array<int> single (cube(Slicer(IPosition(3,2,3,4), IPosition(3,1,1,1))));
+  BOOST_CHECK (runValues (single, nruns) == iterValues (single));
+  BOOST_CHECK_EQUAL (nruns, 1u);
+  Array<int> empty;
+  BOOST_CHECK (runValues (empty, nruns).empty());
+  BOOST_CHECK_EQUAL (nruns, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(two_arrays)
+{
+  // The runs of two arrays only combine the axes that are combinable
+  // in both.
+  Cube<int> a(6,7,8), b(6,7,8);
+  indgen (a);
+  indgen (b, 1000);
+  Array<int> asl (a(Slicer(IPosition(3,0,0,1), IPosition(3,6,3,4))));
+  Array<int> bsl (b(Slicer(IPosition(3,0,1,1), IPosition(3,6,3,4),
+                           IPosition(3,1,2,1))));
+  std::vector<int> av, bv;
+  size_t nruns = 0;
+  arrayForEachRun (asl, bsl, [&](const int* p1, ssize_t inc1,
+                                 const int* p2, ssize_t inc2, size_t n)
+                   { for (size_t i=0; i<n; ++i, p1+=inc1, p2+=inc2) {
+                       av.push_back (*p1);
+                       bv.push_back (*p2);
+                     }
+                     nruns++;
+                   });
+  BOOST_CHECK (av == iterValues (asl));
+  BOOST_CHECK (bv == iterValues (bsl));
+  BOOST_CHECK_EQUAL (nruns, 3u*4u);
+}
+
+BOOST_AUTO_TEST_CASE(sliced_operations)
+{
+  Cube<double> a(10,11,12), b(10,11,12);
+  indgen (a, -300.);
+  indgen (b, 2., 0.5);
+  Slicer slicer1(IPosition(3,1,2,3), IPosition(3,7,8,9), IPosition(3,2,1,2),
+                 Slicer::endIsLast);
+  Slicer slicer2(IPosition(3,0,1,0), IPosition(3,9,7,9), IPosition(3,3,1,3),
+                 Slicer::endIsLast);
+  Array<double> asl (a(slicer1));
+  Array<double> bsl (b(slicer2));
+  Array<double> acp (asl.copy());
+  Array<double> bcp (bsl.copy());
+  BOOST_CHECK (acp.contiguousStorage());
+  BOOST_CHECK (std::vector<double>(acp.begin(), acp.end()) ==
+               std::vector<double>(asl.begin(), asl.end()));
+  // Math on non-contiguous arrays gives the same results as on copies.
+  BOOST_CHECK (allEQ (Array<double>(asl + bsl), Array<double>(acp + bcp)));
+  BOOST_CHECK (allEQ (Array<double>(asl * 2.), Array<double>(acp * 2.)));
+  BOOST_CHECK (allEQ (Array<double>(3. - bsl), Array<double>(3. - bcp)));
+  BOOST_CHECK (allEQ (Array<double>(abs(asl)), Array<double>(abs(acp))));
+  BOOST_CHECK_EQUAL (sum(asl), sum(acp));
+  BOOST_CHECK_EQUAL (sumsqr(bsl), sumsqr(bcp));
+  BOOST_CHECK_EQUAL (variance(asl), variance(acp));
+  double mn, mx, mnc, mxc;
+  minMax (mn, mx, asl);
+  minMax (mnc, mxc, acp);
+  BOOST_CHECK_EQUAL (mn, mnc);
+  BOOST_CHECK_EQUAL (mx, mxc);
+  // Logical operations.
+  BOOST_CHECK (allEQ (asl, acp));
+  BOOST_CHECK (! anyNE (asl, acp));
+  BOOST_CHECK (allGE (asl, 51.));
+  BOOST_CHECK (anyGT (asl, 100.));
+  BOOST_CHECK (! allGT (asl, 51.));
+  BOOST_CHECK (! anyLT (asl, 51.));
+  BOOST_CHECK (allEQ (Array<bool>(asl > bsl), Array<bool>(acp > bcp)));
+  // In-place operations and assignment into a non-contiguous array.
+  Cube<double> c(10,11,12, 0.);
+  Array<double> csl (c(slicer1));
+  csl = bsl;
+  BOOST_CHECK (allEQ (csl, bcp));
+  csl += asl;
+  BOOST_CHECK (allEQ (csl, Array<double>(acp + bcp)));
+  csl *= 2.;
+  BOOST_CHECK (allEQ (csl, Array<double>((acp + bcp) * 2.)));
+  csl = 1.;
+  BOOST_CHECK_EQUAL (sum(c), double(csl.nelements()));
+  csl.apply ([](double v) { return v+1; });
+  BOOST_CHECK_EQUAL (sum(c), 2.*csl.nelements());
+  // The result of a transform can be non-contiguous as well.
+  arrayTransform (asl, bsl, csl, std::minus<double>());
+  BOOST_CHECK (allEQ (csl, Array<double>(acp - bcp)));
+  // Storage of a non-contiguous array.
+  bool deleteIt;
+  double* storage = csl.getStorage (deleteIt);
+  BOOST_CHECK (deleteIt);
+  for (size_t i=0; i<csl.nelements(); ++i) {
+    storage[i] = i;
+  }
+  csl.putStorage (storage, deleteIt);
+  Array<double> exp(csl.shape());
+  indgen (exp);
+  BOOST_CHECK (allEQ (csl, exp));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,10 +26,14 @@
 //#include "../ArrayIO.h"
 #include "../ArrayMath.h"
 #include "../ArrayError.h"
+#include "../ArrayPosIter.h"
 #include "../ArrayUtil.h"
 #include "../Matrix.h"
+#include "../MatrixMath.h"
 #include "../Vector.h"
 
+#include <algorithm>
+
 // <summary>
 // Test of functions in ArrayUtil.h.
 // </summary>
@@ -271,6 +275,48 @@ BOOST_AUTO_TEST_CASE( reorder_array_4d )
                   std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE( reorder_array_blocked )
+{
+  // Use axes longer than a block and a degenerate axis, and a
+  // non-contiguous input array.
+  IPosition shape(5,67,5,1,71,3);
+  Array<double> full(IPosition(5,70,5,1,71,4));
+  indgen(full);
+  Array<double> arr (full(IPosition(5,2,0,0,0,1), IPosition(5,68,4,0,70,3)));
+  BOOST_CHECK_EQUAL(arr.shape(), shape);
+  IPosition axisOrder(5,0,1,2,3,4);
+  do {
+    Array<double> res = reorderArray (arr, axisOrder);
+    IPosition posOld(5);
+    bool same = true;
+    for (ArrayPositionIterator iter(res.shape(), 0); !iter.pastEnd();
+         iter.next()) {
+      const IPosition& posNew = iter.pos();
+      for (int i=0; i<5; i++) {
+        posOld(axisOrder(i)) = posNew(i);
+      }
+      same = same && (arr(posOld) == res(posNew));
+    }
+    BOOST_CHECK_MESSAGE(same, "reorder " << axisOrder);
+  } while (std::next_permutation (axisOrder.begin(), axisOrder.end()));
+  // Transpose a matrix.
+  Matrix<int> mat(130, 67);
+  indgen(mat);
+  Matrix<int> matT = transpose(mat);
+  BOOST_CHECK_EQUAL(matT.shape(), IPosition(2,67,130));
+  bool same = true;
+  for (size_t j=0; j<mat.ncolumn(); j++) {
+    for (size_t i=0; i<mat.nrow(); i++) {
+      same = same && (mat(i,j) == matT(j,i));
+    }
+  }
+  BOOST_CHECK(same);
+  // An empty array.
+  Array<int> empty(IPosition(3,4,0,5));
+  BOOST_CHECK_EQUAL(reorderArray (empty, IPosition(3,2,0,1)).shape(),
+                    IPosition(3,5,4,0));
+}
+
 BOOST_AUTO_TEST_CASE( reverse_array )
 {
   IPosition shape(3, 2, 3, 4);
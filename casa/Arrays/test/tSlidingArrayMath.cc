@@ -29,6 +29,8 @@
 //#include "../ArrayIO.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <boost/test/unit_test.hpp>
 
@@ -138,4 +140,87 @@ BOOST_AUTO_TEST_CASE( masked )
         {5.0, 4.5, 5.5, 10.0, 12.0, 13.0, 17.0, 19.5, 20.5 });
 }
 
+// Functor hiding the actual functor, so slidingArrayMath uses brute force.
+template<typename T>
+class BruteForceFunc : public ArrayFunctorBase<T> {
+public:
+  explicit BruteForceFunc (const ArrayFunctorBase<T>& func)
+    : itsFunc(func) {}
+  virtual T operator() (const Array<T>& arr) const override
+    { return itsFunc(arr); }
+private:
+  const ArrayFunctorBase<T>& itsFunc;
+};
+
+template<typename T>
+void checkIncremental (const Array<T>& arr, const IPosition& halfBox,
+                       const ArrayFunctorBase<T>& func, double tol)
+{
+  Array<T> res = slidingArrayMath(arr, halfBox, func, true);
+  Array<T> exp = slidingArrayMath(arr, halfBox, BruteForceFunc<T>(func), true);
+  BOOST_REQUIRE (res.shape() == exp.shape());
+  typename Array<T>::const_iterator expIter = exp.begin();
+  for (typename Array<T>::const_iterator iter = res.begin();
+       iter != res.end(); ++iter, ++expIter) {
+    if (*iter != *expIter) {
+      // NaNs are equal; otherwise only rounding differences are allowed.
+      bool ok = (*iter != *iter  &&  *expIter != *expIter)  ||
+        std::abs(*iter - *expIter) <= tol * std::abs(*expIter);
+      BOOST_CHECK (ok);
+      if (!ok) return;
+    }
+  }
+}
+
+template<typename T>
+void checkAllIncremental (const Array<T>& arr, const IPosition& halfBox)
+{
+  checkIncremental (arr, halfBox, SumFunc<T>(), 1e-5);
+  checkIncremental (arr, halfBox, SumSqrFunc<T>(), 1e-5);
+  checkIncremental (arr, halfBox, MeanFunc<T>(), 1e-5);
+  checkIncremental (arr, halfBox, RmsFunc<T>(), 1e-5);
+  // The order statistics must be exact.
+  checkIncremental (arr, halfBox, MinFunc<T>(), 0);
+  checkIncremental (arr, halfBox, MaxFunc<T>(), 0);
+  checkIncremental (arr, halfBox, MedianFunc<T>(false, false), 0);
+  checkIncremental (arr, halfBox, MedianFunc<T>(false, true), 0);
+  checkIncremental (arr, halfBox, MadfmFunc<T>(false, false), 0);
+  checkIncremental (arr, halfBox, MadfmFunc<T>(false, true), 0);
+  checkIncremental (arr, halfBox, FractileFunc<T>(0.3), 0);
+}
+
+BOOST_AUTO_TEST_CASE( incremental )
+{
+  // Values with many duplicates.
+  Array<float> arr(IPosition(3,40,30,3));
+  float v = 0.1;
+  for (Array<float>::iterator iter=arr.begin(); iter!=arr.end(); ++iter) {
+    v = 4 * v * (1-v);
+    *iter = int(v*50) - 20;
+  }
+  checkAllIncremental (arr, IPosition(1,0));
+  checkAllIncremental (arr, IPosition(1,3));
+  checkAllIncremental (arr, IPosition(2,2,1));
+  checkAllIncremental (arr, IPosition(2,0,2));
+  checkAllIncremental (arr, IPosition(3,1,2,1));
+  checkAllIncremental (arr, IPosition(2,19,2));
+  Array<int> iarr(arr.shape());
+  convertArray (iarr, arr);
+  checkAllIncremental (iarr, IPosition(2,3,1));
+  // Non-finite values make some lines use brute force.
+  arr(IPosition(3,10,5,1)) = std::numeric_limits<float>::quiet_NaN();
+  arr(IPosition(3,30,20,2)) = std::numeric_limits<float>::infinity();
+  checkAllIncremental (arr, IPosition(2,2,1));
+  // A non-contiguous array large enough to be done in parallel.
+  Array<double> big(IPosition(2,500,300));
+  for (Array<double>::iterator iter=big.begin(); iter!=big.end(); ++iter) {
+    v = 4 * v * (1-v);
+    *iter = v;
+  }
+  checkAllIncremental (big(IPosition(2,0,0), IPosition(2,499,299),
+                           IPosition(2,1,2)),
+                       IPosition(2,5,3));
+  checkAllIncremental (big, IPosition(1,25));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/Arrays/ArrayMemoryPool.h>
 
 #include <cstdlib>
 #include <memory>
@@ -205,6 +206,63 @@ inline bool operator!=(const new_del_allocator<T>&,
   return false;
 }
 
+// An allocator taking 64-byte aligned memory from the thread-local
+// ArrayMemoryPool. Freed memory is kept in the pool's cache of the thread.
+template<typename T>
+struct pooled_allocator: public std11_allocator<T> {
+  using Super = std11_allocator<T>;
+  using size_type = typename Super::size_type;
+  using difference_type = typename Super::difference_type;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using value_type = typename Super::value_type;
+
+  static constexpr size_t alignment = ArrayMemoryPool::alignment;
+
+  template<typename TOther>
+  struct rebind {
+    typedef pooled_allocator<TOther> other;
+  };
+  pooled_allocator() noexcept {
+  }
+
+  pooled_allocator(const pooled_allocator&other) noexcept
+  :Super(other) {
+  }
+
+  template<typename TOther>
+  pooled_allocator(const pooled_allocator<TOther>&) noexcept {
+  }
+
+  ~pooled_allocator() noexcept {
+  }
+
+  pointer allocate(size_type elements, const void* = 0) {
+    if (elements > std::allocator_traits<pooled_allocator>::max_size(*this)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>(ArrayMemoryPool::allocate(sizeof(T) * elements, true));
+  }
+
+  void deallocate(pointer ptr, size_type elements) {
+    ArrayMemoryPool::deallocate(ptr, sizeof(T) * elements, true);
+  }
+};
+
+template<typename T>
+inline bool operator==(const pooled_allocator<T>&,
+    const pooled_allocator<T>&) {
+  return true;
+}
+
+template<typename T>
+inline bool operator!=(const pooled_allocator<T>&,
+    const pooled_allocator<T>&) {
+  return false;
+}
+
 template<typename T> class Block;
 
 class Allocator_private {
@@ -398,6 +456,22 @@ protected:
 template<typename T>
 DefaultAllocator<T> DefaultAllocator<T>::value;
 
+// An allocator for short-lived storage that is allocated repeatedly,
+// possibly by many threads. It takes 64-byte aligned memory from a
+// thread-local pool of size classes, which avoids contention in the
+// system allocator. See class ArrayMemoryPool for details.
+template<typename T>
+class PooledAllocator: public BaseAllocator<T, PooledAllocator<T> > {
+public:
+  typedef pooled_allocator<T> type;
+  // an instance of this allocator.
+  static PooledAllocator<T> value;
+protected:
+  PooledAllocator(){}
+};
+template<typename T>
+PooledAllocator<T> PooledAllocator<T>::value;
+
 // <summary>Allocator specifier</summary>
 // <synopsis>
 // This class is just used to avoid ambiguity between overloaded functions.
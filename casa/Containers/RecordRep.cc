@@ -1228,7 +1228,7 @@ void RecordRep::getRecord (AipsIO& os, Int& recordType)
     // by Record. The code does not exist anymore, but theoretically such data
     // can exist in a very old table. Therefore it is still supported here.
     uInt version;
-    String type = os.getNextType();
+    const String& type = os.getNextType();
     if (type == "ScalarKeywordSet") {
 	version = os.getstart ("ScalarKeywordSet");
 	getKeySet (os, version, 0);
@@ -102,6 +102,13 @@ void doit()
       bi.resize(3);
       AlwaysAssertExit(0 == ((intptr_t)bi.storage()) % 32);
     }
+    for (i = 0; i < 200; i++) {
+      Block<Int> bi(i, AllocSpec<PooledAllocator<Int> >::value);
+      AlwaysAssertExit(bi.nelements() == i);
+      AlwaysAssertExit(0 == ((intptr_t)bi.storage()) % 64);
+      bi.resize(i+20);
+      AlwaysAssertExit(0 == ((intptr_t)bi.storage()) % 64);
+    }
     Block<Int> bi2(100);                   // Block::Block(uInt)
     AlwaysAssertExit(bi2.nelements() == 100);
     AlwaysAssertExit(bi2.size() == 100);
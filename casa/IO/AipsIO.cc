@@ -897,6 +897,17 @@ AipsIO& AipsIO::getnew (uInt& nrv, String*& var)
 }
 
 
+AipsIO& AipsIO::getinto (uInt& nrv, Block<uChar>& var)
+{
+    operator>> (nrv);
+    if (nrv > var.nelements()) {
+        var.resize (nrv, False, False);
+    }
+    get (nrv, var.storage());
+    return (*this);
+}
+
+
 // getNextType gets the object type of the next piece of
 // information to read. It can only be used if a file has been
 // opened and if no put is in operation.
@@ -396,6 +396,15 @@ public:
     AipsIO& getnew (uInt& nrval, String*& values);
     // </group>
 
+    // Read in values as written by the function put into the given buffer.
+    // Unlike getnew, the buffer is only enlarged if too small; it is
+    // never shrunk. In this way a single buffer can be reused when
+    // reading many objects in a row (e.g. the data manager headers in
+    // a table), which avoids an allocation per object.
+    // The number of values read is returned in nrval; the buffer can
+    // be larger than that.
+    AipsIO& getinto (uInt& nrval, Block<uChar>& values);
+
     // End reading an object. It returns the object length (including
     // possible nested objects).
     // It checks if the entire object has been read (to keep the data
@@ -94,7 +94,7 @@ AipsIO &operator>>(AipsIO &ios, Array<T> &a)
     // On 20-Nov-2000 use of the home-brew rtti was removed.
     // It meant that a name 'Array<int>' is now replaced by 'Array'.
     // In order to recognize those old names, we must do something special.
-    String type = ios.getNextType();
+    const String& type = ios.getNextType();
     int version;
     if (type.length() > 6  &&  type.index("Array<") == 0) {
       version = ios.getstart(type);
@@ -314,6 +314,10 @@ public:
     // (Re)initialize the cache statistics.
     void initStatistics();
 
+    // Get the number of buckets read from the file since the statistics
+    // were (re)initialized.
+    uInt nRead() const;
+
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
@@ -407,6 +411,9 @@ inline Int BucketCache::firstFreeBucket() const
 inline uInt BucketCache::nFreeBucket() const
     { return its_NrOfFree; }
 
+inline uInt BucketCache::nRead() const
+    { return nread_p; }
+
 
 
 
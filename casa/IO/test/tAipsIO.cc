@@ -52,6 +52,7 @@
 void doit (Bool doExcp);
 void doIO (Bool doExcp, Bool out, AipsIO&);
 void doTry (AipsIO&);
+void doGetInto();
 
 int main (int argc, const char*[])
 {
@@ -110,6 +111,41 @@ void doit (Bool doExcp)
     AipsIO io2(rawio);
     doIO (doExcp, False, io2);
   }
+  doGetInto();
+}
+
+// Test that getinto reuses the buffer as much as possible.
+void doGetInto()
+{
+  cout << endl << "Test getinto ..." << endl;
+  uChar vals[10];
+  for (uInt i=0; i<10; ++i) {
+    vals[i] = i;
+  }
+  auto membuf = std::make_shared<MemoryIO>();
+  {
+    AipsIO io(membuf);
+    io.putstart ("getinto", 1);
+    io.put (10, vals);
+    io.put (4, vals+6);
+    io.put (10, vals);
+    io.putend();
+  }
+  membuf->seek (0);
+  AipsIO io(membuf);
+  Block<uChar> buf;
+  uInt len;
+  io.getstart ("getinto");
+  io.getinto (len, buf);
+  cout << len << ' ' << buf.nelements() << ' ' << Int(buf[9]) << endl;
+  const uChar* ptr = buf.storage();
+  io.getinto (len, buf);
+  cout << len << ' ' << buf.nelements() << ' ' << Int(buf[0])
+       << ' ' << (ptr == buf.storage()) << endl;
+  io.getinto (len, buf);
+  cout << len << ' ' << buf.nelements() << ' ' << Int(buf[9])
+       << ' ' << (ptr == buf.storage()) << endl;
+  io.getend();
 }
 
 
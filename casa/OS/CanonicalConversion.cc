@@ -27,6 +27,12 @@
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <assert.h>
 #include <casacore/casa/iostream.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CASA_CANCONV_X86
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -124,8 +130,143 @@ Conversion::ByteFunction* CanonicalConversion::getByteFromLocal
 }
 
 
+//# The byte shuffle instructions (SSSE3 and AVX2) are not part of the
+//# x86_64 baseline, so they are compiled for their target only and used
+//# if the CPU supports them.
+#if defined(CASA_CANCONV_X86)
+namespace {
 
-#define CANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
+  // Get the shuffle instructions supported by the CPU (determined once):
+  // 2 = AVX2, 1 = SSSE3, 0 = none.
+  int shuffleLevel()
+  {
+    static const int level = []() {
+      __builtin_cpu_init();
+      return (__builtin_cpu_supports("avx2")  ?  2 :
+              __builtin_cpu_supports("ssse3") ?  1 : 0);
+    }();
+    return level;
+  }
+
+  __attribute__((target("avx2")))
+  size_t shuffleAvx2 (char* dest, const char* data, size_t nbytes,
+                      const char* mask16)
+  {
+    const __m256i mask = _mm256_broadcastsi128_si256
+      (_mm_loadu_si128((const __m128i*)mask16));
+    size_t i = 0;
+    for (; i+32 <= nbytes; i+=32) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+      _mm256_storeu_si256((__m256i*)(dest + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+  }
+
+  __attribute__((target("ssse3")))
+  size_t shuffleSsse3 (char* dest, const char* data, size_t nbytes,
+                       const char* mask16)
+  {
+    const __m128i mask = _mm_loadu_si128((const __m128i*)mask16);
+    size_t i = 0;
+    for (; i+16 <= nbytes; i+=16) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+      _mm_storeu_si128((__m128i*)(dest + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+  }
+
+  // Shuffle the bytes in each 16-byte block using the fastest instructions
+  // available. It returns the number of bytes done (a multiple of 16).
+  size_t shuffleBytes (char* dest, const char* data, size_t nbytes,
+                       const char* mask16)
+  {
+    int level = shuffleLevel();
+    size_t done = 0;
+    if (level >= 2) {
+      done = shuffleAvx2 (dest, data, nbytes, mask16);
+    }
+    if (level >= 1) {
+      done += shuffleSsse3 (dest+done, data+done, nbytes-done, mask16);
+    }
+    return done;
+  }
+
+} //# end anonymous namespace
+#endif
+
+
+void CanonicalConversion::reverse2 (void* to, const void* from, size_t nr)
+{
+    char* dest = (char*)to;
+    const char* data = (const char*)from;
+    size_t i = 0;
+#if defined(CASA_CANCONV_X86)
+    static const char mask[16] = {1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14};
+    i = shuffleBytes (dest, data, 2*nr, mask) / 2;
+#endif
+#if defined(__SSE2__)
+    for (; i+8 <= nr; i+=8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + 2*i));
+        /* swap the bytes in each 16-bit word */
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i*)(dest + 2*i), v);
+    }
+#endif
+    for (; i<nr; ++i) {
+        reverse2 (dest + 2*i, data + 2*i);
+    }
+}
+
+void CanonicalConversion::reverse4 (void* to, const void* from, size_t nr)
+{
+    char* dest = (char*)to;
+    const char* data = (const char*)from;
+    size_t i = 0;
+#if defined(CASA_CANCONV_X86)
+    static const char mask[16] = {3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12};
+    i = shuffleBytes (dest, data, 4*nr, mask) / 4;
+#endif
+#if defined(__SSE2__)
+    for (; i+4 <= nr; i+=4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + 4*i));
+        /* swap the 16-bit words in each 32-bit value, then their bytes */
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i*)(dest + 4*i), v);
+    }
+#endif
+    for (; i<nr; ++i) {
+        reverse4 (dest + 4*i, data + 4*i);
+    }
+}
+
+void CanonicalConversion::reverse8 (void* to, const void* from, size_t nr)
+{
+    char* dest = (char*)to;
+    const char* data = (const char*)from;
+    size_t i = 0;
+#if defined(CASA_CANCONV_X86)
+    static const char mask[16] = {7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8};
+    i = shuffleBytes (dest, data, 8*nr, mask) / 8;
+#endif
+#if defined(__SSE2__)
+    for (; i+2 <= nr; i+=2) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + 8*i));
+        /* reverse the 16-bit words in each 64-bit value, then their bytes */
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i*)(dest + 8*i), v);
+    }
+#endif
+    for (; i<nr; ++i) {
+        reverse8 (dest + 8*i, data + 8*i);
+    }
+}
+
+
+#define CANONICALCONVERSION_DO(CONVERT,SIZE,REVERSE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
 size_t CanonicalConversion::TOLOCAL (void* to, const void* from, \
 				     size_t nr) \
 { \
@@ -133,6 +274,9 @@ size_t CanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Conversion is a plain byte swap; do it in bulk. */ \
+	REVERSE (to, from, nr); \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -151,6 +295,9 @@ size_t CanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Conversion is a plain byte swap; do it in bulk. */ \
+	REVERSE (to, from, nr); \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
@@ -193,27 +340,35 @@ Conversion::ByteFunction* CanonicalConversion::getByteFromLocal (const T*) \
 
 
 CANONICALCONVERSION_DO (CONVERT_CAN_SHORT,  SIZE_CAN_SHORT,
+			reverse2,
 			toLocalShort,  fromLocalShort,
 			byteToLocalShort,  byteFromLocalShort,  short)
 CANONICALCONVERSION_DO (CONVERT_CAN_USHORT, SIZE_CAN_USHORT,
+			reverse2,
 			toLocalUShort, fromLocalUShort,
 			byteToLocalUShort, byteFromLocalUShort, unsigned short)
 CANONICALCONVERSION_DO (CONVERT_CAN_INT,    SIZE_CAN_INT,
+			reverse4,
 			toLocalInt,    fromLocalInt,
 			byteToLocalInt,    byteFromLocalInt,    int)
 CANONICALCONVERSION_DO (CONVERT_CAN_UINT,   SIZE_CAN_UINT,
+			reverse4,
 			toLocalUInt,   fromLocalUInt,
 			byteToLocalUInt,   byteFromLocalUInt,   unsigned int)
 CANONICALCONVERSION_DO (CONVERT_CAN_INT64,  SIZE_CAN_INT64,
+			reverse8,
 			toLocalInt64,  fromLocalInt64,
 			byteToLocalInt64,  byteFromLocalInt64,  Int64)
 CANONICALCONVERSION_DO (CONVERT_CAN_UINT64, SIZE_CAN_UINT64,
+			reverse8,
 			toLocalUInt64, fromLocalUInt64,
 			byteToLocalUInt64, byteFromLocalUInt64, uInt64)
 CANONICALCONVERSION_DO (CONVERT_CAN_FLOAT,  SIZE_CAN_FLOAT,
+			reverse4,
 			toLocalFloat,  fromLocalFloat,
 			byteToLocalFloat,  byteFromLocalFloat,  float)
 CANONICALCONVERSION_DO (CONVERT_CAN_DOUBLE, SIZE_CAN_DOUBLE,
+			reverse8,
 			toLocalDouble, fromLocalDouble,
 			byteToLocalDouble, byteFromLocalDouble, double)
 
@@ -423,6 +423,17 @@ public:
     // Reverse 8 bytes.
     static void reverse8 (void* to, const void* from);
 
+    // Reverse the bytes of each of <src>nr</src> consecutive 2-, 4- or
+    // 8-byte values. It is used for the bulk conversions of the numeric
+    // types. On x86 it uses AVX2 or SSSE3 instructions if the CPU supports
+    // them, otherwise SSE2. Buffers <src>to</src> and <src>from</src> must be
+    // the same or should not overlap.
+    // <group>
+    static void reverse2 (void* to, const void* from, size_t nr);
+    static void reverse4 (void* to, const void* from, size_t nr);
+    static void reverse8 (void* to, const void* from, size_t nr);
+    // </group>
+
     // Move 2 bytes.
     static void move2 (void* to, const void* from);
 
@@ -29,7 +29,10 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/iostream.h>
-#ifdef __SSE2__
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CASA_CONV_X86
+#include <immintrin.h>
+#elif defined(__SSE2__)
 #include <emmintrin.h>
 #endif
 #ifdef _OPENMP
@@ -39,6 +42,63 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# AVX2 is not part of the x86_64 baseline, so the AVX2 loops are compiled
+//# for that target only and used if the CPU supports it.
+#if defined(CASA_CONV_X86)
+namespace {
+
+  Bool haveAvx2()
+  {
+    static const Bool avx2 = []() {
+      __builtin_cpu_init();
+      return Bool(__builtin_cpu_supports("avx2"));
+    }();
+    return avx2;
+  }
+
+  // Convert 32 Bools at a time to bits; returns the number of values done.
+  __attribute__((target("avx2")))
+  size_t boolToBitAvx2 (unsigned char* bits, const Bool* data, size_t nvalues)
+  {
+    const __m256i zero256 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i+32 <= nvalues; i+=32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)&data[i]);
+        v = _mm256_cmpeq_epi8(v, zero256);
+        unsigned int r = ~(unsigned int)_mm256_movemask_epi8(v);
+        memcpy(&bits[i / 8], &r, 4);
+    }
+    return i;
+  }
+
+  // Convert 32 bits at a time to Bools; returns the number of values done.
+  __attribute__((target("avx2")))
+  size_t bitToBoolAvx2 (Bool* data, const unsigned char* bits, size_t nvalues)
+  {
+    //# Broadcast each bit byte to 8 bytes and test the bit of each byte.
+    const __m256i shuf256 = _mm256_setr_epi8
+      (0,0,0,0,0,0,0,0, 1,1,1,1,1,1,1,1,
+       2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3);
+    const __m256i mask256 = _mm256_setr_epi8
+      (1,2,4,8,16,32,64,-128, 1,2,4,8,16,32,64,-128,
+       1,2,4,8,16,32,64,-128, 1,2,4,8,16,32,64,-128);
+    const __m256i one256 = _mm256_set1_epi8(1);
+    size_t i = 0;
+    for (; i+32 <= nvalues; i+=32) {
+        int r;
+        memcpy (&r, &bits[i / 8], 4);
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(r), shuf256);
+        v = _mm256_cmpeq_epi8(_mm256_and_si256(v, mask256), mask256);
+        _mm256_storeu_si256((__m256i*)&data[i],
+                            _mm256_and_si256(v, one256));
+    }
+    return i;
+  }
+
+} //# end anonymous namespace
+#endif
+
+
 size_t Conversion::boolToBit (void* to, const void* from,
                               size_t nvalues)
 {
@@ -46,9 +106,14 @@ size_t Conversion::boolToBit (void* to, const void* from,
     unsigned char* bits = (unsigned char*)to;
     size_t i = 0;
 
+#if defined(CASA_CONV_X86)
+    if (haveAvx2()) {
+        i = boolToBitAvx2 (bits, data, nvalues);
+    }
+#endif
 #ifdef __SSE2__
     __m128i zero = _mm_setzero_si128();
-    for (i = 0; i < nvalues - (nvalues & 0xF); i+=16) {
+    for (; i < nvalues - (nvalues & 0xF); i+=16) {
         __m128i v = _mm_loadu_si128((const __m128i*)&data[i]);
         /* compare to zero to convert false -> 0xFF and true -> 0x00 */
         v = _mm_cmpeq_epi8(v, zero);
@@ -58,8 +123,8 @@ size_t Conversion::boolToBit (void* to, const void* from,
         /* store the 16 bits */
         memcpy(&bits[i / 8], &r, 2);
     }
-    data = &data[i];
 #endif
+    data = &data[i];
 
     //# Fill as many full bytes as possible.
     //# Note: the compiler can optimize much better for j<8 than j<nbits.
@@ -121,15 +186,11 @@ void Conversion::boolToBit (void* to, const void* from,
 	    mask <<= 1;
 	}
     }
-    //# Set the bits in all 'full' bytes.
-    for (size_t i=startByte; i<endByte; ++i) {
-	unsigned char& ch = bits[i];
-	ch = 0;
-	for (size_t j=0; j<8; ++j) {
-	    if (*data++) {
-                ch |= (1<<j);
-	    }
-	}
+    //# Set the bits in all 'full' bytes (which can use SIMD instructions).
+    if (startByte < endByte) {
+        size_t nfull = 8 * (endByte - startByte);
+        boolToBit (bits + startByte, data, nfull);
+        data += nfull;
     }
     //# Set the bits in the last byte (if needed).
     if (endBit2 > 0) {
@@ -151,9 +212,34 @@ size_t Conversion::bitToBool_ (void* to, const void* from,
 {
     Bool* data = (Bool*)to;
     const unsigned char* bits = (const unsigned char*)from;
+    size_t i = 0;
+    if (sizeof(Bool) == sizeof(char)) {
+#if defined(CASA_CONV_X86)
+        if (haveAvx2()) {
+            i = bitToBoolAvx2 (data, bits, nvalues);
+        }
+#endif
+#ifdef __SSE2__
+        const __m128i mask = _mm_setr_epi8
+          (1,2,4,8,16,32,64,-128, 1,2,4,8,16,32,64,-128);
+        const __m128i one = _mm_set1_epi8(1);
+        for (; i+16 <= nvalues; i+=16) {
+            unsigned short r;
+            memcpy (&r, &bits[i / 8], 2);
+            //# Replicate the first byte in 8 bytes, the second in next 8.
+            __m128i v = _mm_cvtsi32_si128(r);
+            v = _mm_unpacklo_epi8(v, v);
+            v = _mm_unpacklo_epi16(v, v);
+            v = _mm_unpacklo_epi32(v, v);
+            v = _mm_cmpeq_epi8(_mm_and_si128(v, mask), mask);
+            _mm_storeu_si128((__m128i*)&data[i], _mm_and_si128(v, one));
+        }
+#endif
+    }
+    data += i;
     //# Use as many full bytes as possible.
     size_t nfbytes = nvalues / 8;
-    for (size_t i=0; i<nfbytes; ++i) {
+    for (i = i / 8; i<nfbytes; ++i) {
 	int ch = bits[i];
 	for (size_t j=0; j<8; ++j) {
             *data++ = (ch & (1<<j));
@@ -497,12 +583,11 @@ void Conversion::bitToBool (void* to, const void* from,
             *data++ = (ch & (1<<j));
 	}
     }
-    //# Set the bits in all 'full' bytes.
-    for (size_t i=startByte; i<endByte; ++i) {
-	int ch = bits[i];
-	for (size_t j=0; j<8; ++j) {
-            *data++ = (ch & (1<<j));
-	}
+    //# Set the bits in all 'full' bytes (which can use SIMD instructions).
+    if (startByte < endByte) {
+        size_t nfull = 8 * (endByte - startByte);
+        bitToBool (data, bits + startByte, nfull);
+        data += nfull;
     }
     //# Get the bits in the last byte (if needed).
     if (endBit2 > 0) {
@@ -25,6 +25,7 @@
 
 
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
 #include <assert.h>
 #include <casacore/casa/iostream.h>
 
@@ -125,7 +126,7 @@ Conversion::ByteFunction* LECanonicalConversion::getByteFromLocal
 
 
 
-#define LECANONICALCONVERSION_DO(CONVERT,SIZE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
+#define LECANONICALCONVERSION_DO(CONVERT,SIZE,REVERSE,TOLOCAL,FROMLOCAL,BYTETO,BYTEFROM,T) \
 size_t LECanonicalConversion::TOLOCAL (void* to, const void* from, \
                                        size_t nr)                  \
 { \
@@ -133,6 +134,9 @@ size_t LECanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Conversion is a plain byte swap; do it in bulk. */ \
+	REVERSE (to, from, nr); \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -151,6 +155,9 @@ size_t LECanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Conversion is a plain byte swap; do it in bulk. */ \
+	REVERSE (to, from, nr); \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
@@ -193,28 +200,36 @@ Conversion::ByteFunction* LECanonicalConversion::getByteFromLocal (const T*) \
 
 
 LECANONICALCONVERSION_DO (CONVERT_LECAN_SHORT,  SIZE_LECAN_SHORT,
+			  CanonicalConversion::reverse2,
 			  toLocalShort,  fromLocalShort,
 			  byteToLocalShort,  byteFromLocalShort,  short)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_USHORT, SIZE_LECAN_USHORT,
+			  CanonicalConversion::reverse2,
 			  toLocalUShort, fromLocalUShort,
 			  byteToLocalUShort, byteFromLocalUShort,
 			  unsigned short)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_INT,    SIZE_LECAN_INT,
+			  CanonicalConversion::reverse4,
 			  toLocalInt,    fromLocalInt,
 			  byteToLocalInt,    byteFromLocalInt,    int)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_UINT,   SIZE_LECAN_UINT,
+			  CanonicalConversion::reverse4,
 			  toLocalUInt,   fromLocalUInt,
 			  byteToLocalUInt,   byteFromLocalUInt,   unsigned int)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_INT64,  SIZE_LECAN_INT64,
+			  CanonicalConversion::reverse8,
 			  toLocalInt64,  fromLocalInt64,
 			  byteToLocalInt64,  byteFromLocalInt64,  Int64)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_UINT64, SIZE_LECAN_UINT64,
+			  CanonicalConversion::reverse8,
 			  toLocalUInt64, fromLocalUInt64,
 			  byteToLocalUInt64, byteFromLocalUInt64, uInt64)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_FLOAT,  SIZE_LECAN_FLOAT,
+			  CanonicalConversion::reverse4,
 			  toLocalFloat,  fromLocalFloat,
 			  byteToLocalFloat,  byteFromLocalFloat,  float)
 LECANONICALCONVERSION_DO (CONVERT_LECAN_DOUBLE, SIZE_LECAN_DOUBLE,
+			  CanonicalConversion::reverse8,
 			  toLocalDouble, fromLocalDouble,
 			  byteToLocalDouble, byteFromLocalDouble, double)
 
@@ -515,6 +515,51 @@ void checkConversion (int& error)
     }
 }
 
+// Check the bulk conversions (which use SIMD instructions if available)
+// against the conversion of single values for various lengths and an
+// unaligned buffer.
+template<typename T>
+void checkBulk (const T*, const char* name, int& error)
+{
+    const size_t size = sizeof(T);
+    char val[41*8+1];
+    char out[41*8+1];
+    for (size_t i=0; i<sizeof(val); ++i) {
+	val[i] = char(i*7 + 3);
+    }
+    for (size_t nr=0; nr<=41; ++nr) {
+	T result[41];
+	CanonicalConversion::toLocal (result, val+1, nr);
+	for (size_t i=0; i<nr; ++i) {
+	    T v;
+	    CanonicalConversion::toLocal (v, val+1+i*size);
+	    if (memcmp (&v, result+i, size) != 0) {
+		cout << "invalid bulk " << name << " to conversion "
+		     << nr << ' ' << i << endl;
+		error = 1;
+	    }
+	}
+	CanonicalConversion::fromLocal (out+1, result, nr);
+	if (memcmp (out+1, val+1, nr*size) != 0) {
+	    cout << "invalid bulk " << name << " from conversion "
+		 << nr << endl;
+	    error = 1;
+	}
+    }
+}
+
+void checkBulk (int& error)
+{
+    checkBulk ((short*)0, "short", error);
+    checkBulk ((unsigned short*)0, "unsigned short", error);
+    checkBulk ((int*)0, "int", error);
+    checkBulk ((unsigned int*)0, "unsigned int", error);
+    checkBulk ((Int64*)0, "Int64", error);
+    checkBulk ((uInt64*)0, "uInt64", error);
+    checkBulk ((float*)0, "float", error);
+    checkBulk ((double*)0, "double", error);
+}
+
 
 int main()
 {
@@ -523,6 +568,9 @@ int main()
     if (!error) {
 	checkConversion (error);
     }
+    if (!error) {
+	checkBulk (error);
+    }
     // Exit when errors found.
     if (error) {
 	return 1;
@@ -68,6 +68,49 @@ void checkAll()
   }
 }
 
+// Check the conversions with a start bit against a straightforward
+// bit loop for various offsets and lengths (covering the SIMD paths).
+void checkOffsets()
+{
+  cout << "checkOffsets ..." << endl;
+  uChar bits[64];
+  uChar bitsExp[64];
+  Bool flagArr[8*64+1];
+  Bool flagExp[8*64];
+  for (uInt i=0; i<64; ++i) {
+    bits[i] = uChar(i*37 + 11);
+  }
+  // Use an unaligned Bool pointer as well.
+  for (uInt off=0; off<2; ++off) {
+    Bool* flags = flagArr + off;
+    for (uInt startBit=0; startBit<20; ++startBit) {
+      for (uInt nr=0; nr<=8*64-20; nr+=(nr<80 ? 1:37)) {
+        Conversion::bitToBool (flags, bits, startBit, nr);
+        for (uInt i=0; i<nr; ++i) {
+          uInt bit = startBit+i;
+          flagExp[i] = (bits[bit/8] & (1<<(bit%8))) != 0;
+          AlwaysAssertExit (flags[i] == flagExp[i]);
+        }
+        // Write the Bools back at another offset.
+        memcpy (bitsExp, bits, sizeof(bits));
+        uInt toStart = (startBit*3) % 17;
+        for (uInt i=0; i<nr; ++i) {
+          uInt bit = toStart+i;
+          if (flagExp[i]) {
+            bitsExp[bit/8] |= (1<<(bit%8));
+          } else {
+            bitsExp[bit/8] &= ~(1<<(bit%8));
+          }
+        }
+        uChar out[64];
+        memcpy (out, bits, sizeof(bits));
+        Conversion::boolToBit (out, flags, toStart, nr);
+        AlwaysAssertExit (memcmp(out, bitsExp, sizeof(out)) == 0);
+      }
+    }
+  }
+}
+
 int main()
 {
     uInt nbool = 100;
@@ -153,6 +196,7 @@ int main()
     delete [] bits;
 
     checkAll();
+    checkOffsets();
     cout << "OK" << endl;
     return 0;
 }
@@ -26,13 +26,19 @@
 
 #include <casacore/casa/aips.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+#include <vector>
 
 
 #include <casacore/casa/namespace.h>
 // This program tests various ways to convert bits to Bools and vice-versa.
+// It also times the bulk canonical conversions of the numeric types.
 
 void bool2char (unsigned char* out, const Bool* in, size_t nr)
 {
@@ -254,10 +260,103 @@ void checkPerf()
     timer.show("cparttobool");
   }
 }
+// Time the conversions for typical FLAG cell sizes (npol*nchan) starting
+// at various bit offsets as done by the storage managers.
+void checkFlagCells()
+{
+  cout << "checkFlagCells ..." << endl;
+  const size_t ncells[] = {4*64, 4*1024, 4*16384};
+  for (size_t k=0; k<3; ++k) {
+    size_t nr = ncells[k];
+    std::vector<uChar> bits(nr/8 + 2, 0x5a);
+    Block<Bool> flagBlock(nr+1, False);
+    Bool* flags = flagBlock.storage();
+    int nloop = 100000000 / nr;
+    for (size_t startBit=0; startBit<8; startBit+=3) {
+      ostringstream ostr;
+      ostr << " nr=" << nr << " start=" << startBit;
+      {
+        Timer timer;
+        for (int i=0; i<nloop; ++i) {
+          Conversion::bitToBool (flags+1, &(bits[0]), startBit, nr);
+        }
+        timer.show("cparttobool" + ostr.str());
+      }
+      {
+        Timer timer;
+        for (int i=0; i<nloop; ++i) {
+          Conversion::boolToBit (&(bits[0]), flags+1, startBit, nr);
+        }
+        timer.show("cparttobit " + ostr.str());
+      }
+      {
+        Timer timer;
+        for (int i=0; i<nloop; ++i) {
+          boolToBit (&(bits[0]), flags+1, startBit, nr);
+        }
+        timer.show("parttobit  " + ostr.str());
+      }
+    }
+  }
+}
+
+// Time the bulk canonical conversion of a type against converting
+// value by value.
+template<typename T>
+void checkCanonical (const T*, const char* name)
+{
+  const size_t nr = 4096;
+  const size_t size = CanonicalConversion::canonicalSize ((const T*)0);
+  std::vector<char> buf(nr*size + 1);
+  for (size_t i=0; i<buf.size(); ++i) {
+    buf[i] = char(i);
+  }
+  std::vector<T> vals(nr);
+  {
+    Timer timer;
+    for (int i=0; i<100000; ++i) {
+      const char* data = &(buf[1]);
+      for (size_t j=0; j<nr; ++j) {
+        CanonicalConversion::toLocal (vals[j], data);
+        data += size;
+      }
+    }
+    timer.show(String("value tolocal   ") + name);
+  }
+  {
+    Timer timer;
+    for (int i=0; i<100000; ++i) {
+      CanonicalConversion::toLocal (&(vals[0]), &(buf[1]), nr);
+    }
+    timer.show(String("bulk  tolocal   ") + name);
+  }
+  {
+    Timer timer;
+    for (int i=0; i<100000; ++i) {
+      CanonicalConversion::fromLocal (&(buf[1]), &(vals[0]), nr);
+    }
+    timer.show(String("bulk  fromlocal ") + name);
+  }
+}
+
+void checkCanonical()
+{
+  cout << "checkCanonical ..." << endl;
+  checkCanonical ((short*)0,          "short ");
+  checkCanonical ((unsigned short*)0, "ushort");
+  checkCanonical ((int*)0,            "int   ");
+  checkCanonical ((unsigned int*)0,   "uint  ");
+  checkCanonical ((Int64*)0,          "Int64 ");
+  checkCanonical ((uInt64*)0,         "uInt64");
+  checkCanonical ((float*)0,          "float ");
+  checkCanonical ((double*)0,         "double");
+}
 
 int main()
 {
     checkPerf();
+    checkFlagCells();
+    checkCanonical();
     cout << "OK" << endl;
     return 0;
 }
@@ -0,0 +1,112 @@
+//# GenMerge.h: Parallel merging of ordered parts of an array
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_GENMERGE_H
+#define CASA_GENMERGE_H
+
+#include <casacore/casa/aips.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary> Parallel merge sort building blocks </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tGenSort,tSort" demos="">
+
+// <synopsis>
+// The static functions in this class are used by the parallel merge sorts
+// of <linkto class=GenSort>GenSort</linkto>,
+// <linkto class=GenSortIndirect>GenSortIndirect</linkto> and
+// <linkto class=Sort>Sort</linkto>. They are templated on the type of
+// the elements to be sorted (values or indices) and on the comparison
+// functor <src>less(x,y)</src>, which must tell if <src>x</src> has to be
+// put before <src>y</src>.
+// <p>
+// <src>findParts</src> divides the array in as many chunks as threads and
+// determines the ordered parts (runs) in each chunk. A chunk with more than
+// a few parts is sorted by its thread using <src>std::stable_sort</src>,
+// so thereafter only a few long parts have to be merged.
+// <br><src>merge</src> merges the parts pairwise until a single part is left.
+// Each pairwise merge is split in pieces of about equal size by a binary
+// search of the position in both parts (the so-called merge path).
+// In this way all threads are kept busy, also in the last merge steps when
+// only a few large parts are left.
+// <p>
+// Both functions keep equal elements in their original order, thus
+// the sort is stable.
+// </synopsis>
+
+template<class T, class INX>
+class GenMerge
+{
+public:
+    // Determine the ordered parts in <src>data</src> and fill
+    // <src>index</src> (of length <src>nr+1</src>) with the start of each
+    // part. A chunk containing more than a few parts gets sorted.
+    // The number of parts is returned. If <src>nr</src> is returned, the
+    // array is in strictly reversed order (and not changed).
+    // The chunks are handled in parallel using at most <src>nthr</src>
+    // threads.
+    template<typename LESS>
+    static INX findParts (T* data, INX nr, INX* index, int nthr,
+                          LESS less);
+
+    // Merge the <src>nparts</src> ordered parts in <src>data</src>.
+    // <src>index</src> gives the start of each part; it has to be followed
+    // by <src>nr</src>. The index is changed by the merge.
+    // Alternately <src>data</src> and <src>tmp</src> are used for the merge
+    // result. The pointer containing the final result is returned.
+    // <br>If possible, the merge is done in parallel using at most
+    // <src>nthr</src> threads.
+    template<typename LESS>
+    static T* merge (T* data, T* tmp, INX nr, INX* index, INX nparts,
+                     int nthr, LESS less);
+
+    // Get the number of elements of part <src>f1</src> in the first
+    // <src>d</src> elements of the merge of parts <src>f1</src> and
+    // <src>f2</src>.
+    template<typename LESS>
+    static INX split (const T* f1, INX na, const T* f2, INX nb, INX d,
+                      LESS less);
+
+    // Merge the ordered parts <src>f1</src> and <src>f2</src> into
+    // <src>to</src>. Equal elements of <src>f1</src> are put first.
+    template<typename LESS>
+    static void mergeParts (const T* f1, INX na, const T* f2, INX nb,
+                            T* to, LESS less);
+
+private:
+    // A chunk with more parts than this is sorted by findParts.
+    static const INX theirMaxParts = 8;
+    // A pairwise merge is split in pieces of at least this size.
+    static const INX theirMinPiece = 16384;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/casa/Utilities/GenMerge.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
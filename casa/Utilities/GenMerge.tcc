@@ -0,0 +1,201 @@
+//# GenMerge.tcc: Parallel merging of ordered parts of an array
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_GENMERGE_TCC
+#define CASA_GENMERGE_TCC
+
+#include <casacore/casa/Utilities/GenMerge.h>
+#include <algorithm>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template<class T, class INX>
+template<typename LESS>
+INX GenMerge<T,INX>::findParts (T* data, INX nr, INX* index, int nthr,
+                                LESS less)
+{
+  if (nthr < 1) nthr = 1;
+  // Do not use more chunks than there are values.
+  if (INX(nthr) > nr) nthr = nr;
+  std::vector<INX> tinx(nthr+1);
+  std::vector<INX> np(nthr);
+  // Determine ordered parts in each chunk.
+  for (int i=0; i<nthr; ++i) tinx[i] = INX(uInt64(nr)*i/nthr);
+  tinx[nthr] = nr;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr)
+#endif
+  for (int i=0; i<nthr; ++i) {
+    INX nparts = 1;
+    index[tinx[i]] = tinx[i];
+    for (INX j=tinx[i]+1; j<tinx[i+1]; ++j) {
+      if (less(data[j], data[j-1])) {
+        index[tinx[i]+nparts] = j;    // out of order, thus new part
+        nparts++;
+      }
+    }
+    np[i] = nparts;
+  }
+  // Each part has length 1 if the array is in reversed order.
+  bool reversed = true;
+  for (int i=0; i<nthr && reversed; ++i) {
+    reversed = (np[i] == tinx[i+1]-tinx[i]  &&
+                (i == 0  ||  less(data[tinx[i]], data[tinx[i]-1])));
+  }
+  if (reversed) {
+    return nr;
+  }
+  // Sort the chunks with many parts.
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(dynamic)
+#endif
+  for (int i=0; i<nthr; ++i) {
+    if (np[i] > theirMaxParts) {
+      std::stable_sort (data+tinx[i], data+tinx[i+1], less);
+      np[i] = 1;
+    }
+  }
+  // Make index parts consecutive by shifting to the left.
+  // See if last and next part can be combined.
+  INX nparts = np[0];
+  for (int i=1; i<nthr; ++i) {
+    if (less(data[tinx[i]], data[tinx[i]-1])) {
+      index[nparts++] = tinx[i];
+    }
+    for (INX j=1; j<np[i]; ++j) {
+      index[nparts++] = index[tinx[i]+j];
+    }
+  }
+  index[nparts] = nr;
+  return nparts;
+}
+
+template<class T, class INX>
+template<typename LESS>
+T* GenMerge<T,INX>::merge (T* data, T* tmp, INX nr, INX* index,
+                           INX nparts, int nthr, LESS less)
+{
+  // Describes a piece of the merge of two parts.
+  struct Piece {
+    const T* f1;
+    const T* f2;
+    T* to;
+    INX na;
+    INX nb;
+    INX st;
+    INX end;
+  };
+  if (nthr < 1) nthr = 1;
+  // Split the merges in a few pieces per thread.
+  INX minPiece = std::max (INX(nr / (4*INX(nthr)) + 1), INX(theirMinPiece));
+  std::vector<Piece> pieces;
+  T* a = data;
+  T* b = tmp;
+  INX np = nparts;
+  while (np > 1) {
+    pieces.clear();
+    for (INX i=0; i<np; i+=2) {
+      // Merge 2 subsequent parts of the array. A last single part is
+      // merged with an empty part, thus copied.
+      Piece p;
+      p.f1 = a + index[i];
+      p.na = index[i+1] - index[i];
+      p.f2 = p.f1 + p.na;
+      p.nb = (i+1 < np  ?  index[i+2] - index[i+1] : 0);
+      p.to = b + index[i];
+      INX n = p.na + p.nb;
+      INX nsplit = (n + minPiece - 1) / minPiece;
+      for (INX j=0; j<nsplit; ++j) {
+        p.st  = INX(uInt64(n)*j/nsplit);
+        p.end = INX(uInt64(n)*(j+1)/nsplit);
+        pieces.push_back (p);
+      }
+    }
+    long long npieces = pieces.size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(dynamic) if (npieces > 1)
+#endif
+    for (long long i=0; i<npieces; ++i) {
+      const Piece& p = pieces[i];
+      INX ia  = split (p.f1, p.na, p.f2, p.nb, p.st, less);
+      INX iae = split (p.f1, p.na, p.f2, p.nb, p.end, less);
+      INX ib  = p.st - ia;
+      mergeParts (p.f1+ia, iae-ia, p.f2+ib, (p.end-iae)-ib, p.to+p.st, less);
+    }
+    // Collapse the index.
+    INX k=0;
+    for (INX i=0; i<np; i+=2) index[k++] = index[i];
+    index[k] = nr;
+    np = k;
+    // Swap the index target and destination.
+    T* c = a;
+    a = b;
+    b = c;
+  }
+  return a;
+}
+
+template<class T, class INX>
+template<typename LESS>
+INX GenMerge<T,INX>::split (const T* f1, INX na, const T* f2, INX nb, INX d,
+                            LESS less)
+{
+  // Find the largest i such that f1[i-1] is put before f2[d-i].
+  INX lo = (d > nb  ?  d-nb : 0);
+  INX hi = (d < na  ?  d : na);
+  while (lo < hi) {
+    INX i = lo + (hi-lo+1)/2;
+    INX j = d - i;
+    if (j < nb  &&  less(f2[j], f1[i-1])) {
+      hi = i-1;
+    } else {
+      lo = i;
+    }
+  }
+  return lo;
+}
+
+template<class T, class INX>
+template<typename LESS>
+void GenMerge<T,INX>::mergeParts (const T* f1, INX na, const T* f2, INX nb,
+                                  T* to, LESS less)
+{
+  INX ia=0, ib=0, k=0;
+  while (ia < na  &&  ib < nb) {
+    if (less(f2[ib], f1[ia])) {
+      to[k] = f2[ib++];
+    } else {
+      to[k] = f1[ia++];
+    }
+    k++;
+  }
+  for (; ia<na; ia++,k++) to[k] = f1[ia];
+  for (; ib<nb; ib++,k++) to[k] = f2[ib];
+}
+
+} //# NAMESPACE CASACORE - END
+
+#endif
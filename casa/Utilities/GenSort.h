@@ -86,7 +86,9 @@ template<class T> class Block;
 // uses a merge sort that is equally fast for random input and much faster for
 // degenerated cases like an already ordered or reversely ordered array.
 // Furthermore, merge sort is always stable and will be parallelized if OpenMP
-// support is enabled giving a 6-fold speedup on 8 cores.
+// support is enabled. Each thread sorts a chunk of the array, whereafter the
+// chunks are merged by all threads (see <linkto class=GenMerge>GenMerge</linkto>),
+// so it scales with the number of cores.
 // <br><src>Sort::NoDuplicates</src> in the options field indicates that
 // duplicate values will be removed (only the first occurrance is kept).
 // <br>The previous sort functionality is still available through the functions
@@ -132,6 +134,8 @@ public:
   
     // Find the k-th largest value.
     // <br>Note: it does a partial quicksort, thus the data array gets changed.
+    // Large arrays of real values are partitioned around the value found
+    // by a parallel selection if casacore is built with OpenMP support.
     static T kthLargest (T* data, uInt nr, uInt k);
 
     // Sort C-array using quicksort.
@@ -156,17 +160,6 @@ public:
     static void reverse (T* data, const T* res, uInt nrrec);
 
 private:
-    // The<src>data</src> buffer is divided in <src>nparts</src> parts.
-    // In each part the values are in ascending order.
-    // The index tells the nr of elements in each part.
-    // Recursively each two subsequent parts are merged until only part is left
-    // (giving the sorted array). Alternately <src>data</src> and <src>tmp</src>
-    // are used for the merge result. The pointer containing the final result
-    // is returned.
-    // <br>If possible, merging the parts is done in parallel (using OpenMP).
-    static T* merge (T* data, T* tmp, uInt nrrec, uInt* index,
-                     uInt nparts);
-
     // Quicksort in ascending order.
     static void quickSortAsc (T*, Int, Bool multiThread=False, Int rec_lim=128);
 
@@ -250,17 +243,6 @@ private:
     // Swap 2 indices.
     static inline void swapInx (INX& index1, INX& index2);
 
-    // The<src>data</src> buffer is divided in <src>nparts</src> parts.
-    // In each part the values are in ascending order.
-    // The index tells the nr of elements in each part.
-    // Recursively each two subsequent parts are merged until only part is left
-    // (giving the sorted array). Alternately <src>data</src> and <src>tmp</src>
-    // are used for the merge result. The pointer containing the final result
-    // is returned.
-    // <br>If possible, merging the parts is done in parallel (using OpenMP).
-    static INX* merge (const T* data, INX* inx, INX* tmp, INX nrrec,
-                        INX* index, INX nparts);
-
     // Check if 2 values are in ascending order.
     // When equal, the order is correct if index1<index2.
     static inline int isAscending (const T* data, INX index1, INX index2);
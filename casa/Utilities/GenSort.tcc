@@ -27,6 +27,7 @@
 #define CASA_GENSORT_TCC
 
 #include <casacore/casa/Utilities/GenSort.h>
+#include <casacore/casa/Utilities/GenMerge.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -80,20 +81,15 @@ void GenSort<T>::quickSortAsc (T* data, Int nr, Bool multiThread, Int rec_lim)
     }
     swap (*sf, data[nr-1]);
     i = sf-data;
-    if (multiThread) {
-        /* limit threads to what the code can do to not span unnecessary
-         * workers */
+    if (multiThread  &&  nr > 100000) {
+        // Sort the left part in a task (of the parallel region started
+        // by quickSort) and the right part in this thread.
+        // Only large parts are worth a task.
 #ifdef _OPENMP
-        int nthreads = std::min(2, omp_get_max_threads());
-        /* TODO parallel for only uses 2 threads of the group, should use tasks
-         * only parallelize when work time ~ barrier spin time (3ms)
-         * otherwise oversubscription kills performance */
-#pragma omp parallel for num_threads(nthreads) if (nr > 500000)
+#pragma omp task
 #endif
-      for (int thr=0; thr<2; ++thr) {
-        if (thr==0) quickSortAsc (data, i, False, rec_lim - 1);             // sort left part
-        if (thr==1) quickSortAsc (sf+1, nr-i-1, False, rec_lim - 1);        // sort right part
-      }
+      quickSortAsc (data, i, True, rec_lim - 1);                   // sort left part
+      quickSortAsc (sf+1, nr-i-1, True, rec_lim - 1);              // sort right part
     } else {
       quickSortAsc (data, i, False, rec_lim - 1);                  // sort left part
       quickSortAsc (sf+1, nr-i-1, False, rec_lim - 1);             // sort right part
@@ -107,6 +103,25 @@ T GenSort<T>::kthLargest (T* data, uInt nr, uInt k)
     if (k >= nr) {
 	throw (AipsError ("kthLargest(data, nr, k): k must be < nr"));
     }
+    // For large arrays the value is found in parallel (if possible).
+    // Thereafter a single pass partitions the data around it, so
+    // the data are left in the same partially sorted state.
+    T value;
+    if (arrays_internal::parallelKthValue (data, nr, k, value)) {
+	uInt lt = 0;
+	uInt gt = nr;
+	uInt i = 0;
+	while (i < gt) {
+	    if (data[i] < value) {
+		swap (data[lt++], data[i++]);
+	    } else if (value < data[i]) {
+		swap (data[i], data[--gt]);
+	    } else {
+		++i;
+	    }
+	}
+	return data[k];
+    }
     Int st = 0;
     Int end = Int(nr) - 1;
     // Partition until a set of 1 or 2 elements is left.
@@ -252,60 +267,30 @@ uInt GenSort<T>::parSort (T* data, uInt nr, Sort::Order ord, int opt,
 #ifdef _OPENMP
   if (nthread > 0) {
     nthr = nthread;
-    // Do not use more threads than there are values.
-    if (uInt(nthr) > nr) nthr = nr;
   } else {
     nthr = omp_get_max_threads();
-    if (uInt(nthr) > nr) nthr = nr;
   }
-  if (nthr == 0)
-    nthr = 1;
 #else
   nthr = 1;
 #endif
-  Block<uInt> index(nr+1);
-  Block<uInt> tinx(nthr+1);
-  Block<uInt> np(nthr);
-  // Determine ordered parts in the array.
-  // It is done in parallel, whereafter the parts are combined.
-  int step = nr/nthr;
-  for (int i=0; i<nthr; ++i) tinx[i] = i*step;
-  tinx[nthr] = nr;
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(nthr)
-#endif
-  for (int i=0; i<nthr; ++i) {
-    int nparts = 1;
-    index[tinx[i]] = tinx[i];
-    for (uInt j=tinx[i]+1; j<tinx[i+1]; ++j) {
-      if (data[j-1] > data[j]) {
-        index[tinx[i]+nparts] = j;    // out of order, thus new part
-        nparts++;
-      }
-    }
-    np[i] = nparts;
-  }
-  // Make index parts consecutive by shifting to the left.
-  // See if last and next part can be combined.
-  uInt nparts = np[0];
-  for (int i=1; i<nthr; ++i) {
-    if (data[tinx[i]-1] > data[tinx[i]]) {
-      index[nparts++] = index[tinx[i]];
-    }
-    if (nparts == tinx[i]+1) {
-      nparts += np[i]-1;
-    } else {
-      for (uInt j=1; j<np[i]; ++j) {
-	index[nparts++] = index[tinx[i]+j];
-      }
-    }
+  if (nr == 0) {
+    return nr;
   }
-  index[nparts] = nr;
-  //cout<<"nparts="<<nparts<<endl;
+  auto less = [](const T& x, const T& y) { return x < y; };
+  // Determine ordered parts in the array (sorting chunks with many parts).
+  // It is done in parallel, whereafter the parts are merged.
+  Block<uInt> index(nr+1);
+  uInt nparts = GenMerge<T,uInt>::findParts (data, nr, index.storage(),
+                                             nthr, less);
   // Merge the array parts. Each part is ordered.
   if (nparts < nr) {
-    Block<T> tmp(nr);
-    T* res = merge (data, tmp.storage(), nr, index.storage(), nparts);
+    T* res = data;
+    Block<T> tmp;
+    if (nparts > 1) {
+      tmp.resize (nr);
+      res = GenMerge<T,uInt>::merge (data, tmp.storage(), nr,
+                                     index.storage(), nparts, nthr, less);
+    }
     // Skip duplicates if needed.
     if ((opt & Sort::NoDuplicates) != 0) {
       nr = insSortAscNoDup (res, nr);
@@ -342,64 +327,6 @@ void GenSort<T>::reverse (T* data, const T* res, uInt nr)
   }
 }
 
-template<class T>
-T* GenSort<T>::merge (T* data, T* tmp, uInt nr, uInt* index,
-                      uInt nparts)
-{
-  T* a = data;
-  T* b = tmp;
-  int np = nparts;
-  // If the nr of parts is odd, the last part is not merged. To avoid having
-  // to copy it to the other array, a pointer 'last' is kept.
-  // Note that merging the previous part with the last part works fine, even
-  // if the last part is in the same buffer.
-  T* last = data + index[np-1];
-  while (np > 1) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i=0; i<np; i+=2) {
-      if (i < np-1) {
-        // Merge 2 subsequent parts of the array.
-	T* f1 = a+index[i];
-	T* f2 = a+index[i+1];
-	T* to = b+index[i];
-	uInt na = index[i+1]-index[i];
-	uInt nb = index[i+2]-index[i+1];
-        if (i == np-2) {
-          //cout<<"swap last np=" <<np<<endl;
-          f2 = last;
-          last = to;
-        }
-	uInt ia=0, ib=0, k=0;
-	while (ia < na && ib < nb) {
-	  if (f1[ia] < f2[ib]) {
-	    to[k] = f1[ia++];
-	  } else {
-	    to[k] = f2[ib++];
-	  }
-	  k++;
-	}
-	if (ia < na) {
-	  for (uInt p=ia; p<na; p++,k++) to[k] = f1[p];
-	} else {
-	  for (uInt p=ib; p<nb; p++,k++) to[k] = f2[p];
-	}
-      }
-    }
-    // Collapse the index.
-    int k=0;
-    for (int i=0; i<np; i+=2) index[k++] = index[i];
-    index[k] = nr;
-    np = k;
-    // Swap the index target and destination.
-    T* c = a;
-    a = b;
-    b = c;
-  }
-  return a;
-}
-
 template<class T>
 uInt GenSort<T>::insSort (T* data, uInt nr, Sort::Order ord, int opt)
 {
@@ -420,6 +347,12 @@ uInt GenSort<T>::quickSort (T* data, uInt nr, Sort::Order ord, int opt)
     rec_limit++;
   }
   rec_limit *= 2;
+  // Large parts are sorted in parallel tasks.
+  // Only parallelize when the work outweighs the thread startup.
+#ifdef _OPENMP
+#pragma omp parallel if (nr > 500000)
+#pragma omp single
+#endif
   quickSortAsc (data, nr, True, rec_limit);
   // Finish with an insertion sort (which also skips duplicates if needed).
   // Note: if quicksort keeps track of its boundaries, the insSort of all
@@ -573,6 +506,11 @@ INX GenSortIndirect<T,INX>::quickSort (INX* inx, const T* data, INX nr,
     rec_limit++;
   }
   rec_limit *= 2;
+  // Large parts are sorted in parallel tasks.
+#ifdef _OPENMP
+#pragma omp parallel if (nr > 500000)
+#pragma omp single
+#endif
   quickSortAsc (inx, data, nr, True, rec_limit);
   // Finish with an insertion sort (which also skips duplicates if needed).
   // Note: if quicksort keeps track of its boundaries, the insSort of all
@@ -603,61 +541,31 @@ INX GenSortIndirect<T,INX>::parSort (INX* inx, const T* data, INX nr,
 #ifdef _OPENMP
   if (nthread > 0) {
     nthr = nthread;
-    // Do not use more threads than there are values.
-    if (INX(nthr) > nr) nthr = nr;
   } else {
     nthr = omp_get_max_threads();
-    if (INX(nthr) > nr) nthr = nr;
   }
-  if (nthr == 0)
-    nthr = 1;
 #else
   nthr = 1;
 #endif
-  Block<INX> index(nr+1);
-  Block<INX> tinx(nthr+1);
-  Block<INX> np(nthr);
-  // Determine ordered parts in the array.
-  // It is done in parallel, whereafter the parts are combined.
-  int step = nr/nthr;
-  for (int i=0; i<nthr; ++i) tinx[i] = i*step;
-  tinx[nthr] = nr;
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(nthr)
-#endif
-  for (int i=0; i<nthr; ++i) {
-    int nparts = 1;
-    index[tinx[i]] = tinx[i];
-    for (INX j=tinx[i]+1; j<tinx[i+1]; ++j) {
-      if (data[inx[j-1]] > data[inx[j]]) {
-        index[tinx[i]+nparts] = j;    // out of order, thus new part
-        nparts++;
-      }
-    }
-    np[i] = nparts;
-  }
-  // Make index parts consecutive by shifting to the left.
-  // See if last and next part can be combined.
-  INX nparts = np[0];
-  for (int i=1; i<nthr; ++i) {
-    if (data[tinx[i]-1] > data[tinx[i]]) {
-      index[nparts++] = index[tinx[i]];
-    }
-    if (nparts == tinx[i]+1) {
-      nparts += np[i]-1;
-    } else {
-      for (INX j=1; j<np[i]; ++j) {
-	index[nparts++] = index[tinx[i]+j];
-      }
-    }
+  if (nr == 0) {
+    return nr;
   }
-  index[nparts] = nr;
-  //cout<<"nparts="<<nparts<<endl;
+  // Equal values keep their order in the index, so the sort is stable.
+  auto less = [data](INX x, INX y) { return data[x] < data[y]; };
+  // Determine ordered parts in the array (sorting chunks with many parts).
+  // It is done in parallel, whereafter the parts are merged.
+  Block<INX> index(nr+1);
+  INX nparts = GenMerge<INX,INX>::findParts (inx, nr, index.storage(),
+                                             nthr, less);
   // Merge the array parts. Each part is ordered.
   if (nparts < nr) {
-    Block<INX> inxtmp(nr);
-    INX* res = merge (data, inx, inxtmp.storage(), nr,
-                       index.storage(), nparts);
+    INX* res = inx;
+    Block<INX> inxtmp;
+    if (nparts > 1) {
+      inxtmp.resize (nr);
+      res = GenMerge<INX,INX>::merge (inx, inxtmp.storage(), nr,
+                                      index.storage(), nparts, nthr, less);
+    }
     // Skip duplicates if needed.
     if ((opt & Sort::NoDuplicates) != 0) {
       nr = insSortAscNoDup (res, data, nr);
@@ -679,66 +587,6 @@ INX GenSortIndirect<T,INX>::parSort (INX* inx, const T* data, INX nr,
   return nr;
 }  
 
-template<class T, class INX>
-INX* GenSortIndirect<T,INX>::merge (const T* data, INX* inx, INX* tmp, INX nr,
-                                    INX* index, INX nparts)
-{
-  INX* a = inx;
-  INX* b = tmp;
-  int np = nparts;
-  // If the nr of parts is odd, the last part is not merged. To avoid having
-  // to copy it to the other array, a pointer 'last' is kept.
-  // Note that merging the previous part with the last part works fine, even
-  // if the last part is in the same buffer.
-  INX* last = inx + index[np-1];
-  while (np > 1) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i=0; i<np; i+=2) {
-      if (i < np-1) {
-        // Merge 2 subsequent parts of the array.
-	INX* f1 = a+index[i];
-	INX* f2 = a+index[i+1];
-	INX* to = b+index[i];
-	INX na = index[i+1]-index[i];
-	INX nb = index[i+2]-index[i+1];
-        if (i == np-2) {
-          //cout<<"swap last np=" <<np<<endl;
-          f2 = last;
-          last = to;
-        }
-	INX ia=0, ib=0, k=0;
-	while (ia < na && ib < nb) {
-	  if (data[f1[ia]] <= data[f2[ib]]) {
-	    to[k] = f1[ia++];
-	  } else {
-	    to[k] = f2[ib++];
-	  }
-	  k++;
-	}
-	if (ia < na) {
-	  for (INX p=ia; p<na; p++,k++) to[k] = f1[p];
-	} else {
-	  for (INX p=ib; p<nb; p++,k++) to[k] = f2[p];
-	}
-      }
-    }
-    // Collapse the index.
-    int k=0;
-    for (int i=0; i<np; i+=2) index[k++] = index[i];
-    index[k] = nr;
-    np = k;
-    // Swap the index target and destination.
-    INX* c = a;
-    a = b;
-    b = c;
-  }
-  return a;
-}
-
-
-
 template<class T, class INX>
 void GenSortIndirect<T,INX>::quickSortAsc (INX* inx, const T* data, INX nr,
                                            Bool multiThread, Int rec_lim)
@@ -780,20 +628,14 @@ void GenSortIndirect<T,INX>::quickSortAsc (INX* inx, const T* data, INX nr,
     }
     swapInx (*sf, inx[nr-1]);
     INX n = sf-inx;
-    if (multiThread) {
-        /* limit threads to what the code can do to not span unnecessary
-         * workers */
+    if (multiThread  &&  nr > 100000) {
+        // Sort the left part in a task (of the parallel region started
+        // by quickSort) and the right part in this thread.
 #ifdef _OPENMP
-        int nthreads = std::min(2, omp_get_max_threads());
-        /* TODO parallel for only uses 2 threads of the group, should use tasks
-         * only parallelize when work time ~ barrier spin time (3ms)
-         * otherwise oversubscription kills performance */
-#pragma omp parallel for num_threads(nthreads) if (nr > 500000)
+#pragma omp task
 #endif
-      for (int thr=0; thr<2; ++thr) {
-        if (thr==0) quickSortAsc (inx, data, n, False, rec_lim - 1);
-        if (thr==1) quickSortAsc (sf+1, data, nr-n-1, False, rec_lim - 1);
-      }
+      quickSortAsc (inx, data, n, True, rec_lim - 1);
+      quickSortAsc (sf+1, data, nr-n-1, True, rec_lim - 1);
     } else {
       quickSortAsc (inx, data, n, False, rec_lim - 1);
       quickSortAsc (sf+1, data, nr-n-1, False, rec_lim - 1);
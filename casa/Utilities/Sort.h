@@ -392,11 +392,9 @@ private:
     // Do a merge sort, if possible in parallel using OpenMP.
     // Note that the env.var. OMP_NUM_TRHEADS sets the maximum nr of threads
     // to use. It defaults to the number of cores.
+    // All threads are used to merge (see <linkto class=GenMerge>GenMerge</linkto>).
     template<typename T>
     T parSort (int nthr, T nrrec, T* inx) const;
-    template<typename T>
-    void merge (T* inx, T* tmp, T size, T* index,
-                T nparts) const;
 
     // Do a quicksort, optionally skipping duplicates
     // (qkSort is the actual quicksort function).
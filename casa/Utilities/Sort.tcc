@@ -28,6 +28,7 @@
 
 //# Includes
 #include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Utilities/GenMerge.h>
 #include <casacore/casa/Utilities/SortError.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 
@@ -166,49 +167,25 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   template<typename T>
   T Sort::parSort (int nthr, T nrrec, T* inx) const
   {
+    // The comparison also uses the index for equal keys, so the sort
+    // is stable.
+    auto less = [this](T x, T y) { return compare (x, y) > 0; };
+    // Determine ordered parts in the array (sorting chunks with many parts).
+    // It is done in parallel, whereafter the parts are merged.
     Block<T> index(nrrec+1);
-    Block<T> tinx(nthr+1);
-    Block<T> np(nthr);
-    // Determine ordered parts in the array.
-    // It is done in parallel, whereafter the parts are combined.
-    int step = nrrec/nthr;
-    for (int i=0; i<nthr; ++i) tinx[i] = i*step;
-    tinx[nthr] = nrrec;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (int i=0; i<nthr; ++i) {
-      int nparts = 1;
-      index[tinx[i]] = tinx[i];
-      for (T j=tinx[i]+1; j<tinx[i+1]; ++j) {
-        if (compare (inx[j-1], inx[j]) <= 0) {
-          index[tinx[i]+nparts] = j;    // out of order, thus new part
-          nparts++;
-        }
-      }
-      np[i] = nparts;
-    }
-    // Make index parts consecutive by shifting to the left.
-    // See if last and next part can be combined.
-    T nparts = np[0];
-    for (int i=1; i<nthr; ++i) {
-      if (compare (tinx[i]-1, tinx[i]) <= 0) {
-        index[nparts++] = index[tinx[i]];
-      }
-      if (nparts == tinx[i]+1) {
-        nparts += np[i]-1;
-      } else {
-        for (T j=1; j<np[i]; ++j) {
-          index[nparts++] = index[tinx[i]+j];
-        }
-      }
-    }
-    index[nparts] = nrrec;
-    //cout<<"nparts="<<nparts<<endl;
+    T nparts = GenMerge<T,T>::findParts (inx, nrrec, index.storage(),
+                                         nthr, less);
     // Merge the array parts. Each part is ordered.
     if (nparts < nrrec) {
-      Block<T> inxtmp(nrrec);
-      merge (inx, inxtmp.storage(), nrrec, index.storage(), nparts);
+      if (nparts > 1) {
+        Block<T> inxtmp(nrrec);
+        T* res = GenMerge<T,T>::merge (inx, inxtmp.storage(), nrrec,
+                                       index.storage(), nparts, nthr, less);
+        // If final result happens to be in incorrect array, copy it over.
+        if (res != inx) {
+          objcopy (inx, res, nrrec);
+        }
+      }
     } else {
       // Each part has length 1, so the array is in reversed order.
       for (T i=0; i<nrrec; ++i) inx[i] = nrrec-1-i;
@@ -216,67 +193,6 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return nrrec;
   }  
 
-  template<typename T>
-  void Sort::merge (T* inx, T* tmp, T nrrec, T* index,
-                    T nparts) const
-  {
-    T* a = inx;
-    T* b = tmp;
-    int np = nparts;
-    // If the nr of parts is odd, the last part is not merged. To avoid having
-    // to copy it to the other array, a pointer 'last' is kept.
-    // Note that merging the previous part with the last part works fine, even
-    // if the last part is in the same buffer.
-    T* last = inx + index[np-1];
-    while (np > 1) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-      for (int i=0; i<np; i+=2) {
-        if (i < np-1) {
-          // Merge 2 subsequent parts of the array.
-          T* f1 = a+index[i];
-          T* f2 = a+index[i+1];
-          T* to = b+index[i];
-          T na = index[i+1]-index[i];
-          T nb = index[i+2]-index[i+1];
-          if (i == np-2) {
-            //cout<<"swap last np=" <<np<<endl;
-            f2 = last;
-            last = to;
-          }
-          T ia=0, ib=0, k=0;
-          while (ia < na && ib < nb) {
-            if (compare(f1[ia], f2[ib]) > 0) {
-              to[k] = f1[ia++];
-            } else {
-              to[k] = f2[ib++];
-            }
-            k++;
-          }
-          if (ia < na) {
-            for (T p=ia; p<na; p++,k++) to[k] = f1[p];
-          } else {
-            for (T p=ib; p<nb; p++,k++) to[k] = f2[p];
-          }
-        }
-      }
-      // Collapse the index.
-      int k=0;
-      for (int i=0; i<np; i+=2) index[k++] = index[i];
-      index[k] = nrrec;
-      np = k;
-      // Swap the index target and destination.
-      T* c = a;
-      a = b;
-      b = c;
-    }
-    // If final result happens to be in incorrect array, copy it over.
-    if (a != inx) {
-      objcopy (inx, a, nrrec);
-    }
-  }
-
   template<typename T>
   T Sort::insSort (T nrrec, T* inx) const
   {
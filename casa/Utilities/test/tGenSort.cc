@@ -33,6 +33,7 @@
 #include <casacore/casa/stdlib.h>
 #include <casacore/casa/iomanip.h>
 #include <algorithm>
+#include <vector>
 
 #include <casacore/casa/namespace.h>
 
@@ -156,6 +157,28 @@ int main(int argc, const char* argv[])
     delete [] indx;
     delete [] data;
 
+    // Test kthLargest on a large array (selected in parallel if possible).
+    // The data must be partitioned around the k-th element.
+    nr = 1500001;
+    std::vector<Double> vd(nr);
+    for (uInt i=0; i < nr; i++) {
+        vd[i] = (rand() % 100000) * 0.5;
+    }
+    std::vector<Double> vref(vd);
+    uInt k = nr/3;
+    std::nth_element (vref.begin(), vref.begin()+k, vref.end());
+    Double kthd = GenSort<Double>::kthLargest (vd.data(), nr, k);
+    if (kthd != vref[k]  ||  vd[k] != kthd) {
+        cout << "large kthLargest is " << kthd << "; should be "
+             << vref[k] << endl;
+    }
+    for (uInt i=0; i < nr; i++) {
+        if ((i < k  &&  vd[i] > kthd)  ||  (i > k  &&  vd[i] < kthd)) {
+            cout << "large kthLargest: data not partitioned at " << i << endl;
+            break;
+        }
+    }
+
     return 0;                            // exit with success status
 }
 
@@ -0,0 +1,173 @@
+//# tSortPerf.cc: Time the parallel merge sorts
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Utilities/GenSort.h>
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/sstream.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// This program times the parallel merge sorts of GenSort, GenSortIndirect
+// and Sort for various kinds of input and compares them with the former
+// merge sort (which merged the ordered parts in the input pairwise, so
+// only a few threads were used in the last merge steps).
+// It checks that the results are the same.
+// Run it as:  tSortPerf [nr] [nthreads]
+// The number of threads defaults to the OpenMP maximum.
+
+// The former indirect parallel merge sort.
+// Runs are merged pairwise until a single run is left.
+template<typename T>
+void refSort (std::vector<uInt>& inx, const T* data)
+{
+  uInt nr = inx.size();
+  std::vector<uInt> index(1, 0);
+  for (uInt j=1; j<nr; ++j) {
+    if (data[inx[j-1]] > data[inx[j]]) {
+      index.push_back (j);
+    }
+  }
+  uInt np = index.size();
+  index.push_back (nr);
+  std::vector<uInt> tmp(nr);
+  uInt* a = inx.data();
+  uInt* b = tmp.data();
+  while (np > 1) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (Int64 i=0; i<Int64(np); i+=2) {
+      uInt* f1 = a+index[i];
+      uInt* to = b+index[i];
+      uInt na = index[i+1]-index[i];
+      uInt nb = (i+1 < Int64(np)  ?  index[i+2]-index[i+1] : 0);
+      uInt* f2 = f1+na;
+      uInt ia=0, ib=0, k=0;
+      while (ia < na && ib < nb) {
+        if (data[f1[ia]] <= data[f2[ib]]) {
+          to[k++] = f1[ia++];
+        } else {
+          to[k++] = f2[ib++];
+        }
+      }
+      for (; ia<na; ++ia) to[k++] = f1[ia];
+      for (; ib<nb; ++ib) to[k++] = f2[ib];
+    }
+    uInt k=0;
+    for (uInt i=0; i<np; i+=2) index[k++] = index[i];
+    index[k] = nr;
+    np = k;
+    std::swap (a, b);
+  }
+  if (a != inx.data()) {
+    std::copy (a, a+nr, inx.data());
+  }
+}
+
+void timeSorts (const String& name, const std::vector<Double>& values,
+                int nthr)
+{
+  uInt nr = values.size();
+  cout << name << endl;
+  // Direct sort.
+  std::vector<Double> ref(values);
+  Timer timer;
+  std::stable_sort (ref.begin(), ref.end());
+  timer.show ("  std::stable_sort  ");
+  std::vector<Double> vals(values);
+  timer.mark();
+  GenSort<Double>::parSort (vals.data(), nr, Sort::Ascending, 0, nthr);
+  timer.show ("  GenSort::parSort  ");
+  AlwaysAssertExit (vals == ref);
+  // Indirect sort.
+  std::vector<uInt> refInx(nr);
+  for (uInt i=0; i<nr; ++i) refInx[i] = i;
+  std::vector<uInt> inx(refInx);
+  timer.mark();
+  refSort (refInx, values.data());
+  timer.show ("  former indirect   ");
+  timer.mark();
+  GenSortIndirect<Double,uInt>::parSort (inx.data(), values.data(), nr,
+                                         Sort::Ascending, 0, nthr);
+  timer.show ("  GenSortIndirect   ");
+  AlwaysAssertExit (inx == refInx);
+  // Sort on two keys (so GenSortIndirect cannot be used).
+  std::vector<Int> key2(nr);
+  for (uInt i=0; i<nr; ++i) key2[i] = i%3;
+  Sort sort;
+  sort.sortKey (key2.data(), TpInt);
+  sort.sortKey (values.data(), TpDouble);
+  Vector<uInt> sinx;
+  timer.mark();
+  sort.sort (sinx, nr, Sort::ParSort);
+  timer.show ("  Sort 2 keys       ");
+  Vector<uInt> qinx;
+  timer.mark();
+  sort.sort (qinx, nr, Sort::QuickSort);
+  timer.show ("  Sort 2 keys quick ");
+  AlwaysAssertExit (allEQ (sinx, qinx));
+  for (uInt i=1; i<nr; ++i) {
+    AlwaysAssertExit (key2[sinx[i-1]] < key2[sinx[i]]  ||
+                      (key2[sinx[i-1]] == key2[sinx[i]]  &&
+                       values[sinx[i-1]] <= values[sinx[i]]));
+  }
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt nr = 1000000;
+    int nthr = 0;
+    if (argc > 1) {
+      istringstream istr(argv[1]);
+      istr >> nr;
+    }
+    if (argc > 2) {
+      istringstream istr(argv[2]);
+      istr >> nthr;
+    }
+    std::vector<Double> values(nr);
+    for (uInt i=0; i<nr; ++i) values[i] = rand();
+    timeSorts ("random", values, nthr);
+    for (uInt i=0; i<nr; ++i) values[i] = rand() % 100;
+    timeSorts ("100 distinct values", values, nthr);
+    for (uInt i=0; i<nr; ++i) values[i] = i;
+    timeSorts ("ordered", values, nthr);
+    for (uInt i=0; i<nr; ++i) values[i] = nr-i;
+    timeSorts ("reversed", values, nthr);
+    for (uInt i=0; i<nr; ++i) values[i] = (i < nr/2  ?  2*i : 2*(i-nr/2)+1);
+    timeSorts ("2 ordered halves", values, nthr);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
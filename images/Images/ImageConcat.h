@@ -195,6 +195,15 @@ public:
    uInt imageDim() const
      { return latticeConcat_p.latticeDim(); }
 
+// Set the maximum number of images kept open if tempClose is set.
+// See <linkto class=LatticeConcat>LatticeConcat</linkto>.
+   void setMaxOpen (uInt maxOpen)
+     { latticeConcat_p.setMaxOpen (maxOpen); }
+
+// Returns the maximum number of images kept open.
+   uInt maxOpen() const
+     { return latticeConcat_p.maxOpen(); }
+
 // Return a reference to the i-th image.
   ImageInterface<T>& image(uInt i) const
     { return dynamic_cast<ImageInterface<T>&>(*(latticeConcat_p.lattice(i))); }
@@ -173,6 +173,7 @@ ImageConcat<T>::ImageConcat (const JsonKVMap& jmap, const String& fileName)
   Bool tmpClose = jmap.getBool("TempClose", True);
   Vector<String> names(jmap.get("Images").getArrayString());
   latticeConcat_p=LatticeConcat<T>(axis, tmpClose);
+  latticeConcat_p.setMaxOpen (jmap.getInt("MaxOpen", 0));
   // Combine miscinfo if not defined in the Json file.
   combineMiscInfo_p = !jmap.isDefined("MiscInfo");
   for (uInt i=0; i<names.size(); ++i) {
@@ -223,6 +224,7 @@ void ImageConcat<T>::save (const String& fileName) const
   jout.write ("DataType", dt);
   jout.write ("Axis", latticeConcat_p.axis());
   jout.write ("TempClose", latticeConcat_p.isTempClose());
+  jout.write ("MaxOpen", latticeConcat_p.maxOpen());
   Vector<String> names(latticeConcat_p.nlattices());
   for (uInt i=0; i<latticeConcat_p.nlattices(); ++i) {
     String name = latticeConcat_p.lattice(i)->name(False);
@@ -181,6 +181,10 @@ public:
 			   const IPosition& where,
 			   const IPosition& stride);
 
+  // Copy the data from this image to the given lattice.
+  // It uses LatticeExpr::copyDataTo, which can evaluate in parallel.
+  virtual void copyDataTo (Lattice<T>& to) const;
+
   // If the object is persistent, the file name is given.
   // Otherwise it returns the expression string given in the constructor.
   virtual String name (Bool stripPath=False) const;
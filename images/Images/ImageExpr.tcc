@@ -222,6 +222,12 @@ Bool ImageExpr<T>::doGetSlice (Array<T>& buffer,
 } 
    
 
+template <class T>
+void ImageExpr<T>::copyDataTo (Lattice<T>& to) const
+{
+  latticeExpr_p.copyDataTo (to);
+}
+
 template <class T>
 void ImageExpr<T>::doPutSlice (const Array<T>&, const IPosition&,
 			       const IPosition&)
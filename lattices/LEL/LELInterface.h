@@ -34,6 +34,7 @@
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/IO/FileLocker.h>
 #include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -209,6 +210,20 @@ private:
 };
 
 
+// <summary>
+// Mutex serializing the data access in lattice expressions
+// </summary>
+// <synopsis>
+// The leaf nodes of an expression (LELLattice and LELRegion) get their
+// data while holding this mutex, because the underlying lattices (e.g. a
+// PagedArray using the table system) cannot be accessed concurrently.
+// It makes it possible to evaluate different chunks of an expression
+// in parallel as done by LatticeExpr::copyDataTo.
+// The mutex is recursive, because a lattice can be an expression itself.
+// </synopsis>
+std::recursive_mutex& lelDataMutex();
+
+
 
 } //# NAMESPACE CASACORE - END
 
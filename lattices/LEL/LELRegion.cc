@@ -163,6 +163,7 @@ LELRegionAsBool::~LELRegionAsBool()
 void LELRegionAsBool::eval(LELArray<Bool>& result, 
 			   const Slicer& section) const
 {
+   std::lock_guard<std::recursive_mutex> lock(lelDataMutex());
    Array<Bool> tmp = region_p.getSlice (section);
    result.value().reference(tmp);
 }
@@ -29,11 +29,15 @@
 #include <casacore/lattices/LEL/LatticeExpr.h>
 #include <casacore/lattices/LEL/LELArray.h>
 #include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h> 
+#include <atomic>
+#include <exception>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -247,15 +251,91 @@ template<class T>
 void LatticeExpr<T>::copyDataTo (Lattice<T>& to) const
 {
   // If a scalar, set lattice to its value.
-  // Otherwise use the Lattice copyDataTo function.
+  // Otherwise evaluate the expression chunk by chunk.
   if (expr_p.isScalar()) {
     // Check the lattice is writable.
     AlwaysAssert (to.isWritable(), AipsError);
     T value;
     expr_p.eval (value);
     to.set (value);
-  } else {
-    Lattice<T>::copyDataTo (to);
+    return;
+  }
+  // Check the lattice is writable.
+  // Check the shape conformance.
+  AlwaysAssert (to.isWritable(), AipsError);
+  AlwaysAssert (shape_p.isEqual (to.shape()), AipsError);
+  LatticeStepper stepper (shape_p, to.niceCursorShape(),
+                          LatticeStepper::RESIZE);
+  // Create an iterator for the output to setup the cache.
+  // It is not used, because using putSlice directly is faster and as easy.
+  LatticeIterator<T> dummyIter(to, stepper);
+  std::vector<Slicer> chunks;
+  for (stepper.reset(); !stepper.atEnd(); stepper++) {
+    chunks.push_back (Slicer(stepper.position(), stepper.endPosition(),
+                             Slicer::endIsLast));
+  }
+  if (chunks.empty()) {
+    return;
+  }
+  // The first chunk is evaluated sequentially, because the first
+  // evaluation prepares the expression tree (scalar subexpressions are
+  // evaluated and replaced by their result).
+  // The other chunks are evaluated in parallel. The data access in the
+  // leaves of the expression is serialized (see lelDataMutex), but the
+  // arithmetic is done concurrently. The chunks are written in order.
+  {
+    LELArray<T> chunk (chunks[0].length());
+    expr_p.eval (chunk, chunks[0]);
+    to.putSlice (chunk.value(), chunks[0].start());
+  }
+  // An exception in a thread is rethrown after the loop.
+  std::exception_ptr error;
+  std::atomic<Bool> failed(False);
+  Int64 nchunk = chunks.size();
+#ifdef _OPENMP
+#pragma omp parallel for ordered schedule(dynamic) if (nchunk > 2)
+#endif
+  for (Int64 i=1; i<nchunk; ++i) {
+    LELArray<T> chunk (chunks[i].length());
+    try {
+      if (!failed) {
+        expr_p.eval (chunk, chunks[i]);
+      }
+    } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeExpr_copyDataTo)
+#endif
+      {
+        if (!failed) {
+          error = std::current_exception();
+          failed = True;
+        }
+      }
+    }
+#ifdef _OPENMP
+#pragma omp ordered
+#endif
+    {
+      if (!failed) {
+        try {
+          std::lock_guard<std::recursive_mutex> lock(lelDataMutex());
+          to.putSlice (chunk.value(), chunks[i].start());
+        } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeExpr_copyDataTo)
+#endif
+          {
+            if (!failed) {
+              error = std::current_exception();
+              failed = True;
+            }
+          }
+        }
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception (error);
   }
 }
 
@@ -53,6 +53,13 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+std::recursive_mutex& lelDataMutex()
+{
+  static std::recursive_mutex theMutex;
+  return theMutex;
+}
+
+
 // Default constructor
 LatticeExprNode::LatticeExprNode()
 : donePrepare_p   (False),
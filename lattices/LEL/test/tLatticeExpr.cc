@@ -25,9 +25,11 @@
 
 #include <casacore/lattices/LEL/LatticeExpr.h>
 #include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Inputs/Input.h>
@@ -225,6 +227,35 @@ int main (int argc, const char* argv[])
        delete pExpr;
      }
 
+//
+// Copy an expression consisting of many chunks (which can be evaluated
+// in parallel) to a PagedArray, also to one of its operands.
+//
+     {
+       cout << "Chunks" << endl;
+       IPosition cubeShape(3, 40, 36, 30);
+       TiledShape tshape(cubeShape, IPosition(3, 16, 16, 4));
+       Array<Float> arr(cubeShape);
+       indgen (arr);
+       PagedArray<Float> pa1(tshape, "tLatticeExpr_tmp.pa1");
+       PagedArray<Float> pa2(tshape, "tLatticeExpr_tmp.pa2");
+       pa1.put (arr);
+       LatticeExpr<Float> expr ((pa1 - 2*pa1) / sqrt(abs(pa1) + 1) +
+                                max(pa1));
+       pa2.copyData (expr);
+       Array<Float> exp ((arr - 2.f*arr) / sqrt(abs(arr) + 1.f) + max(arr));
+       if (!allNear (pa2.get(), exp, 1e-6)) {
+         cout << "   Result of chunked copyData is wrong" << endl;
+         ok = False;
+       }
+       pa2.copyData (LatticeExpr<Float>(pa2 - pa1 + 1));
+       exp -= arr - 1.f;
+       if (!allNear (pa2.get(), exp, 1e-6)) {
+         cout << "   Result of chunked in-place copyData is wrong" << endl;
+         ok = False;
+       }
+     }
+
 
 
   cout << endl;
@@ -42,9 +42,13 @@
 #include <casacore/casa/Arrays/ArrayPosIter.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <exception>
+#include <memory>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -150,6 +154,21 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
     collapser.init (nResult);
     if (tellProgress != 0) tellProgress->init (nLine);
 
+// If the collapser can be cloned, the lines of a tile are processed in
+// parallel, where each thread uses its own collapser.
+// The lines are read sequentially.
+
+    std::vector<std::unique_ptr<LineCollapser<T,U>>> workers;
+    for (uInt k=1; k<OMP::maxThreads(); ++k) {
+        std::unique_ptr<LineCollapser<T,U>> worker (collapser.clone());
+        if (! worker) {
+            workers.clear();
+            break;
+        }
+        worker->init (nResult);
+        workers.push_back (std::move(worker));
+    }
+
 // Iterate through all the lines.
 // Per tile the lines (in the collapseAxis direction) are
 // assembled into a single array, which is put thereafter.
@@ -185,6 +204,14 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
 	U* result = array.getStorage (deleteIt);
 	Bool* resultMask = arrayMask.getStorage (deleteMask);
 	uInt n = array.nelements() / nResult;
+	// Read the lines (copied, because the iterator reuses its buffer).
+	std::vector<Vector<T>> lines;
+	std::vector<Vector<Bool>> masks(n);
+	std::vector<IPosition> positions;
+	if (! workers.empty()) {
+	    lines.reserve (n);
+	    positions.reserve (n);
+	}
 	for (uInt i=0; i<n; ++i) {
 	    DebugAssert (! inIter.atEnd(), AipsError);
 	    const IPosition pos (inIter.position());
@@ -197,11 +224,44 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
                           (tmp, Slicer(pos, inIter.cursorShape()), True);
 		mask.reference (tmp);
 	    }
-	    collapser.process (result[i], resultMask[i],
-			       inIter.vectorCursor(), mask, pos);
+	    if (workers.empty()) {
+		collapser.process (result[i], resultMask[i],
+				   inIter.vectorCursor(), mask, pos);
+	    } else {
+		lines.push_back (inIter.vectorCursor().copy());
+		masks[i].reference (mask);
+		positions.push_back (pos);
+	    }
 	    ++inIter;
 	    if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
 	}
+	if (! workers.empty()) {
+	    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+	    for (Int i=0; i<Int(n); ++i) {
+		try {
+		    uInt thread = OMP::threadNum();
+		    LineCollapser<T,U>& coll = (thread == 0  ?
+						collapser : *workers[thread-1]);
+		    coll.process (result[i], resultMask[i],
+				  lines[i], masks[i], positions[i]);
+		} catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_lineApply)
+#endif
+		    {
+			if (! error) {
+			    error = std::current_exception();
+			}
+		    }
+		}
+	    }
+	    if (error) {
+		std::rethrow_exception (error);
+	    }
+	}
 	array.putStorage (result, deleteIt);
 	arrayMask.putStorage (resultMask, deleteMask);
 	latticeOut.putSlice (array, outPos);
@@ -465,76 +525,33 @@ void LatticeApply<T,U>::tiledApply (
 	    }
     }
 
-    // Iterate through all the tiles.
-    // TileStepper is set up in such a way that the collapse axes are iterated
-    // fastest. When all collapse axes are handled, thus when the iter axes
-    // position changes, we have to write that part.
-
-    Bool firstTime = True;
-    IPosition outPos(outDim, 0);
-    IPosition iterPos(outDim, 0);
-    while (! inIter.atEnd()) {
-
-        // Calculate the size of each chunk of output data.
-        // Each chunk contains the data of a tile in each IterAxis.
-        // Determine the index of the first element to take from the cursor.
-
-	    const Array<T>& iterCursor = inIter.cursor();
-	    // In order to use the pointers-to-array-data below, the array *must*
-	    // be contiguous or the results will in general be incorrect.
-	    // Ditto for the mask
-	    const Array<T>& cursor = iterCursor.contiguousStorage()
-	    	? iterCursor : iterCursor.copy();
-	    ThrowIf(
-	    	! cursor.contiguousStorage(), "cursor array is not contiguous"
-	    );
-	    const IPosition& cursorShape = cursor.shape();
-	    IPosition pos = inIter.position();
-	    IPosition latPos = pos;
-	    Array<Bool> mask;
-	    if (useMask) {
-	        // Casting const away is innocent.
-	        ((MaskedLattice<T>&)latticeIn).getMaskSlice(mask, Slicer(pos, cursorShape));
-	        if (! mask.contiguousStorage()) {
-	        	mask = mask.copy();
-	        	ThrowIf(
-	        		! mask.contiguousStorage(), "mask array is not contiguous"
-	        	);
-	        }
-	    }
-	    for (j=0; j<outDim; ++j) {
-	        if (ioMap(j) >= 0) {
-		        uInt axis = ioMap(j);
-		        iterPos(j) = pos(axis);
-	        }
-	    }
-	    if (firstTime  ||  outPos != iterPos) {
-	        if (!firstTime) {
-		        Array<U> result;
-		        Array<Bool> resultMask;
-		        collapser.endAccumulator (result, resultMask, outShape);
-		        latticeOut.putSlice (result, outPos);
-		        if (maskOut != 0) {
-		            maskOut->putSlice (resultMask, outPos);
-		        }
-	        }
-	        firstTime = False;
-	        outPos = iterPos;
-	        uInt64 n1 = 1;
-	        uInt64 n3 = 1;
-	        for (j=0; j<outDim; ++j) {
-		        if (ioMap(j) >= 0) {
-		            outShape(j) = cursorShape(ioMap(j));
-		            if (j < resultAxis) {
-		                n1 *= outShape(j);
-		            }
-                    else {
-		                n3 *= outShape(j);
-		            }
-		        }
-	        }
-	        collapser.initAccumulator (n1, n3);
-	    }
+    // If the collapser can be cloned, the tiles belonging to the same
+    // output chunk are processed in parallel in batches. The first tile
+    // of a batch is processed by the collapser itself, the others by a
+    // clone. Thereafter the clones are merged in order of the tiles.
+    // The tiles are read sequentially.
+    std::vector<std::unique_ptr<TiledCollapser<T,U>>> workers;
+    for (uInt k=1; k<OMP::maxThreads(); ++k) {
+        std::unique_ptr<TiledCollapser<T,U>> worker (collapser.clone());
+        if (! worker) {
+            workers.clear();
+            break;
+        }
+        worker->init (outShape.product());
+        workers.push_back (std::move(worker));
+    }
+    std::vector<Array<T>> tiles;
+    std::vector<Array<Bool>> tileMasks;
+    std::vector<IPosition> tilePositions;
+    uInt64 n1 = 1;
+    uInt64 n3 = 1;
+
+    // Collapse the chunks in a tile.
+    auto processTile = [&] (TiledCollapser<T,U>& coll, const Array<T>& cursor,
+                            const Array<Bool>& mask, const IPosition& pos)
+    {
+        const IPosition& cursorShape = cursor.shape();
+        IPosition latPos = pos;
 
         // Put the collapsed lines into an output buffer
         // Initialize the cursor position needed in the loop.
@@ -546,7 +563,7 @@ void LatticeApply<T,U>::tiledApply (
         // in the cursor (if there are 2 pixels).
 
 	    IPosition chunkShape (inDim, 1);
-	    for (j=0; j<collStart; ++j) {
+	    for (uInt j=0; j<collStart; ++j) {
 	        const uInt axis = collapseAxes(j);
 	        chunkShape(axis) = cursorShape(axis);
 	    }
@@ -565,16 +582,17 @@ void LatticeApply<T,U>::tiledApply (
 
 	    uInt index1 = 0;
 	    uInt index3 = 0;
+	    uInt j;
 	    for (;;) {
 	        for (;;) {
 		        if (useMask) {
-		            collapser.process (
+		            coll.process (
                         index1, index3, &(cursor(curPos)), &(mask(curPos)),
 				        dataIncr, maskIncr, nval, latPos, chunkShape
                     );
 		        }
                 else {
-		            collapser.process(
+		            coll.process(
                         index1, index3,
 				        &(cursor(curPos)), 0,
 				        dataIncr, maskIncr, nval, latPos, chunkShape
@@ -616,6 +634,130 @@ void LatticeApply<T,U>::tiledApply (
 		        break;
 	        }
 	    }
+    };
+
+    // Process the collected tiles.
+    auto processTiles = [&] ()
+    {
+        Int ntile = tiles.size();
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (ntile > 1)
+#endif
+        for (Int k=0; k<ntile; ++k) {
+            try {
+                if (k == 0) {
+                    processTile (collapser, tiles[k], tileMasks[k],
+                                 tilePositions[k]);
+                } else {
+                    workers[k-1]->initAccumulator (n1, n3);
+                    processTile (*workers[k-1], tiles[k], tileMasks[k],
+                                 tilePositions[k]);
+                }
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeApply_tiledApply)
+#endif
+                {
+                    if (! error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception (error);
+        }
+        for (Int k=1; k<ntile; ++k) {
+            collapser.merge (*workers[k-1]);
+        }
+        tiles.clear();
+        tileMasks.clear();
+        tilePositions.clear();
+    };
+
+    // Iterate through all the tiles.
+    // TileStepper is set up in such a way that the collapse axes are iterated
+    // fastest. When all collapse axes are handled, thus when the iter axes
+    // position changes, we have to write that part.
+
+    Bool firstTime = True;
+    IPosition outPos(outDim, 0);
+    IPosition iterPos(outDim, 0);
+    while (! inIter.atEnd()) {
+
+        // Calculate the size of each chunk of output data.
+        // Each chunk contains the data of a tile in each IterAxis.
+        // Determine the index of the first element to take from the cursor.
+
+	    const Array<T>& iterCursor = inIter.cursor();
+	    // In order to use the pointers-to-array-data below, the array *must*
+	    // be contiguous or the results will in general be incorrect.
+	    // Ditto for the mask.
+	    // The data are also copied if processed in parallel, because the
+	    // iterator reuses its buffer.
+	    Array<T> cursor;
+	    if (workers.empty()  &&  iterCursor.contiguousStorage()) {
+	        cursor.reference (iterCursor);
+	    } else {
+	        cursor.reference (iterCursor.copy());
+	    }
+	    ThrowIf(
+	    	! cursor.contiguousStorage(), "cursor array is not contiguous"
+	    );
+	    const IPosition& cursorShape = cursor.shape();
+	    IPosition pos = inIter.position();
+	    Array<Bool> mask;
+	    if (useMask) {
+	        // Casting const away is innocent.
+	        ((MaskedLattice<T>&)latticeIn).getMaskSlice(mask, Slicer(pos, cursorShape));
+	        if (! mask.contiguousStorage()) {
+	        	mask = mask.copy();
+	        	ThrowIf(
+	        		! mask.contiguousStorage(), "mask array is not contiguous"
+	        	);
+	        }
+	    }
+	    for (j=0; j<outDim; ++j) {
+	        if (ioMap(j) >= 0) {
+		        uInt axis = ioMap(j);
+		        iterPos(j) = pos(axis);
+	        }
+	    }
+	    if (firstTime  ||  outPos != iterPos) {
+	        if (!firstTime) {
+	            processTiles();
+		        Array<U> result;
+		        Array<Bool> resultMask;
+		        collapser.endAccumulator (result, resultMask, outShape);
+		        latticeOut.putSlice (result, outPos);
+		        if (maskOut != 0) {
+		            maskOut->putSlice (resultMask, outPos);
+		        }
+	        }
+	        firstTime = False;
+	        outPos = iterPos;
+	        n1 = 1;
+	        n3 = 1;
+	        for (j=0; j<outDim; ++j) {
+		        if (ioMap(j) >= 0) {
+		            outShape(j) = cursorShape(ioMap(j));
+		            if (j < resultAxis) {
+		                n1 *= outShape(j);
+		            }
+                    else {
+		                n3 *= outShape(j);
+		            }
+		        }
+	        }
+	        collapser.initAccumulator (n1, n3);
+	    }
+	    tiles.push_back (cursor);
+	    tileMasks.push_back (mask);
+	    tilePositions.push_back (pos);
+	    if (tiles.size() > workers.size()) {
+	        processTiles();
+	    }
 	    ++inIter;
 	    if (tellProgress != 0) {
             tellProgress->nstepsDone (inIter.nsteps());
@@ -623,6 +765,7 @@ void LatticeApply<T,U>::tiledApply (
     }
 
     // Write out the last output array.
+    processTiles();
     Array<U> result;
     Array<Bool> resultMask;
     collapser.endAccumulator (result, resultMask, outShape);
@@ -34,6 +34,7 @@
 
 #include <casacore/lattices/LatticeMath/LatticeCleaner.h>
 #include <casacore/lattices/LatticeMath/LatticeCleanProgress.h>
+#include <casacore/lattices/LatticeMath/LatticePeakCache.h>
 #include <casacore/lattices/Lattices/TiledLineStepper.h> 
 #include <casacore/lattices/Lattices/LatticeStepper.h> 
 #include <casacore/lattices/Lattices/LatticeNavigator.h> 
@@ -58,6 +59,9 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Fallible.h>
 
+#include <memory>
+#include <vector>
+
 #include <casacore/casa/BasicSL/Constants.h>
 
 #include <casacore/casa/Logging/LogSink.h>
@@ -452,14 +456,16 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
       }
     }
   }
-  LCBox centerBox(blcDirty, trcDirty, model.shape());
-
-  PtrBlock<Lattice<T>* > scaleMaskSubs;
-  if (itsMask)  {
-    scaleMaskSubs.resize(itsNscales);
-    for (Int is=0; is < itsNscales; is++) {
-      scaleMaskSubs[is] = new SubLattice<T>(*(itsScaleMasks[is]), centerBox);
-    }
+  // The peak of each dirty convolution is kept per block, so only the
+  // blocks changed by subtracting a component have to be searched again.
+  typename LatticePeakCache<T>::PeakType peakType =
+    (itsMask && itsMaskThreshold<0 ? LatticePeakCache<T>::MAXABS_UNWEIGHTED
+                                   : LatticePeakCache<T>::MAXABS);
+  std::vector<std::unique_ptr<LatticePeakCache<T> > > peakCaches;
+  for (Int is=0; is < nScalesToClean; is++) {
+    peakCaches.emplace_back (new LatticePeakCache<T>
+                             (*itsDirtyConvScales[is], blcDirty, trcDirty,
+                              itsMask ? itsScaleMasks[is] : 0, peakType));
   }
 
   // Start the iteration
@@ -482,23 +488,11 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
     optimumScale = 0;
     for (scale=0; scale<nScalesToClean; scale++) {
       // Find absolute maximum for the dirty image
-      SubLattice<T> dirtySub(*itsDirtyConvScales[scale], centerBox);
-      maxima(scale)=0;
-      posMaximum[scale]=IPosition(model.shape().nelements(), 0);
-
-
-      if (itsMask) {
-	findMaxAbsMaskLattice(dirtySub, *(scaleMaskSubs[scale]),
-			      maxima(scale), posMaximum[scale]);
-      } else {
-	findMaxAbsLattice(dirtySub, maxima(scale), posMaximum[scale]);
-      }
+      peakCaches[scale]->find(maxima(scale), posMaximum[scale]);
 
-      // Remember to adjust the position for the window and for 
-      // the flux scale
+      // Remember to adjust for the flux scale
       maxima(scale)/=maxPsfConvScales(scale);
       maxima(scale) *= scaleBias(scale);
-      posMaximum[scale]+=blcDirty;
       if(abs(maxima(scale))>abs(itsStrengthOptimum)) {
         optimumScale=scale;
         itsStrengthOptimum=maxima(scale);
@@ -631,6 +625,7 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
 			   subRegionPsf, True);
       LatticeExpr<T> sub((-scaleFactor)*psfSub);
       addTo(dirtySub, sub);
+      peakCaches[scale]->setChanged(blc, trc);
     }
   }
   // End of iteration
@@ -641,13 +636,6 @@ Int LatticeCleaner<T>::clean(Lattice<T>& model,
        << LogIO::POST;
   }
 
-  if(itsMask) {
-    for (Int is=0; is < itsNscales; is++) {
-      delete scaleMaskSubs[is];
-    }
-    scaleMaskSubs.resize(0);
-  }
-
   // Finish off the plot, etc.
   if(progress) {
     progress->info(True, itsIteration, itsMaxNiter, maxima, posMaximum,
@@ -669,32 +657,8 @@ Bool LatticeCleaner<T>::findMaxAbsLattice(const Lattice<T>& lattice,
 					  T& maxAbs,
 					  IPosition& posMaxAbs)
 {
-
-  posMaxAbs = IPosition(lattice.shape().nelements(), 0);
-  maxAbs=0.0;
-  const IPosition tileShape = lattice.niceCursorShape();
-  TiledLineStepper ls(lattice.shape(), tileShape, 0);
-  {
-    RO_LatticeIterator<T> li(lattice, ls);
-    for(li.reset();!li.atEnd();li++) {
-      IPosition posMax=li.position();
-      IPosition posMin=li.position();
-      T maxVal=0.0;
-      T minVal=0.0;
-      minMax(minVal, maxVal, posMin, posMax, li.cursor());
-      if(abs(minVal)>abs(maxAbs)) {
-        maxAbs=minVal;
-	posMaxAbs=li.position();
-	posMaxAbs(0)=posMin(0);
-      }
-      if(abs(maxVal)>abs(maxAbs)) {
-        maxAbs=maxVal;
-	posMaxAbs=li.position();
-	posMaxAbs(0)=posMax(0);
-      }
-    }
-  }
-
+  LatticePeakCache<T> peaks(lattice);
+  peaks.find(maxAbs, posMaxAbs);
   return True;
 }
 
@@ -707,44 +671,13 @@ Bool LatticeCleaner<T>::findMaxAbsMaskLattice(const Lattice<T>& lattice,
 					      T& maxAbs,
 					      IPosition& posMaxAbs)
 {
-
-  posMaxAbs = IPosition(lattice.shape().nelements(), 0);
-  maxAbs=0.0;
-  const IPosition tileShape = lattice.niceCursorShape();
-  TiledLineStepper ls(lattice.shape(), tileShape, 0);
-  {
-    RO_LatticeIterator<T> li(lattice, ls);
-    RO_LatticeIterator<T> mi(mask, ls);
-    for(li.reset(),mi.reset();!li.atEnd();li++, mi++) {
-      IPosition posMax=li.position();
-      IPosition posMin=li.position();
-      IPosition posMaxMask=li.position();
-      IPosition posMinMask=li.position();
-      T maxVal=0.0;
-      T minVal=0.0;
-      
-      minMaxMasked(minVal, maxVal, posMin, posMax, li.cursor(), mi.cursor());
-      if (itsMaskThreshold<0) {
-          // Mask threhsolding is not used, i.e. mask values are interpreted as weights.
-          // This means that minVal and maxVal are optima of the mask * lattice product, 
-          // we need just values of lattice and have to redetermine them.
-          minVal = li.cursor()(posMin);
-          maxVal = li.cursor()(posMax);
-      }
-
-      if(abs(minVal)>abs(maxAbs)) {
-         maxAbs=minVal;
-         posMaxAbs=li.position();
-         posMaxAbs(0)=posMin(0);
-      }
-      if(abs(maxVal)>abs(maxAbs)) {
-         maxAbs=maxVal;
-         posMaxAbs=li.position();
-         posMaxAbs(0)=posMax(0);
-      }
-    }
-  }
-
+  // If mask thresholding is not used, the mask values are weights for
+  // finding the peak, but the peak value itself is taken from the lattice.
+  LatticePeakCache<T> peaks(lattice, &mask,
+			    itsMaskThreshold<0 ?
+			    LatticePeakCache<T>::MAXABS_UNWEIGHTED :
+			    LatticePeakCache<T>::MAXABS);
+  peaks.find(maxAbs, posMaxAbs);
   return True;
 }
 
@@ -144,6 +144,20 @@ public:
         const Bool doShift=True, Bool doFast=False
     );
   // </group>
+
+private:
+  // Transform the selected axes of a disk-based Lattice in slabs. A slab
+  // holds the full length of as many of the selected axes as fit in the
+  // memory budget (a quarter of the free memory, shared by the threads)
+  // and one tile on the other axes. Thus a pass over the slabs reads and
+  // writes every tile once; the selected axes not fitting in a slab are
+  // transformed in further passes. The slabs of a pass are transformed in
+  // parallel. If doShift is True, the origin of the transform is the centre
+  // of the axes, otherwise it is the first element.
+    template <class ComplexType> static void cfftSlabs(
+        Lattice<ComplexType> & cLattice, const Vector<Bool> & whichAxes,
+        const Bool toFrequency, const Bool doShift
+    );
 };
 
 // implement template specializations to throw exceptions in the relevant cases.
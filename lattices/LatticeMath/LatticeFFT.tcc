@@ -32,6 +32,8 @@
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/VectorIter.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/scimath/Mathematics/FFTServer.h>
 #include <casacore/casa/Utilities/Assert.h>
@@ -42,8 +44,12 @@
 #include <casacore/lattices/Lattices/TempLattice.h>
 #include <casacore/lattices/Lattices/TiledLineStepper.h>
 #include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/iostream.h>
 
+#include <exception>
+#include <vector>
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template <class ComplexType> void LatticeFFT::cfft2d(
@@ -83,6 +89,10 @@ template <class ComplexType> void LatticeFFT::cfft(Lattice<ComplexType>& cLattic
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 0, AipsError);
   DebugAssert(ndim == whichAxes.nelements(), AipsError);
+  if (cLattice.isPaged() && ntrue(whichAxes) > 1) {
+    LatticeFFT::cfftSlabs(cLattice, whichAxes, toFrequency, True);
+    return;
+  }
   FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
   const IPosition latticeShape = cLattice.shape();
   const IPosition tileShape = cLattice.niceCursorShape();
@@ -103,6 +113,10 @@ template <class ComplexType> void LatticeFFT::cfft0(Lattice<ComplexType>& cLatti
   const uInt ndim = cLattice.ndim();
   DebugAssert(ndim > 0, AipsError);
   DebugAssert(ndim == whichAxes.nelements(), AipsError);
+  if (cLattice.isPaged() && ntrue(whichAxes) > 1) {
+    LatticeFFT::cfftSlabs(cLattice, whichAxes, toFrequency, False);
+    return;
+  }
   FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
   const IPosition latticeShape = cLattice.shape();
   const IPosition tileShape = cLattice.niceCursorShape();
@@ -118,6 +132,104 @@ template <class ComplexType> void LatticeFFT::cfft0(Lattice<ComplexType>& cLatti
   }
 }
 
+template <class ComplexType> void LatticeFFT::cfftSlabs(
+    Lattice<ComplexType>& cLattice, const Vector<Bool>& whichAxes,
+    const Bool toFrequency, const Bool doShift) {
+  const uInt ndim = cLattice.ndim();
+  const IPosition latticeShape = cLattice.shape();
+  const IPosition tileShape = cLattice.niceCursorShape();
+  const uInt nthreads = OMP::maxThreads();
+  // use a quarter of the free memory, shared by the slabs done in parallel
+  const Long budget = std::max(
+      Long(1),
+      Long(HostInfo::memoryFree()/(sizeof(ComplexType)*4))*1024/nthreads
+  );
+  std::vector<uInt> axes;
+  for (uInt dim = 0; dim < ndim; dim++) {
+    if (whichAxes(dim) == True && latticeShape(dim) > 1) {
+      axes.push_back(dim);
+    }
+  }
+  std::vector<FFTServer<typename NumericTraits<ComplexType>::ConjugateType,
+                        ComplexType>> ffts(nthreads);
+  size_t next = 0;
+  while (next < axes.size()) {
+    // Find the axes to transform in this pass. The first one is always
+    // done; if even a slab of lines does not fit, this is the line by
+    // line transform.
+    IPosition slabShape(ndim);
+    for (uInt dim = 0; dim < ndim; dim++) {
+      slabShape(dim) = std::min(tileShape(dim), latticeShape(dim));
+    }
+    std::vector<uInt> passAxes;
+    while (next < axes.size()) {
+      IPosition trial(slabShape);
+      trial(axes[next]) = latticeShape(axes[next]);
+      if (! passAxes.empty() && Long(trial.product()) > budget) {
+        break;
+      }
+      slabShape = trial;
+      passAxes.push_back(axes[next++]);
+    }
+    if (Long(slabShape.product()) > budget) {
+      for (uInt dim = 0; dim < ndim; dim++) {
+        if (dim != passAxes[0]) {
+          slabShape(dim) = 1;
+        }
+      }
+    }
+    // Read a batch of slabs, transform them in parallel, and write them.
+    LatticeStepper stepper(latticeShape, slabShape, LatticeStepper::RESIZE);
+    std::vector<Slicer> slicers;
+    std::vector<Array<ComplexType>> slabs;
+    stepper.reset();
+    while (! stepper.atEnd()) {
+      slicers.clear();
+      slabs.clear();
+      for (; !stepper.atEnd() && slicers.size() < nthreads; stepper++) {
+        slicers.push_back(Slicer(stepper.position(), stepper.endPosition(),
+                                 Slicer::endIsLast));
+        slabs.push_back(cLattice.getSlice(slicers.back()));
+      }
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads)
+#endif
+      for (Int k = 0; k < Int(slabs.size()); k++) {
+        try {
+          auto& server = ffts[OMP::threadNum()];
+          for (uInt axis : passAxes) {
+            VectorIterator<ComplexType> iter(slabs[k], axis);
+            while (! iter.pastEnd()) {
+              if (doShift) {
+                server.fft(iter.vector(), toFrequency);
+              } else {
+                server.fft0(iter.vector(), toFrequency);
+              }
+              iter.next();
+            }
+          }
+        } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeFFT_cfftSlabs)
+#endif
+          {
+            if (! error) {
+              error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      for (size_t k = 0; k < slabs.size(); k++) {
+        cLattice.putSlice(slabs[k], slicers[k].start());
+      }
+    }
+  }
+}
+
 template <class ComplexType> void LatticeFFT::cfft(
     Lattice<ComplexType>& cLattice, const Bool toFrequency
 ) {
@@ -183,6 +295,15 @@ template <class ComplexType> void LatticeFFT::rcfft(
 	      out.copyData(LatticeExpr<ComplexType>(in));
 	    }
 	  }
+	  else if (out.isPaged()) {
+	    // Do all complex->complex transforms in slabs
+	    Vector<Bool> otherAxes(whichAxes.copy());
+	    for (uInt k = 0; k <= firstAxis; k++) {
+	      otherAxes(k) = False;
+	    }
+	    LatticeFFT::cfftSlabs(out, otherAxes, True, doShift && !doFast);
+	    break;
+	  }
 	  else { // Do complex->complex transforms
 	    if (inShape(dim) != 1) { 
 	      LatticeIterator<ComplexType> iter(out,
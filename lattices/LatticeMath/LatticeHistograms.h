@@ -37,6 +37,8 @@
 #include <casacore/casa/System/PGPlotter.h>
 #include <casacore/scimath/Mathematics/NumericTraits.h>
 #include <casacore/casa/iosfwd.h>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -289,6 +291,16 @@ public:
 // lattice had an invalid type or that the internal status of the class is bad.
    Bool setNewLattice (const MaskedLattice<T>& lattice);
 
+// Use the given statistics object (made for the same lattice) to get the
+// data range of each histogram. Its storage lattice is shared, so the
+// lattice is not read again for the statistics if the cursor axes and
+// include range match those of this object (where the min and max must
+// be set to the include range).
+// Otherwise the statistics are recalculated as usual.
+// A return value of <src>False</src> indicates that the internal status
+// of the class is bad.
+   Bool setStatistics (const LatticeStatistics<T>& stats);
+
 // These things are protected only so that they are available to ImageHistograms
 // which inherits from LatticeHistograms
 
@@ -492,12 +504,26 @@ public:
 // Can handle null mask
    virtual Bool canHandleNullMask() const {return True;};
 
+// Make a collapser using the same statistics object, so the tiles
+// can be processed in parallel.
+    virtual TiledCollapser<T,T>* clone() const;
+
+// Add the histograms of a collapser made by <src>clone</src>.
+    virtual void merge (const TiledCollapser<T,T>& other);
+
 private:
     LatticeStatistics<T>* pStats_p;
     Block<T>* pHist_p;
     uInt nBins_p;
     uInt64 n1_p;
     uInt64 n3_p;
+// The data range of each histogram in the accumulator. It is obtained
+// once from the statistics object; the mutex (shared by the clones)
+// serializes the access to it.
+    Block<T> clipMin_p;
+    Block<T> clipMax_p;
+    Block<Bool> haveClip_p;
+    std::shared_ptr<std::mutex> statsMutex_p;
 };
  
 
@@ -173,7 +173,8 @@ LatticeHistograms<T> &LatticeHistograms<T>::operator=(const LatticeHistograms<T>
       if (pInLattice_p!=0) delete pInLattice_p;
       pInLattice_p = other.pInLattice_p->cloneML();
       
-// Delete storage and statistics objects.
+// Delete storage object and copy the statistics object (which shares
+// its storage lattice).
 
       if (pStoreLattice_p != 0) {
          delete pStoreLattice_p;
@@ -184,6 +185,9 @@ LatticeHistograms<T> &LatticeHistograms<T>::operator=(const LatticeHistograms<T>
          delete pStats_p;
          pStats_p = 0;
       }
+      if (other.pStats_p != 0) {
+         pStats_p = new LatticeStatistics<T>(*other.pStats_p);
+      }
       needStorageLattice_p = True;
 
 // Do the rest
@@ -477,14 +481,34 @@ Bool LatticeHistograms<T>::setNewLattice(const MaskedLattice<T>& lattice)
 
 
 // Signal that we have changed the lattice and need a new accumulation
-// lattice
+// lattice and statistics
 
+   if (pStats_p != 0) {
+      delete pStats_p;
+      pStats_p = 0;
+   }
    needStorageLattice_p = True;
 
    return True;
 }
 
 
+template <class T>
+Bool LatticeHistograms<T>::setStatistics(const LatticeStatistics<T>& stats)
+{
+   if (!goodParameterStatus_p) {
+      return False;
+   }
+
+// The copy shares the storage lattice of the statistics.
+
+   if (pStats_p != 0) delete pStats_p;
+   pStats_p = new LatticeStatistics<T>(stats);
+   needStorageLattice_p = True;
+   return True;
+}
+
+
 template <class T>
 void LatticeHistograms<T>::closePlotting()
 {  
@@ -1030,10 +1054,13 @@ template <class T>
 Bool LatticeHistograms<T>::makeStatistics()
 {
 
-// Create LatticeStatistics object.  Show progress meter.
+// Create LatticeStatistics object if not done yet.  Show progress meter.
+// An existing one (possibly set by setStatistics) only recalculates the
+// statistics if the settings below differ from its current settings.
 
-   if (pStats_p != 0) delete pStats_p;
-   pStats_p = new LatticeStatistics<T>(*pInLattice_p, os_p, showProgress_p, forceDisk_p);
+   if (pStats_p == 0) {
+      pStats_p = new LatticeStatistics<T>(*pInLattice_p, os_p, showProgress_p, forceDisk_p);
+   }
 
 // Set state.  Make sure that the min/max is set to the
 // user's include range if there is one.  LatticeHistograms
@@ -1235,11 +1262,16 @@ void LatticeHistograms<T>::setStream (ostream& os, Int oPrec)
 template <class T>
 HistTiledCollapser<T>::HistTiledCollapser(LatticeStatistics<T>* pStats, uInt nBins)
 : pStats_p(pStats),
-  nBins_p(nBins)
+  pHist_p(0),
+  nBins_p(nBins),
+  statsMutex_p(std::make_shared<std::mutex>())
 {;}
    
 template <class T>
-HistTiledCollapser<T>::~HistTiledCollapser<T>() {}
+HistTiledCollapser<T>::~HistTiledCollapser<T>()
+{
+   delete pHist_p;
+}
 
 template <class T>
 void HistTiledCollapser<T>::init (uInt nOutPixelsPerCollapse)
@@ -1253,11 +1285,17 @@ void HistTiledCollapser<T>::initAccumulator (uInt64 n1, uInt64 n3)
 // pHist_p contains the histograms for each chunk
 // It is T not uInt so we can handle Complex types
 {
+   delete pHist_p;
    pHist_p = new Block<T>(nBins_p*n1*n3);
    pHist_p->set(0);
 //          
    n1_p = n1;
    n3_p = n3;
+//
+   clipMin_p.resize(n1*n3, True, False);
+   clipMax_p.resize(n1*n3, True, False);
+   haveClip_p.resize(n1*n3, True, False);
+   haveClip_p.set(False);
 }
 
 
@@ -1273,20 +1311,29 @@ void HistTiledCollapser<T>::process (
 // lattices
 
 // Fish out the min and max for this chunk of the data 
-// from the statistics object
-
-   typedef typename NumericTraits<T>::PrecisionType AccumType; 
-   Vector<AccumType> stats;
-   pStats_p->getStats(stats, startPos, True);
-   ThrowIf(
+// from the statistics object. They are the same for all chunks
+// of an accumulator entry, so they are only obtained once.
+
+   const uInt64 index = index1 + index3*n1_p;
+   if (! haveClip_p[index]) {
+      typedef typename NumericTraits<T>::PrecisionType AccumType; 
+      Vector<AccumType> stats;
+      {
+         std::lock_guard<std::mutex> lock(*statsMutex_p);
+         pStats_p->getStats(stats, startPos, True);
+      }
+      ThrowIf(
 		   stats.empty(),
 		   "Failed to compute statistics, if you set a range you have likely excluded all valid pixels"
-   );
-
+      );
 // Assignment from AccumType to T ok (e.g. Double to FLoat)
+      clipMin_p[index] = stats(LatticeStatsBase::MIN);
+      clipMax_p[index] = stats(LatticeStatsBase::MAX);
+      haveClip_p[index] = True;
+   }
    Vector<T> clip(2);
-   clip(0) = stats(LatticeStatsBase::MIN);
-   clip(1) = stats(LatticeStatsBase::MAX);
+   clip(0) = clipMin_p[index];
+   clip(1) = clipMax_p[index];
 // Set histogram bin width
    
    const T binWidth = LatticeHistSpecialize::setBinWidth(clip(0), clip(1), nBins_p);
@@ -1333,8 +1380,33 @@ void HistTiledCollapser<T>::endAccumulator(Array<T>& result,
     
     result.putStorage (res, deleteRes);
     delete pHist_p;
+    pHist_p = 0;
 }      
 
+template <class T>
+TiledCollapser<T,T>* HistTiledCollapser<T>::clone() const
+{
+   HistTiledCollapser<T>* coll = new HistTiledCollapser<T>(pStats_p, nBins_p);
+   coll->statsMutex_p = statsMutex_p;
+   return coll;
+}
+
+template <class T>
+void HistTiledCollapser<T>::merge (const TiledCollapser<T,T>& other)
+{
+   const HistTiledCollapser<T>* that =
+      dynamic_cast<const HistTiledCollapser<T>*>(&other);
+   ThrowIf(
+      ! that || that->pHist_p->nelements() != pHist_p->nelements(),
+      "HistTiledCollapser::merge: collapsers do not match"
+   );
+   T* histPtr = pHist_p->storage();
+   const T* otherPtr = that->pHist_p->storage();
+   for (uInt64 k=0; k<pHist_p->nelements(); k++) {
+      histPtr[k] += otherPtr[k];
+   }
+}
+
 } //# NAMESPACE CASACORE - END
 
 
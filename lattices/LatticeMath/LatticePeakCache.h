@@ -0,0 +1,174 @@
+//# LatticePeakCache.h: find the peak of a lattice, caching per-block peaks
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_LATTICEPEAKCACHE_H
+#define LATTICES_LATTICEPEAKCACHE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+template <class T> class Array;
+template <class T> class Lattice;
+
+
+// <summary>
+// Find the peak in a box of a lattice, caching the peak per block
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="tLatticePeakCache" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="Lattice">Lattice</linkto>
+//   <li> <linkto class="LatticeCleaner">LatticeCleaner</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A clean minor cycle searches the peak of the residual image, subtracts
+// a shifted PSF around it, and searches again. This class makes the
+// repeated search cheap. The box searched is divided into blocks, which
+// span the full box along the first axis and are aligned with the
+// lattice tiles along the other axes. The peak of each block is kept,
+// so after a subtraction only the blocks overlapping the changed region
+// (given by <src>setChanged</src>) need to be searched again. Changed
+// blocks are searched in parallel if OpenMP is used.
+//
+// The result is the same as scanning the box line by line along the
+// first axis, using the first line position if the peak occurs more than
+// once. An optional mask lattice gives weights the values are multiplied
+// with before the peak is determined.
+// <br>The lattice and mask are not copied, so they must stay alive as
+// long as the cache is used.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    LatticePeakCache<Float> peaks(residual, blc, trc);
+//    for (...) {
+//      Float peak;
+//      IPosition pos;
+//      peaks.find(peak, pos);
+//      // ... subtract the PSF in the box psfBlc,psfTrc of residual
+//      peaks.setChanged(psfBlc, psfTrc);
+//    }
+// </srcblock>
+// </example>
+
+template <class T> class LatticePeakCache
+{
+public:
+  // Define what kind of peak is searched.
+  enum PeakType {
+    // the (weighted) value with the largest absolute value
+    MAXABS,
+    // the value with the largest absolute value, where per line the
+    // candidates are the minimum and maximum of the weighted values
+    // (as used by LatticeCleaner if the mask values are weights)
+    MAXABS_UNWEIGHTED,
+    // the largest (weighted) value
+    MAX
+  };
+
+  // Create the cache for the box blc,trc of the lattice. The box is
+  // clipped to the lattice; an exception is thrown if it is empty.
+  // If given, the mask must have the same shape as the lattice.
+  // If <src>flipMask=True</src>, the weights are 1 minus the mask values.
+  LatticePeakCache (const Lattice<T>& lattice,
+		    const IPosition& blc, const IPosition& trc,
+		    const Lattice<T>* mask=0,
+		    PeakType type=MAXABS, Bool flipMask=False);
+
+  // Create the cache for the entire lattice.
+  explicit LatticePeakCache (const Lattice<T>& lattice,
+			     const Lattice<T>* mask=0,
+			     PeakType type=MAXABS, Bool flipMask=False);
+
+  // Tell that the values in the box blc,trc (in lattice coordinates)
+  // have changed. Without arguments, all values have changed.
+  // <group>
+  void setChanged (const IPosition& blc, const IPosition& trc);
+  void setChanged();
+  // </group>
+
+  // Get the peak value and its position in the lattice. Blocks
+  // changed since the previous call are searched again.
+  // If no value exceeds 0 in the sense of the peak type, the peak is 0 at
+  // position 0.
+  void find (T& peak, IPosition& pos);
+
+  // Get the number of blocks.
+  uInt nblocks() const
+    { return itsPeaks.size(); }
+
+  // Get the number of blocks searched by the last call of <src>find</src>.
+  uInt nsearched() const
+    { return itsNsearched; }
+
+private:
+  // Set up the blocks.
+  void init();
+
+  // Get the section of the lattice covered by the given block.
+  Slicer blockSection (uInt block) const;
+
+  // Find the peak in a block given its data and weights (or 0).
+  void findInBlock (T& peak, IPosition& pos, const IPosition& blc,
+		    const Array<T>& data, const Array<T>* weights) const;
+
+  // Is value a better peak than the current one?
+  Bool better (const T& value, const T& current) const;
+
+  const Lattice<T>* itsLattice;
+  const Lattice<T>* itsMask;
+  PeakType itsType;
+  Bool itsFlipMask;
+  IPosition itsBlc;
+  IPosition itsTrc;
+  // block size along each axis
+  IPosition itsBlockShape;
+  // number of blocks along each axis
+  IPosition itsNblock;
+  std::vector<T> itsPeaks;
+  std::vector<IPosition> itsPositions;
+  std::vector<Bool> itsChanged;
+  uInt itsNsearched;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/lattices/LatticeMath/LatticePeakCache.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
@@ -0,0 +1,319 @@
+//# LatticePeakCache.tcc: find the peak of a lattice, caching per-block peaks
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_LATTICEPEAKCACHE_TCC
+#define LATTICES_LATTICEPEAKCACHE_TCC
+
+#include <casacore/lattices/LatticeMath/LatticePeakCache.h>
+#include <casacore/lattices/Lattices/Lattice.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayPosIter.h>
+#include <casacore/casa/Arrays/VectorIter.h>
+#include <casacore/casa/Utilities/COWPtr.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/OS/OMP.h>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template <class T>
+LatticePeakCache<T>::LatticePeakCache (const Lattice<T>& lattice,
+				       const IPosition& blc,
+				       const IPosition& trc,
+				       const Lattice<T>* mask,
+				       PeakType type, Bool flipMask)
+: itsLattice  (&lattice),
+  itsMask     (mask),
+  itsType     (type),
+  itsFlipMask (flipMask),
+  itsBlc      (blc),
+  itsTrc      (trc),
+  itsNsearched(0)
+{
+  init();
+}
+
+template <class T>
+LatticePeakCache<T>::LatticePeakCache (const Lattice<T>& lattice,
+				       const Lattice<T>* mask,
+				       PeakType type, Bool flipMask)
+: itsLattice  (&lattice),
+  itsMask     (mask),
+  itsType     (type),
+  itsFlipMask (flipMask),
+  itsBlc      (lattice.ndim(), 0),
+  itsTrc      (lattice.shape() - 1),
+  itsNsearched(0)
+{
+  init();
+}
+
+template <class T>
+void LatticePeakCache<T>::init()
+{
+  const IPosition shape = itsLattice->shape();
+  const uInt ndim = shape.nelements();
+  if (itsMask  &&  ! itsMask->shape().isEqual (shape)) {
+    throw AipsError ("LatticePeakCache: mask and lattice shapes differ");
+  }
+  if (itsBlc.nelements() != ndim  ||  itsTrc.nelements() != ndim
+  ||  ndim == 0) {
+    throw AipsError ("LatticePeakCache: invalid box dimensionality");
+  }
+  // Clip the box to the lattice like LCBox does.
+  for (uInt i=0; i<ndim; ++i) {
+    itsBlc(i) = std::max (itsBlc(i), ssize_t(0));
+    itsTrc(i) = std::min (itsTrc(i), shape(i) - 1);
+    if (itsBlc(i) > itsTrc(i)) {
+      throw AipsError ("LatticePeakCache: box " + itsBlc.toString() +
+		       itsTrc.toString() + " is empty");
+    }
+  }
+  // A block contains entire lines of the box. For a paged lattice the
+  // blocks follow the tiles, otherwise they hold about 16384 pixels.
+  const Int width = itsTrc(0) - itsBlc(0) + 1;
+  itsBlockShape.resize (ndim);
+  itsBlockShape = 1;
+  itsBlockShape(0) = width;
+  if (itsLattice->isPaged()) {
+    const IPosition tileShape = itsLattice->niceCursorShape();
+    for (uInt i=1; i<ndim; ++i) {
+      itsBlockShape(i) = std::max (ssize_t(1), tileShape(i));
+    }
+  } else if (ndim > 1) {
+    itsBlockShape(1) = std::max (1, 16384 / width);
+  }
+  // The blocks along the other axes are aligned with the lattice origin.
+  itsNblock.resize (ndim);
+  itsNblock = 1;
+  for (uInt i=1; i<ndim; ++i) {
+    itsNblock(i) = itsTrc(i) / itsBlockShape(i) -
+                   itsBlc(i) / itsBlockShape(i) + 1;
+  }
+  const uInt nblock = itsNblock.product();
+  itsPeaks.assign (nblock, T(0));
+  itsPositions.assign (nblock, IPosition(ndim, 0));
+  itsChanged.assign (nblock, True);
+}
+
+template <class T>
+void LatticePeakCache<T>::setChanged (const IPosition& blc,
+				      const IPosition& trc)
+{
+  const uInt ndim = itsBlc.nelements();
+  IPosition first(ndim, 0);
+  IPosition last(ndim, 0);
+  for (uInt i=0; i<ndim; ++i) {
+    const Int st = std::max (blc(i), itsBlc(i));
+    const Int end = std::min (trc(i), itsTrc(i));
+    if (st > end) {
+      return;                     // box does not overlap
+    }
+    // Along the first axis there is only one block.
+    if (i > 0) {
+      const Int offset = itsBlc(i) / itsBlockShape(i);
+      first(i) = st / itsBlockShape(i) - offset;
+      last(i) = end / itsBlockShape(i) - offset;
+    }
+  }
+  // Mark all blocks between first and last.
+  ArrayPositionIterator iter(last - first + 1, 0);
+  for (; ! iter.pastEnd(); iter.next()) {
+    itsChanged[toOffsetInArray (first + iter.pos(), itsNblock)] = True;
+  }
+}
+
+template <class T>
+void LatticePeakCache<T>::setChanged()
+{
+  std::fill (itsChanged.begin(), itsChanged.end(), True);
+}
+
+template <class T>
+Slicer LatticePeakCache<T>::blockSection (uInt block) const
+{
+  const uInt ndim = itsBlc.nelements();
+  const IPosition index = toIPositionInArray (block, itsNblock);
+  IPosition start(itsBlc);
+  IPosition end(itsTrc);
+  for (uInt i=1; i<ndim; ++i) {
+    const Int first = (itsBlc(i) / itsBlockShape(i) + index(i)) *
+                      itsBlockShape(i);
+    start(i) = std::max (itsBlc(i), ssize_t(first));
+    end(i) = std::min (itsTrc(i), ssize_t(first + itsBlockShape(i) - 1));
+  }
+  return Slicer(start, end, Slicer::endIsLast);
+}
+
+template <class T>
+void LatticePeakCache<T>::find (T& peak, IPosition& pos)
+{
+  std::vector<uInt> todo;
+  for (uInt k=0; k<itsChanged.size(); ++k) {
+    if (itsChanged[k]) {
+      todo.push_back (k);
+    }
+  }
+  itsNsearched = todo.size();
+  // Read the blocks serially (a lattice cannot be read by multiple
+  // threads) and search them in parallel. For an in-memory lattice the
+  // blocks are references, so all can be done at once; otherwise a few
+  // blocks per thread are read at a time.
+  const uInt nbatch = (itsLattice->isPaged() ?  2 * OMP::maxThreads() :
+		       std::max (size_t(1), todo.size()));
+  for (uInt first=0; first<todo.size(); first+=nbatch) {
+    const uInt n = std::min (size_t(nbatch), todo.size() - first);
+    std::vector<COWPtr<Array<T> > > data(n);
+    std::vector<COWPtr<Array<T> > > weights(itsMask ? n : 0);
+    std::vector<IPosition> blcs(n);
+    for (uInt j=0; j<n; ++j) {
+      const Slicer section = blockSection (todo[first+j]);
+      blcs[j] = section.start();
+      itsLattice->getSlice (data[j], section);
+      if (itsMask) {
+	itsMask->getSlice (weights[j], section);
+      }
+    }
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+    for (Int j=0; j<Int(n); ++j) {
+      try {
+	const uInt k = todo[first+j];
+	findInBlock (itsPeaks[k], itsPositions[k], blcs[j], *data[j],
+		     itsMask ? &(*weights[j]) : 0);
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticePeakCache_find)
+#endif
+	{
+	  if (! error) {
+	    error = std::current_exception();
+	  }
+	}
+      }
+    }
+    if (error) {
+      std::rethrow_exception (error);
+    }
+    for (uInt j=0; j<n; ++j) {
+      itsChanged[todo[first+j]] = False;
+    }
+  }
+  // Combine the block peaks in the order the lines are scanned.
+  peak = T(0);
+  pos.resize (itsBlc.nelements());
+  pos = 0;
+  for (uInt k=0; k<itsPeaks.size(); ++k) {
+    if (better (itsPeaks[k], peak)) {
+      peak = itsPeaks[k];
+      pos = itsPositions[k];
+    }
+  }
+}
+
+template <class T>
+Bool LatticePeakCache<T>::better (const T& value, const T& current) const
+{
+  if (itsType == MAX) {
+    return value > current;
+  }
+  return abs(value) > abs(current);
+}
+
+template <class T>
+void LatticePeakCache<T>::findInBlock (T& peak, IPosition& pos,
+				       const IPosition& blc,
+				       const Array<T>& data,
+				       const Array<T>* weights) const
+{
+  peak = T(0);
+  pos = blc;
+  ReadOnlyVectorIterator<T> iter(data);
+  std::unique_ptr<ReadOnlyVectorIterator<T> > witer;
+  if (weights) {
+    witer.reset (new ReadOnlyVectorIterator<T>(*weights));
+  }
+  const uInt n = data.shape()(0);
+  for (; ! iter.pastEnd(); iter.next()) {
+    const Vector<T>& line = iter.vector();
+    // Determine the first minimum and maximum of the (weighted) line
+    // values like minMax and minMaxMasked do.
+    uInt minp = 0;
+    uInt maxp = 0;
+    T minv, maxv;
+    if (witer) {
+      const Vector<T>& wline = witer->vector();
+      for (uInt i=0; i<n; ++i) {
+	const T v = line(i) * (itsFlipMask ? T(1) - wline(i) : wline(i));
+	if (i == 0) {
+	  minv = maxv = v;
+	} else if (v < minv) {
+	  minv = v;
+	  minp = i;
+	} else if (v > maxv) {
+	  maxv = v;
+	  maxp = i;
+	}
+      }
+      witer->next();
+    } else {
+      minv = maxv = line(0);
+      for (uInt i=1; i<n; ++i) {
+	const T v = line(i);
+	if (v < minv) {
+	  minv = v;
+	  minp = i;
+	} else if (v > maxv) {
+	  maxv = v;
+	  maxp = i;
+	}
+      }
+    }
+    if (itsType == MAXABS_UNWEIGHTED) {
+      minv = line(minp);
+      maxv = line(maxp);
+    }
+    if (itsType != MAX  &&  better (minv, peak)) {
+      peak = minv;
+      pos = blc + iter.pos();
+      pos(0) += minp;
+    }
+    if (better (maxv, peak)) {
+      peak = maxv;
+      pos = blc + iter.pos();
+      pos(0) += maxp;
+    }
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
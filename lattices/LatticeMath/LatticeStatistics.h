@@ -226,15 +226,17 @@ public:
                       Bool forceDisk=False,
                       Bool clone=True);
 
-// Copy constructor.  Copy semantics are followed.  Therefore any storage lattice 
-// that has already been created for <src>other</src> is copied to <src>*this</src>
+// Copy constructor.  Copy semantics are followed, but any storage lattice
+// that has already been created for <src>other</src> is shared with
+// <src>*this</src>, so the statistics do not need to be calculated again.
+// An object makes a new storage lattice when its settings change.
    LatticeStatistics(const LatticeStatistics<T> &other);
 
 // Destructor
    virtual ~LatticeStatistics ();
 
-// Assignment operator.  Deletes any storage lattice associated with
-// the object being assigned to and copies any storage lattice that has
+// Assignment operator.  Releases any storage lattice associated with
+// the object being assigned to and shares any storage lattice that has
 // already been created for "other".
    LatticeStatistics<T> &operator=(const LatticeStatistics<T> &other);
 
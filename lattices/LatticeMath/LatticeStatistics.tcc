@@ -171,7 +171,7 @@ LatticeStatistics<T>::LatticeStatistics(const LatticeStatistics<T> &other)
           ? new LatticeStatsAlgorithm(*other._latticeStatsAlgortihm) : nullptr
   )
 //
-// Copy constructor.  Storage lattice is not copied.
+// Copy constructor.  Storage lattice is shared.
 //
 {
    operator=(other);
@@ -180,7 +180,7 @@ LatticeStatistics<T>::LatticeStatistics(const LatticeStatistics<T> &other)
 template <class T>
 LatticeStatistics<T> &LatticeStatistics<T>::operator=(const LatticeStatistics<T> &other)
 //
-// Assignment operator.  Storage lattice is not copied
+// Assignment operator.  Storage lattice is shared
 //
 {
    if (this != &other) {
@@ -189,11 +189,12 @@ LatticeStatistics<T> &LatticeStatistics<T>::operator=(const LatticeStatistics<T>
 
       _inLatPtrMgr.reset(other.pInLattice_p->cloneML());
       pInLattice_p = _inLatPtrMgr.get();
-// Delete storage lattice 
+// Share the storage lattice. It is not changed once made (apart from
+// adding the quantiles, which are the same for both objects), because
+// a new one is made if the settings change.
 
-      pStoreLattice_p.reset();
-
-      needStorageLattice_p = True;
+      pStoreLattice_p = other.pStoreLattice_p;
+      needStorageLattice_p = other.needStorageLattice_p;
 // Do the rest
 
       os_p = other.os_p;
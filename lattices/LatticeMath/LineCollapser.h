@@ -132,6 +132,13 @@ public:
 			       const Vector<T>& line,
 			       const Vector<Bool>& mask,
 			       const IPosition& pos) = 0;
+
+// Make a new collapser with the same settings as this one.
+// It is used by <src>LatticeApply::lineApply</src> to process the lines
+// in parallel; each thread uses its own collapser.
+// <br>The default implementation returns a null pointer, meaning that
+// the lines are processed sequentially.
+    virtual LineCollapser<T,U>* clone() const;
 };
 
 
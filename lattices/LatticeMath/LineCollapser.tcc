@@ -42,6 +42,12 @@ Bool LineCollapser<T,U>::canHandleNullMask() const
     return False;
 }
 
+template<class T, class U>
+LineCollapser<T,U>* LineCollapser<T,U>::clone() const
+{
+    return 0;
+}
+
 } //# NAMESPACE CASACORE - END
 
 
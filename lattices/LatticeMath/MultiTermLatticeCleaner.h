@@ -30,10 +30,13 @@
 
 #include <casacore/casa/aips.h>
 #include <casacore/lattices/LatticeMath/LatticeCleaner.h>
+#include <casacore/lattices/LatticeMath/LatticePeakCache.h>
 #include <casacore/lattices/Lattices/LatticeIterator.h>
 #include <casacore/lattices/LEL/LatticeExpr.h>
 #include <casacore/lattices/LEL/LatticeExprNode.h>
 
+#include <memory>
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template<class T> class MultiTermLatticeCleaner : public LatticeCleaner<T>
@@ -179,12 +182,17 @@ private:
   
   LatticeExprNode len_p;
 
+  // Peaks of the masked residual R_{00} per block, so that after an update
+  // of the solution only the updated region is searched again.
+  std::unique_ptr<LatticePeakCache<Float> > residualPeaks_p;
+
   Float lambda_p;
   
   Int numberOfTempLattices(Int nscales,Int ntaylor);
   Int manageMemory(Bool allocate);
   
   Bool findMaxAbsLattice(const TempLattice<Float>& masklat,const Lattice<Float>& lattice,Float& maxAbs,IPosition& posMaxAbs, Bool flip=False);
+  Bool findMaxResidual(Float& maxAbs, IPosition& posMaxAbs);
   Int addTo(Lattice<Float>& to, const Lattice<Float>& add, Float multiplier);
 
   Int setupFFTMask();
@@ -337,7 +337,7 @@ Int MultiTermLatticeCleaner<T>::mtclean(LatticeCleanProgress* progress)
     /* Compute peak residuals */
     Float maxres=0.0;
     IPosition maxrespos;
-    findMaxAbsLattice((*mask_p),(*matR_p[IND2(0,0)]),maxres,maxrespos);
+    findMaxResidual(maxres,maxrespos);
     Float norma = (1.0/(*matA_p[0])(0,0));
     Float rmaxval = maxres*norma;
     
@@ -390,6 +390,8 @@ Int MultiTermLatticeCleaner<T>::mtclean(LatticeCleanProgress* progress)
      for(Int taylor=0;taylor<ntaylor_p;taylor++) os << "Taylor " << taylor << " has total flux = " << totalTaylorFlux_p[taylor] << LogIO::POST;
   }
   
+  /* The residuals can change before the next call */
+  residualPeaks_p.reset();
   return(convergedflag);
 }
 
@@ -935,6 +937,7 @@ Int MultiTermLatticeCleaner<T>::computeRHS()
 	   }
 	}
 	
+	residualPeaks_p.reset(new LatticePeakCache<Float>(*matR_p[IND2(0,0)], mask_p, LatticePeakCache<Float>::MAX));
 	return 0;
 }/* end of computeRHS() */
 
@@ -988,7 +991,7 @@ Int MultiTermLatticeCleaner<T>::computeFluxLimit(Float &fluxlimit, Float thresho
 
 	Float maxres=0.0;
 	IPosition maxrespos;
-	findMaxAbsLattice((*mask_p),(*matR_p[IND2(0,0)]),maxres,maxrespos);
+	findMaxResidual(maxres,maxrespos);
 	Float norma = (1.0/(*matA_p[0])(0,0));
 	Float rmaxval = maxres*norma;
 
@@ -1108,6 +1111,7 @@ Int MultiTermLatticeCleaner<T>::updateSolution(IPosition globalmaxpos, Int maxsc
 		   addTo(residSub,smoothSub,-1*loopgain*(*matCoeffs_p[IND2(taylor2,maxscaleindex)]).getAt(globalmaxpos));
 	   }
    }
+   if(residualPeaks_p) residualPeaks_p->setChanged(blc,trc);
    
    /* Update flux counters */
    for(Int taylor=0;taylor<ntaylor_p;taylor++)
@@ -1137,7 +1141,7 @@ Int MultiTermLatticeCleaner<T>::checkConvergence(Bool choosespec, Float thresh,
     /* Use the maximum residual (current), to compare against the convergence threshold */
     Float maxres=0.0;
     IPosition maxrespos;
-    findMaxAbsLattice((*mask_p),(*matR_p[IND2(0,0)]),maxres,maxrespos);
+    findMaxResidual(maxres,maxrespos);
     Float norma = (1.0/(*matA_p[0])(0,0));
     
     //rmaxval = MAX(rmaxval, maxres*norma/5.0);
@@ -1189,40 +1193,22 @@ Bool MultiTermLatticeCleaner<T>::findMaxAbsLattice(const TempLattice<Float>& mas
 
   AlwaysAssert(masklat.shape()==lattice.shape(), AipsError);
 
-  Array<Float> msk;
-  
-  posMaxAbs = IPosition(lattice.shape().nelements(), 0);
-  maxAbs=0.0;
-  //maxAbs=-1.0e+10;
-  const IPosition tileShape = lattice.niceCursorShape();
-  TiledLineStepper ls(lattice.shape(), tileShape, 0);
-  TiledLineStepper lsm(masklat.shape(), tileShape, 0);
-  {
-    RO_LatticeIterator<Float> li(lattice, ls);
-    RO_LatticeIterator<Float> lim(masklat, lsm);
-    for(li.reset(),lim.reset();!li.atEnd();li++,lim++) 
-    {
-      IPosition posMax=li.position();
-      IPosition posMin=li.position();
-      Float maxVal=0.0;
-      Float minVal=0.0;
-      
-      msk = lim.cursor();
-      if(flip) msk = (Float)1.0 - msk;
-      
-      //minMaxMasked(minVal, maxVal, posMin, posMax, li.cursor(),lim.cursor());
-      minMaxMasked(minVal, maxVal, posMin, posMax, li.cursor(),msk);
-      
-      
-      if((maxVal)>(maxAbs)) 
-      {
-        maxAbs=maxVal;
-	posMaxAbs=li.position();
-	posMaxAbs(0)=posMax(0);
-      }
-    }
-  }
+  LatticePeakCache<Float> peaks(lattice, &masklat, LatticePeakCache<Float>::MAX, flip);
+  peaks.find(maxAbs, posMaxAbs);
+
+  return True;
+}
 
+/*************************************
+ *         Find the max and position of the masked residual R_{00}
+ *         - only the blocks changed since the last search are searched.
+ *************************************/
+template <class T>
+Bool MultiTermLatticeCleaner<T>::findMaxResidual(Float& maxAbs,IPosition& posMaxAbs)
+{
+  if(!residualPeaks_p)
+    return findMaxAbsLattice((*mask_p),(*matR_p[IND2(0,0)]),maxAbs,posMaxAbs);
+  residualPeaks_p->find(maxAbs, posMaxAbs);
   return True;
 }
 
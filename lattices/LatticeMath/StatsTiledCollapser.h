@@ -145,6 +145,14 @@ public:
     // Can handle null mask
     virtual Bool canHandleNullMask() const {return True;};
 
+    // Make a collapser with the same pixel selection.
+    virtual TiledCollapser<T,U>* clone() const;
+
+    // Merge the accumulator of a collapser made by <src>clone</src>.
+    // The statistics are combined using the pairwise update formulae
+    // of Chan et al., so the variance stays accurate.
+    virtual void merge (const TiledCollapser<T,U>& other);
+
     // Find the location of the minimum and maximum data values
     // in the input lattice.
      void minMaxPos(IPosition& minPos, IPosition& maxPos);
@@ -199,6 +199,71 @@ void StatsTiledCollapser<T,U>::process (
     }
 }
 
+template <class T, class U>
+TiledCollapser<T,U>* StatsTiledCollapser<T,U>::clone() const {
+    return new StatsTiledCollapser<T,U>(
+        _range, ! _include, ! _exclude, _fixedMinMax
+    );
+}
+
+template <class T, class U>
+void StatsTiledCollapser<T,U>::merge (const TiledCollapser<T,U>& other) {
+    const StatsTiledCollapser<T,U>* that =
+        dynamic_cast<const StatsTiledCollapser<T,U>*>(&other);
+    ThrowIf(
+        ! that || that->_n1 != _n1 || that->_n3 != _n3,
+        "StatsTiledCollapser::merge: collapsers do not match"
+    );
+    Bool minUpdated = False;
+    Bool maxUpdated = False;
+    for (uInt64 i=0; i<_n1*_n3; ++i) {
+        Double nb = (*that->_npts)[i];
+        if (nb == 0) {
+            continue;
+        }
+        Double na = (*_npts)[i];
+        if (na == 0) {
+            (*_npts)[i] = nb;
+            (*_sum)[i] = (*that->_sum)[i];
+            (*_sumSq)[i] = (*that->_sumSq)[i];
+            (*_mean)[i] = (*that->_mean)[i];
+            (*_nvariance)[i] = (*that->_nvariance)[i];
+            (*_variance)[i] = (*that->_variance)[i];
+            (*_sigma)[i] = (*that->_sigma)[i];
+            (*_min)[i] = (*that->_min)[i];
+            (*_max)[i] = (*that->_max)[i];
+            minUpdated = maxUpdated = True;
+            continue;
+        }
+        Double n = na + nb;
+        U delta = (*that->_mean)[i] - (*_mean)[i];
+        (*_mean)[i] += delta * U(nb/n);
+        (*_nvariance)[i] += (*that->_nvariance)[i] + delta*delta*U(na*nb/n);
+        (*_sum)[i] += (*that->_sum)[i];
+        (*_sumSq)[i] += (*that->_sumSq)[i];
+        (*_npts)[i] = n;
+        (*_variance)[i] = n > 1 ? (*_nvariance)[i]/U(n - 1) : U(0);
+        (*_sigma)[i] = sqrt((*_variance)[i]);
+        if ((*that->_min)[i] < (*_min)[i]) {
+            (*_min)[i] = (*that->_min)[i];
+            minUpdated = True;
+        }
+        if ((*that->_max)[i] > (*_max)[i]) {
+            (*_max)[i] = (*that->_max)[i];
+            maxUpdated = True;
+        }
+    }
+    // As in process, the positions are only updated for real data.
+    if (_isReal) {
+        if (minUpdated) {
+            _minpos = that->_minpos;
+        }
+        if (maxUpdated) {
+            _maxpos = that->_maxpos;
+        }
+    }
+}
+
 template <class T, class U>
 void StatsTiledCollapser<T,U>::endAccumulator(
     Array<U>& result, Array<Bool>& resultMask,
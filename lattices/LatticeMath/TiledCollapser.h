@@ -152,6 +152,23 @@ public:
     virtual void endAccumulator (Array<U>& result, 
                                  Array<Bool>& resultMask,
 				 const IPosition& shape) = 0;
+
+// Make a new collapser with the same settings as this one.
+// It is used by <src>LatticeApply::tiledApply</src> to process tiles
+// in parallel. It calls <src>initAccumulator</src> of the new collapser
+// before processing tiles with it, and thereafter merges its accumulator
+// into this collapser using function <src>merge</src>.
+// <br>The default implementation returns a null pointer, meaning that
+// the tiles are processed sequentially.
+    virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the accumulator of the given collapser (made by <src>clone</src>)
+// into the accumulator of this collapser. Both accumulators have the
+// same shape. The data processed by <src>other</src> come after the
+// data processed by this collapser, so the result can be the same as
+// when processing sequentially.
+// <br>The default implementation throws an exception.
+    virtual void merge (const TiledCollapser<T,U>& other);
 };
 
 
@@ -28,6 +28,7 @@
 
 
 #include <casacore/lattices/LatticeMath/TiledCollapser.h>
+#include <casacore/casa/Exceptions/Error.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -42,6 +43,18 @@ Bool TiledCollapser<T,U>::canHandleNullMask() const
     return False;
 }
 
+template<class T, class U>
+TiledCollapser<T,U>* TiledCollapser<T,U>::clone() const
+{
+    return 0;
+}
+
+template<class T, class U>
+void TiledCollapser<T,U>::merge (const TiledCollapser<T,U>&)
+{
+    throw AipsError ("TiledCollapser::merge is not implemented");
+}
+
 } //# NAMESPACE CASACORE - END
 
 
@@ -64,6 +64,7 @@ public:
 			  const Vector<Int>& vector,
 			  const Vector<Bool>& arrayMask,
 			  const IPosition& pos);
+    virtual LineCollapser<Int>* clone() const;
 };
 void MyLineCollapser::init (uInt nOutPixelsPerCollapse)
 {
@@ -113,6 +114,10 @@ void MyLineCollapser::multiProcess (Vector<Int>& result,
     result(1) = -result(0);
     resultMask(0) = resultMask(1) = fnd;
 }
+LineCollapser<Int>* MyLineCollapser::clone() const
+{
+    return new MyLineCollapser();
+}
 
 
 class MyTiledCollapser : public TiledCollapser<Int>
@@ -130,6 +135,8 @@ public:
     virtual void endAccumulator (Array<Int>& result,
 				 Array<Bool>& resultMask,
 				 const IPosition& shape);
+    virtual TiledCollapser<Int>* clone() const;
+    virtual void merge (const TiledCollapser<Int>& other);
 private:
     Matrix<uInt>* itsSum1;
     Block<Int>*   itsSum2;
@@ -149,6 +156,9 @@ void MyTiledCollapser::init (uInt nOutPixelsPerCollapse)
 }
 void MyTiledCollapser::initAccumulator (uInt64 n1, uInt64 n3)
 {
+    delete itsSum1;
+    delete itsSum2;
+    delete itsNpts;
     itsSum1 = new Matrix<uInt> (n1, n3);
     itsSum2 = new Block<Int> (n1*n3);
     itsNpts = new Matrix<uInt> (n1, n3);
@@ -220,6 +230,20 @@ void MyTiledCollapser::endAccumulator (Array<Int>& result,
     delete itsNpts;
     itsNpts = 0;
 }
+TiledCollapser<Int>* MyTiledCollapser::clone() const
+{
+    return new MyTiledCollapser();
+}
+void MyTiledCollapser::merge (const TiledCollapser<Int>& other)
+{
+    const MyTiledCollapser& that = dynamic_cast<const MyTiledCollapser&>(other);
+    AlwaysAssert (that.itsn1 == itsn1  &&  that.itsn3 == itsn3, AipsError);
+    *itsSum1 += *that.itsSum1;
+    *itsNpts += *that.itsNpts;
+    for (uInt64 i=0; i<itsn1*itsn3; i++) {
+	(*itsSum2)[i] += (*that.itsSum2)[i];
+    }
+}
 
 
 class MyLatticeProgress : public LatticeProgress
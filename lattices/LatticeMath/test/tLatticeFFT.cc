@@ -32,8 +32,10 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/lattices/LatticeMath/LatticeFFT.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
 #include <casacore/lattices/Lattices/LatticeIterator.h>
 #include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/casa/namespace.h>
@@ -174,6 +176,50 @@ int main() {
  	}
       }
     }
+    { // compare transforms of a disk-based lattice with small tiles
+      // with transforms of the same data in memory
+      const IPosition rShape(3,10,6,4);
+      const IPosition cShape(3,6,6,4);
+      const IPosition tileShape(3,3,2,2);
+      Array<Complex> cData(rShape);
+      Array<Float> rData(rShape);
+      Int k = 0;
+      for (auto& v : cData) {
+	v = Complex(k%7, (k*3)%5);
+	++k;
+      }
+      for (auto& v : rData) {
+	v = k%11;
+	++k;
+      }
+      Vector<Bool> whichAxes(3, True);
+      whichAxes(1) = False;
+      for (uInt i = 0; i < 2; i++) {
+	Bool shift = i==0;
+	{
+	  PagedArray<Complex> paged(TiledShape(rShape, tileShape));
+	  ArrayLattice<Complex> mem(rShape);
+	  paged.put(cData);
+	  mem.put(cData);
+	  if (shift) {
+	    LatticeFFT::cfft(paged, False);
+	    LatticeFFT::cfft(mem, False);
+	  } else {
+	    LatticeFFT::cfft0(paged, whichAxes, True);
+	    LatticeFFT::cfft0(mem, whichAxes, True);
+	  }
+	  AlwaysAssert(allNearAbs(paged.get(), mem.get(), 1E-4), AipsError);
+	}
+	{
+	  PagedArray<Complex> paged(TiledShape(cShape, tileShape));
+	  ArrayLattice<Complex> mem(cShape);
+	  ArrayLattice<Float> in(rData);
+	  LatticeFFT::rcfft(paged, in, shift);
+	  LatticeFFT::rcfft(mem, in, shift);
+	  AlwaysAssert(allNearAbs(paged.get(), mem.get(), 1E-3), AipsError);
+	}
+      }
+    }
     cout<< "OK"<< endl;
     return 0;
   } catch (std::exception& x) {
@@ -273,6 +273,21 @@ void do2DFloat (const Array<Float>& arr, LogIO& os)
       AlwaysAssert(histo.setNewLattice(subLat), AipsError);
       test2DFloat (histo, shape, nBin);
    }
+
+// Test setStatistics using already calculated statistics
+
+   {
+      LatticeStatistics<Float> stats(subLat, os, False, False);
+      AlwaysAssert(stats.setAxes(axes), AipsError);
+      Array<Double> npts;
+      AlwaysAssert(stats.getStatistic(npts, LatticeStatsBase::NPTS), AipsError);
+      AlwaysAssert(allEQ(npts, Double(nX)), AipsError);
+      LatticeHistograms<Float> histo2(subLat, os, False, False);
+      AlwaysAssert(histo2.setAxes(axes), AipsError);
+      AlwaysAssert(histo2.setNBins(n), AipsError);
+      AlwaysAssert(histo2.setStatistics(stats), AipsError);
+      test2DFloat (histo2, shape, nBin);
+   }
 }
 
 
@@ -0,0 +1,195 @@
+//# tLatticePeakCache.cc: test the LatticePeakCache class
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/LatticeMath/LatticePeakCache.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/VectorIter.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+
+#include <casacore/casa/namespace.h>
+
+// Find the peak in the box by scanning it line by line.
+void scanPeak (Float& peak, IPosition& pos, const Array<Float>& data,
+               const Array<Float>* mask, const IPosition& blc,
+               const IPosition& trc, LatticePeakCache<Float>::PeakType type,
+               Bool flip)
+{
+  peak = 0;
+  pos = IPosition(data.ndim(), 0);
+  Slicer section(blc, trc, Slicer::endIsLast);
+  Array<Float> values = data(section).copy();
+  if (mask) {
+    Array<Float> weights = (*mask)(section).copy();
+    if (flip) {
+      weights = Float(1) - weights;
+    }
+    values = values * weights;
+  }
+  ReadOnlyVectorIterator<Float> iter(values);
+  for (; ! iter.pastEnd(); iter.next()) {
+    Float minv, maxv;
+    IPosition minp, maxp;
+    minMax (minv, maxv, minp, maxp, iter.vector());
+    if (type == LatticePeakCache<Float>::MAXABS_UNWEIGHTED) {
+      IPosition p(blc + iter.pos());
+      p(0) += minp(0);
+      minv = data(p);
+      p(0) += maxp(0) - minp(0);
+      maxv = data(p);
+    }
+    if (type != LatticePeakCache<Float>::MAX  &&  abs(minv) > abs(peak)) {
+      peak = minv;
+      pos = blc + iter.pos();
+      pos(0) += minp(0);
+    }
+    if ((type == LatticePeakCache<Float>::MAX  &&  maxv > peak)  ||
+        (type != LatticePeakCache<Float>::MAX  &&  abs(maxv) > abs(peak))) {
+      peak = maxv;
+      pos = blc + iter.pos();
+      pos(0) += maxp(0);
+    }
+  }
+}
+
+void check (LatticePeakCache<Float>& peaks, const Lattice<Float>& lat,
+            const Lattice<Float>* mask, const IPosition& blc,
+            const IPosition& trc, LatticePeakCache<Float>::PeakType type,
+            Bool flip=False)
+{
+  Float peak, expPeak;
+  IPosition pos, expPos;
+  peaks.find (peak, pos);
+  Array<Float> maskArr;
+  if (mask) {
+    maskArr = mask->get();
+  }
+  scanPeak (expPeak, expPos, lat.get(), mask ? &maskArr : 0, blc, trc,
+            type, flip);
+  AlwaysAssertExit (peak == expPeak);
+  AlwaysAssertExit (pos.isEqual (expPos));
+}
+
+void doIt (Lattice<Float>& lat, Lattice<Float>& mask)
+{
+  const IPosition shape = lat.shape();
+  Array<Float> data(shape);
+  Array<Float> weights(shape);
+  // Use distinct absolute values, so the peak position does not depend
+  // on the order in which the lines are scanned.
+  const Int n = shape.product();
+  Int k = 0;
+  for (Array<Float>::iterator iter=data.begin(); iter!=data.end(); ++iter) {
+    *iter = ((k*37) % n) - 1000.25;
+    ++k;
+  }
+  for (Array<Float>::iterator iter=weights.begin(); iter!=weights.end();
+       ++iter) {
+    *iter = (k % 3) * 0.5;
+    ++k;
+  }
+  lat.put (data);
+  mask.put (weights);
+  const IPosition blc(3, 2, 3, 1);
+  const IPosition trc(shape - 3);
+  // Compare the peak of all types with a line by line scan.
+  for (uInt i=0; i<3; ++i) {
+    LatticePeakCache<Float>::PeakType type =
+      LatticePeakCache<Float>::PeakType(i);
+    LatticePeakCache<Float> whole(lat, 0, type);
+    check (whole, lat, 0, IPosition(3, 0), shape-1, type);
+    LatticePeakCache<Float> peaks(lat, blc, trc, &mask, type);
+    check (peaks, lat, &mask, blc, trc, type);
+    AlwaysAssertExit (peaks.nsearched() == peaks.nblocks());
+    LatticePeakCache<Float> flipped(lat, blc, trc, &mask, type, True);
+    check (flipped, lat, &mask, blc, trc, type, True);
+  }
+  // Change a region and check only the blocks overlapping it are searched.
+  LatticePeakCache<Float> peaks(lat, blc, trc);
+  check (peaks, lat, 0, blc, trc, LatticePeakCache<Float>::MAXABS);
+  Float peak;
+  IPosition pos;
+  peaks.find (peak, pos);
+  AlwaysAssertExit (peaks.nsearched() == 0);
+  const IPosition chgBlc(3, 9, 5, 2);
+  const IPosition chgTrc(3, 11, 7, 2);
+  Slicer section(chgBlc, chgTrc, Slicer::endIsLast);
+  lat.putSlice (Array<Float>(section.length(), Float(1000)), chgBlc);
+  peaks.setChanged (chgBlc, chgTrc);
+  check (peaks, lat, 0, blc, trc, LatticePeakCache<Float>::MAXABS);
+  AlwaysAssertExit (peaks.nsearched() > 0);
+  AlwaysAssertExit (peaks.nsearched() < peaks.nblocks());
+  // A change outside the box does not require a search.
+  lat.putAt (Float(-2000), IPosition(3, 0, 0, 0));
+  peaks.setChanged (IPosition(3, 0, 0, 0), IPosition(3, 0, 0, 0));
+  check (peaks, lat, 0, blc, trc, LatticePeakCache<Float>::MAXABS);
+  AlwaysAssertExit (peaks.nsearched() == 0);
+  // After a full change all blocks are searched.
+  lat.set (Float(-1));
+  peaks.setChanged();
+  check (peaks, lat, 0, blc, trc, LatticePeakCache<Float>::MAXABS);
+  AlwaysAssertExit (peaks.nsearched() == peaks.nblocks());
+}
+
+int main()
+{
+  try {
+    const IPosition shape(3, 12, 40, 6);
+    {
+      ArrayLattice<Float> lat(shape);
+      ArrayLattice<Float> mask(shape);
+      doIt (lat, mask);
+    }
+    {
+      PagedArray<Float> lat(TiledShape(shape, IPosition(3, 4, 5, 2)));
+      PagedArray<Float> mask(TiledShape(shape, IPosition(3, 4, 5, 2)));
+      doIt (lat, mask);
+    }
+    // A mask of a different shape is not allowed.
+    {
+      ArrayLattice<Float> lat(shape);
+      ArrayLattice<Float> mask(IPosition(3, 12, 40, 5));
+      Bool caught = False;
+      try {
+        LatticePeakCache<Float> peaks(lat, &mask);
+      } catch (const AipsError&) {
+        caught = True;
+      }
+      AlwaysAssertExit (caught);
+    }
+  } catch (const AipsError& x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
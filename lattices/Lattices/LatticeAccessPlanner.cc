@@ -0,0 +1,183 @@
+//# LatticeAccessPlanner.cc: Plan the tile access of a lattice traversal
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/Lattices/LatticeAccessPlanner.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
+#include <casacore/casa/Exceptions/Error.h>
+
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+LatticeAccessPlanner::LatticeAccessPlanner (const IPosition& latticeShape,
+                                            const IPosition& tileShape,
+                                            const IPosition& cursorShape,
+                                            const IPosition& blc,
+                                            const IPosition& trc,
+                                            const IPosition& increment)
+: itsLatticeShape (latticeShape),
+  itsTileShape    (tileShape),
+  itsCursorShape  (latticeShape.nelements(), 1),
+  itsBlc          (latticeShape.nelements(), 0),
+  itsTrc          (latticeShape - 1),
+  itsIncrement    (latticeShape.nelements(), 1),
+  itsNtiles       (latticeShape.nelements()),
+  itsNread        (latticeShape.nelements()),
+  itsStepTiles    (latticeShape.nelements())
+{
+  const uInt ndim = latticeShape.nelements();
+  if (tileShape.nelements() != ndim  ||  cursorShape.nelements() > ndim
+  ||  blc.nelements() > ndim  ||  trc.nelements() > ndim
+  ||  increment.nelements() > ndim) {
+    throw AipsError ("LatticeAccessPlanner: invalid dimensionality of "
+                     "tile, cursor or window");
+  }
+  for (uInt i=0; i<cursorShape.nelements(); ++i) {
+    itsCursorShape(i) = std::max (ssize_t(1), cursorShape(i));
+  }
+  for (uInt i=0; i<blc.nelements(); ++i) {
+    itsBlc(i) = std::max (ssize_t(0), std::min (blc(i), latticeShape(i)-1));
+  }
+  for (uInt i=0; i<trc.nelements(); ++i) {
+    itsTrc(i) = std::max (itsBlc(i), std::min (trc(i), latticeShape(i)-1));
+  }
+  for (uInt i=0; i<increment.nelements(); ++i) {
+    itsIncrement(i) = std::max (ssize_t(1), increment(i));
+  }
+  // Determine per axis the tiles read by the steps along it.
+  for (uInt i=0; i<ndim; ++i) {
+    const ssize_t tile = std::max (ssize_t(1), itsTileShape(i));
+    const ssize_t extent = (itsCursorShape(i) - 1) * itsIncrement(i) + 1;
+    const ssize_t stride = itsCursorShape(i) * itsIncrement(i);
+    ssize_t lastTile = -1;
+    itsNtiles(i) = 0;
+    itsNread(i) = 0;
+    itsStepTiles(i) = 0;
+    for (ssize_t st=itsBlc(i); st<=itsTrc(i); st+=stride) {
+      const ssize_t first = st / tile;
+      const ssize_t last = std::min (st + extent - 1, itsTrc(i)) / tile;
+      itsNread(i) += last - first + 1;
+      itsStepTiles(i) = std::max (itsStepTiles(i), last - first + 1);
+      itsNtiles(i) += last - std::max (first, lastTile + 1) + 1;
+      lastTile = last;
+    }
+  }
+}
+
+uInt64 LatticeAccessPlanner::workingSet (const IPosition& path, uInt n) const
+{
+  uInt64 nr = 1;
+  for (uInt i=0; i<path.nelements(); ++i) {
+    nr *= (i < n  ?  itsNtiles(path(i)) : itsStepTiles(path(i)));
+  }
+  return nr;
+}
+
+uInt64 LatticeAccessPlanner::tileReads (const IPosition& axisPath,
+                                        uInt cacheSize) const
+{
+  const IPosition path = IPosition::makeAxisPath (itsLatticeShape.nelements(),
+                                                  axisPath);
+  // Tiles are reused along the first axes in the path whose working set
+  // fits in the cache; along the other axes they are read again.
+  uInt64 nr = 1;
+  Bool cached = True;
+  for (uInt i=0; i<path.nelements(); ++i) {
+    cached = cached  &&  workingSet(path, i) <= cacheSize;
+    nr *= (cached  ?  itsNtiles(path(i)) : itsNread(path(i)));
+  }
+  return nr;
+}
+
+uInt LatticeAccessPlanner::cacheSize (const IPosition& axisPath,
+                                      uInt maxCacheSize) const
+{
+  const uInt ndim = itsLatticeShape.nelements();
+  const IPosition path = IPosition::makeAxisPath (ndim, axisPath);
+  // Determine how many axes can be cached; the cache for the first n axes
+  // must hold the working set of axis n-1.
+  uInt n = 0;
+  while (n < ndim  &&
+         (maxCacheSize == 0  ||  workingSet(path, n) <= maxCacheSize)) {
+    ++n;
+  }
+  // Take the smallest cache giving the same number of reads.
+  const uInt64 nread = tileReads (path, n == 0  ?  1 : workingSet(path, n-1));
+  uInt64 size = 1;
+  for (uInt i=0; i<=n; ++i) {
+    size = (i == 0  ?  1 : workingSet(path, i-1));
+    if (tileReads (path, size) == nread) {
+      break;
+    }
+  }
+  return std::min (size, uInt64(0xffffffff));
+}
+
+IPosition LatticeAccessPlanner::bestAxisPath (uInt maxCacheSize,
+                                              const IPosition& axisPath) const
+{
+  const uInt ndim = itsLatticeShape.nelements();
+  IPosition bestPath = IPosition::makeAxisPath (ndim, axisPath);
+  if (ndim > 6) {
+    return bestPath;
+  }
+  uInt bestSize = cacheSize (bestPath, maxCacheSize);
+  uInt64 bestReads = tileReads (bestPath, bestSize);
+  IPosition path = IPosition::makeAxisPath (ndim);
+  do {
+    const uInt size = cacheSize (path, maxCacheSize);
+    const uInt64 nread = tileReads (path, size);
+    if (nread < bestReads  ||  (nread == bestReads  &&  size < bestSize)) {
+      bestPath = path;
+      bestSize = size;
+      bestReads = nread;
+    }
+  } while (std::next_permutation (path.begin(), path.end()));
+  return bestPath;
+}
+
+LatticeStepper LatticeAccessPlanner::makeStepper (uInt maxCacheSize) const
+{
+  LatticeStepper stepper (itsLatticeShape, itsCursorShape,
+                          bestAxisPath (maxCacheSize));
+  stepper.subSection (itsBlc, itsTrc, itsIncrement);
+  return stepper;
+}
+
+uInt LatticeAccessPlanner::maxCacheSize (uInt maxCacheSizeMiB,
+                                         uInt bucketSize)
+{
+  if (maxCacheSizeMiB == 0  ||  bucketSize == 0) {
+    return 0;
+  }
+  const uInt64 maxnb = std::max (uInt64(1), uInt64(1024. * 1024. *
+                                                   maxCacheSizeMiB /
+                                                   bucketSize));
+  return std::min (uInt64(11 * maxnb / 10), uInt64(0xffffffff));
+}
+
+
+} //# NAMESPACE CASACORE - END
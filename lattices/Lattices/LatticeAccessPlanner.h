@@ -0,0 +1,161 @@
+//# LatticeAccessPlanner.h: Plan the tile access of a lattice traversal
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_LATTICEACCESSPLANNER_H
+#define LATTICES_LATTICEACCESSPLANNER_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class LatticeStepper;
+
+
+// <summary>
+// Plan the tile access of a lattice traversal
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tLatticeAccessPlanner.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=LatticeStepper>LatticeStepper</linkto>
+//   <li> <linkto class=TiledShape>TiledShape</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Iterating through a tiled lattice (e.g. a PagedArray) with a cursor
+// shape that does not match the tile shape can read each tile many times
+// if the tile cache is too small. This class determines for a traversal
+// as done by a <linkto class=LatticeStepper>LatticeStepper</linkto>
+// (i.e., a cursor shape stepping through a window of the lattice in the
+// order given by an axis path) how many tiles are read for a given
+// cache size.
+// <br>It uses the fact that the cache keeps the least recently used tiles.
+// When stepping along an axis, the tiles used by the previous step are
+// still in the cache if the cache can hold all tiles used by the full
+// sweep of the faster varying axes. So a tile is read only once along
+// those axes whose working set fits in the cache and is reread for each
+// step along the other axes.
+// <p>
+// Using this model it can determine:
+// <ul>
+//  <li> The smallest cache size giving the fewest tile reads for a given
+//       traversal order and maximum cache size. It is used by
+//       <src>LatticeStepper::calcCacheSize</src>, thus by default by the
+//       iterators of a PagedArray or PagedImage.
+//  <li> The traversal order needing the fewest tile reads. Note that the
+//       order in which a LatticeIterator visits the cursor positions changes
+//       if another order is used, so the order is only changed on request
+//       by making a LatticeStepper using <src>makeStepper</src>.
+// </ul>
+// The expected number of tile reads can be compared with the actual number
+// given by <src>RO_LatticeIterator::actualTileReads</src>.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   PagedArray<Float> pa("my.data");
+//   // Iterate through spectra in the order needing the fewest tile reads.
+//   LatticeAccessPlanner planner(pa.shape(), pa.tileShape(),
+//                                IPosition(3,1,1,pa.shape()(2)));
+//   RO_LatticeIterator<Float> iter(pa, planner.makeStepper(1000));
+//   for (iter.reset(); !iter.atEnd(); iter++) {
+//     ...
+//   }
+//   cout << iter.expectedTileReads() << ' ' << iter.actualTileReads() << endl;
+// </srcblock>
+// </example>
+
+class LatticeAccessPlanner
+{
+public:
+  // Plan the access of the lattice window blc,trc (default entire lattice)
+  // with the given cursor shape. The increment gives the stride in the
+  // window (default 1). Undefined cursor axes are set to 1 (as done by
+  // LatticeStepper).
+  LatticeAccessPlanner (const IPosition& latticeShape,
+                        const IPosition& tileShape,
+                        const IPosition& cursorShape,
+                        const IPosition& blc = IPosition(),
+                        const IPosition& trc = IPosition(),
+                        const IPosition& increment = IPosition());
+
+  // Get the number of tiles read when traversing in the order of the given
+  // (partial) axis path with a cache of the given size (in tiles).
+  uInt64 tileReads (const IPosition& axisPath, uInt cacheSize) const;
+
+  // Get the smallest cache size (in tiles) giving the fewest tile reads
+  // for the given axis path without exceeding the given maximum size.
+  // A maximum size of 0 means no maximum.
+  uInt cacheSize (const IPosition& axisPath, uInt maxCacheSize) const;
+
+  // Get the axis path needing the fewest tile reads for the given maximum
+  // cache size (0 is no maximum). If the number of reads is the same, the
+  // path needing the smallest cache is taken, while the given axis path is
+  // preferred over others. Only lattices with up to 6 axes are considered;
+  // otherwise the given path is returned.
+  IPosition bestAxisPath (uInt maxCacheSize,
+                          const IPosition& axisPath = IPosition()) const;
+
+  // Make a LatticeStepper with the best axis path for the given maximum
+  // cache size.
+  LatticeStepper makeStepper (uInt maxCacheSize) const;
+
+  // Get the maximum cache size (in tiles) from the maximum cache size
+  // of the storage manager (in MiB, 0 is no maximum) and the tile size
+  // (in bytes). An overdraft of 10% is allowed like
+  // <src>TSMCube::validateCacheSize</src> does.
+  static uInt maxCacheSize (uInt maxCacheSizeMiB, uInt bucketSize);
+
+private:
+  // Get the tiles needed to cache the tiles used by the sweep of the
+  // first n axes in the path.
+  uInt64 workingSet (const IPosition& path, uInt n) const;
+
+  IPosition itsLatticeShape;
+  IPosition itsTileShape;
+  IPosition itsCursorShape;
+  IPosition itsBlc;
+  IPosition itsTrc;
+  IPosition itsIncrement;
+  // Per axis the number of tiles in the window.
+  IPosition itsNtiles;
+  // Per axis the number of tiles read by all steps along it.
+  IPosition itsNread;
+  // Per axis the maximum number of tiles used by a single step.
+  IPosition itsStepTiles;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
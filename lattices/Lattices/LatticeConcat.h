@@ -31,12 +31,16 @@
 #include <casacore/casa/aips.h>
 #include <casacore/lattices/Lattices/MaskedLattice.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <list>
+#include <mutex>
+#include <set>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class IPosition;
-class Slicer;
 
 
 // <summary>
@@ -73,6 +77,16 @@ class Slicer;
 //
 // If you use the putSlice function, be aware that it will change the
 // underlying lattices if they are writable.
+//
+// A slice overlapping multiple lattices is read from each of them.
+// If all lattices are stored in different tables (e.g. a PagedImage
+// per channel), the parts are read in parallel (using OpenMP). Otherwise
+// (e.g. for HDF5 images) they are read serially.
+// <br>If tempClose is set, a lattice is opened when accessed and closed
+// afterwards. That can be costly if the lattices are read many times
+// (e.g. spectrum by spectrum). Using <src>setMaxOpen</src> the most
+// recently used lattices are kept open, so at most that many files are
+// open at the same time.
 // </synopsis>
 //
 // <example>
@@ -167,6 +181,15 @@ public:
    Bool isTempClose () const 
      {return tempClose_p;} 
 
+// Set the maximum number of lattices kept open if tempClose is set
+// (default 0). The lattices are opened when accessed and the least
+// recently used ones are closed if more are open.
+   void setMaxOpen (uInt maxOpen);
+
+// Returns the maximum number of lattices kept open.
+   uInt maxOpen () const
+     {return maxOpen_p;}
+
 // Returns the number of dimensions of the *input* lattices (may be different 
 // by one from output lattice).  Returns 0 if none yet set.
    uInt latticeDim() const;
@@ -250,13 +273,44 @@ public:
 
  
 private:
+// A part of a slice to be read from one of the lattices.
+   struct Part {
+      uInt      lattice;     // index of the lattice
+      Slicer    section;     // section in that lattice
+      IPosition blc, trc;    // section in the output buffer
+   };
+//
    PtrBlock<MaskedLattice<T>* > lattices_p;
    uInt axis_p;
    IPosition shape_p;
    Bool isMasked_p, dimUpOne_p, tempClose_p;
    LatticeConcat<Bool>* pPixelMask_p;
+// The maximum number of lattices kept open if tempClose is set and the
+// lattices currently kept open (most recently used first).
+   uInt maxOpen_p;
+   std::list<uInt> openLattices_p;
+   std::mutex openMutex_p;
+// Can the lattices be read in parallel (all in different tables)?
+   Bool canParallel_p;
+   std::set<String> fileNames_p;
 //
    void checkAxis(uInt axis, uInt ndim) const;
+//
+// Mark a lattice as being accessed, so it cannot be closed meanwhile.
+   void acquireLattice (uInt which);
+// Mark the end of the access to a lattice. If tempClose is set, the least
+// recently used lattices are closed if more than maxOpen are open.
+   void releaseLattice (uInt which);
+// Get the parts of the lattices to read for a section.
+// <group>
+   std::vector<Part> findParts1 (const Slicer& section, uInt nLattices) const;
+   std::vector<Part> findParts2 (const Slicer& section, uInt nLattices);
+// </group>
+// Read the parts into the buffer using the given function to get the
+// data from a lattice. The parts are read in parallel if possible.
+   template <class U, class Getter>
+   void readParts (Array<U>& buffer, const std::vector<Part>& parts,
+                   Getter getter);
 //
    void setup1 (IPosition& blc, IPosition& trc, IPosition& stride,
                 IPosition& blc2, IPosition& trc2,
@@ -265,19 +319,11 @@ private:
    Slicer setup2 (Bool& first, IPosition& blc2, IPosition& trc2,
                   Int shape2, Int axis, const IPosition& blc,
                   const IPosition& trc, const IPosition& stride, Int start);
-   Bool getSlice1 (Array<T>& buffer, const Slicer& section,
-                   uInt nLattices);
-   Bool getSlice2 (Array<T>& buffer, const Slicer& section,
-                   uInt nLattices);
    Bool putSlice1 (const Array<T>& buffer, const IPosition& where,
                    const IPosition& stride, uInt nLattices);
 
    Bool putSlice2 (const Array<T>& buffer, const IPosition& where,
                    const IPosition& stride, uInt nLattices);
-   Bool getMaskSlice1 (Array<Bool>& buffer, const Slicer& section,
-                       uInt nLattices);
-   Bool getMaskSlice2 (Array<Bool>& buffer, const Slicer& section,
-                       uInt nLattices);
 };
 
 
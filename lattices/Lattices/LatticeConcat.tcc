@@ -34,12 +34,15 @@
 #include <casacore/lattices/Lattices/LatticeIterator.h>
 #include <casacore/lattices/Lattices/LatticeStepper.h>
 #include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/Utilities/Assert.h>
 
+#include <exception>
+
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -50,7 +53,9 @@ LatticeConcat<T>::LatticeConcat()
   isMasked_p(False),
   dimUpOne_p(False),
   tempClose_p(True),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  maxOpen_p(0),
+  canParallel_p(True)
 {
 }
 
@@ -61,7 +66,9 @@ LatticeConcat<T>::LatticeConcat(uInt axis, Bool tempClose)
   isMasked_p(False),
   dimUpOne_p(False),
   tempClose_p(tempClose),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  maxOpen_p(0),
+  canParallel_p(True)
 {
 }
 
@@ -74,7 +81,10 @@ LatticeConcat<T>::LatticeConcat (const LatticeConcat<T>&other)
   isMasked_p(other.isMasked_p),
   dimUpOne_p(other.dimUpOne_p),
   tempClose_p(other.tempClose_p),
-  pPixelMask_p(0)
+  pPixelMask_p(0),
+  maxOpen_p(other.maxOpen_p),
+  canParallel_p(other.canParallel_p),
+  fileNames_p(other.fileNames_p)
 {
    const uInt n = lattices_p.nelements();
    for (uInt i=0; i<n; i++) {
@@ -106,6 +116,10 @@ LatticeConcat<T>& LatticeConcat<T>::operator= (const LatticeConcat<T>& other)
     isMasked_p     = other.isMasked_p;
     dimUpOne_p     = other.dimUpOne_p;
     tempClose_p    = other.tempClose_p;
+    maxOpen_p      = other.maxOpen_p;
+    canParallel_p  = other.canParallel_p;
+    fileNames_p    = other.fileNames_p;
+    openLattices_p.clear();
 //
     uInt n = lattices_p.nelements();
     for (uInt j=0; j<n; j++) {
@@ -195,6 +209,17 @@ void LatticeConcat<T>::setLattice(MaskedLattice<T>& lattice)
 
    if (lattice.isMasked()) isMasked_p = True;
 
+// The lattices can only be read in parallel if all are stored in different
+// tables (e.g. PagedArray or PagedImage). Other storage (such as HDF5)
+// cannot be read by multiple threads.
+
+   if (canParallel_p) {
+      const String name = lattice.name(False);
+      canParallel_p = lattice.isPaged()  &&  Table::isReadable(name)  &&
+                      fileNames_p.insert(name).second;
+      if (!canParallel_p) fileNames_p.clear();
+   }
+
 // Handle pixelMask.
 // If a Lattice has a pixelmask, insert pixelmasks (i.e. LCBox-s)
 // for lattices not having pixelmasks.
@@ -203,6 +228,7 @@ void LatticeConcat<T>::setLattice(MaskedLattice<T>& lattice)
    if (lattice.hasPixelMask()) {
       if (pPixelMask_p == 0) {
 	 pPixelMask_p = new LatticeConcat<Bool>(axis_p, tempClose_p);
+	 pPixelMask_p->setMaxOpen (maxOpen_p);
 	 for (uInt i=0; i<n; i++) {
 	    SubLattice<Bool> tmp = LCBox (lattices_p[i]->shape());
 	    pPixelMask_p->setLattice (tmp);
@@ -223,6 +249,15 @@ void LatticeConcat<T>::setLattice(MaskedLattice<T>& lattice)
 } 
 
 
+template <class T>
+void LatticeConcat<T>::setMaxOpen (uInt maxOpen)
+{
+   maxOpen_p = maxOpen;
+   if (pPixelMask_p != 0) {
+      pPixelMask_p->setMaxOpen (maxOpen);
+   }
+}
+
 template <class T>
 uInt LatticeConcat<T>::latticeDim() const
 {
@@ -329,20 +364,17 @@ Bool LatticeConcat<T>::doGetSlice (Array<T>& buffer,
       throw (AipsError("No lattices set - use function setLattice"));
    }
 //
-   Bool ok = False;
-   if (dimUpOne_p) {
-
-// Increase dimensionality by one
-
-     ok = getSlice1 (buffer, section, nLattices);
-   } else {
+   const std::vector<Part> parts = dimUpOne_p ?
+                                   findParts1 (section, nLattices) :
+                                   findParts2 (section, nLattices);
+   buffer.resize(section.length());
+   readParts (buffer, parts,
+              [] (MaskedLattice<T>& lattice, const Slicer& sl)
+              { return lattice.getSlice (sl); });
 
-// No dimensionality increase
+// Result is a copy
 
-     ok = getSlice2(buffer, section, nLattices);
-   }
-//
-   return ok;
+   return False;
 }
  
 
@@ -355,26 +387,21 @@ Bool LatticeConcat<T>::doGetMaskSlice (Array<Bool>& buffer,
       throw (AipsError("No lattices set - use function setLattice"));
    }
 //
-   Bool ok = False;
+   buffer.resize (section.length());
    if (isMasked_p) {
-      if (dimUpOne_p) {
-
-// Increase dimensionality by one
-
-        ok = getMaskSlice1 (buffer, section, nLattices);
-      } else {
+      const std::vector<Part> parts = dimUpOne_p ?
+                                      findParts1 (section, nLattices) :
+                                      findParts2 (section, nLattices);
+      readParts (buffer, parts,
+                 [] (MaskedLattice<T>& lattice, const Slicer& sl)
+                 { return lattice.getMaskSlice (sl); });
 
-// No dimensionality increase
+// Result is a copy
 
-        ok = getMaskSlice2 (buffer, section, nLattices);
-      }
-   } else {
-      buffer.resize (section.length());
-      buffer = True;
-      ok = True;
+      return False;
    }
-//
-   return ok;   
+   buffer = True;
+   return True;
 }
 
 
@@ -481,6 +508,8 @@ void LatticeConcat<T>::flush()
 template <class T>
 void LatticeConcat<T>::tempClose()
 {
+    std::lock_guard<std::mutex> lock(openMutex_p);
+    openLattices_p.clear();
     const uInt n = lattices_p.nelements();
     for (uInt i=0; i<n; i++) {
        lattices_p[i]->tempClose();
@@ -500,6 +529,8 @@ template <class T>
 void LatticeConcat<T>::tempClose(uInt which)
 {
     AlwaysAssert (which<lattices_p.nelements(), AipsError);
+    std::lock_guard<std::mutex> lock(openMutex_p);
+    openLattices_p.remove (which);
     lattices_p[which]->tempClose();
 }
 
@@ -578,9 +609,30 @@ Slicer LatticeConcat<T>::setup2 (Bool& first, IPosition& blc2, IPosition& trc2,
 }
 
 template <class T>
-Bool LatticeConcat<T>::getSlice1 (Array<T>& buffer,
-                                  const Slicer& section,
-                                  uInt nLattices)
+void LatticeConcat<T>::acquireLattice (uInt which)
+{
+   if (tempClose_p) {
+      std::lock_guard<std::mutex> lock(openMutex_p);
+      openLattices_p.remove (which);
+   }
+}
+
+template <class T>
+void LatticeConcat<T>::releaseLattice (uInt which)
+{
+   if (tempClose_p) {
+      std::lock_guard<std::mutex> lock(openMutex_p);
+      openLattices_p.push_front (which);
+      while (openLattices_p.size() > maxOpen_p) {
+         lattices_p[openLattices_p.back()]->tempClose();
+         openLattices_p.pop_back();
+      }
+   }
+}
+
+template <class T>
+std::vector<typename LatticeConcat<T>::Part>
+LatticeConcat<T>::findParts1 (const Slicer& section, uInt nLattices) const
 {
    const uInt dimIn = axis_p;
 
@@ -591,43 +643,32 @@ Bool LatticeConcat<T>::getSlice1 (Array<T>& buffer,
    }
    IPosition blc3(dimIn+1,0);
    IPosition trc3(section.length()-1);
-   IPosition stride3(dimIn+1,1);
-
 
 // The underlying lattice section - it never changes
 
    Slicer section2(section.start().getFirst(dimIn), section.end().getFirst(dimIn), 
                    section.stride().getFirst(dimIn), Slicer::endIsLast);
-//
-   buffer.resize(section.length());
 
 // We are looping over the last axis of the concatenated lattice
 // Each input lattice contributes just one pixel to that axis
 
+   std::vector<Part> parts;
    uInt k = 0;
    for (Int i=section.start()(axis_p); i<=section.end()(axis_p); i+=section.stride()(axis_p)) {
-       Array<T> buf = lattices_p[i]->getSlice(section2);
-//
        blc3(axis_p) = k;
        trc3(axis_p) = k;
-       buffer(blc3, trc3, stride3) = buf.addDegenerate(1);
-       if (tempClose_p) lattices_p[i]->tempClose();
+       Part part = {uInt(i), section2, blc3, trc3};
+       parts.push_back (part);
        k++;
    }
-
-// Result is a copy
-
-   return False;
+   return parts;
 }
 
 
 template <class T>
-Bool LatticeConcat<T>::getSlice2 (Array<T>& buffer,
-                                  const Slicer& section,
-                                  uInt nLattices)
+std::vector<typename LatticeConcat<T>::Part>
+LatticeConcat<T>::findParts2 (const Slicer& section, uInt nLattices)
 {
-//cout << "blc, trc, stride=" << section.start() << section.end() << section.stride() << endl;
-
 // Setup positions
 
    IPosition blc, trc, stride;   
@@ -635,17 +676,13 @@ Bool LatticeConcat<T>::getSlice2 (Array<T>& buffer,
    IPosition blc3, trc3, stride3;
    setup1 (blc, trc, stride, blc2, trc2, blc3, trc3, stride3, section);
 //
-   buffer.resize(section.length());
-//cout << "Buffer shape = " << buffer.shape() << endl;
-//
+   std::vector<Part> parts;
    Int start = 0;
    Bool first = True;
    Slicer section2;
 //
    for (uInt i=0; i<nLattices; i++) {
 
-//cout << "Lattice shape = " << lattices_p[i]->shape() << endl;
-
 // Find start and end of this lattice inside the concatenated lattice
 
       Int shape2 = lattices_p[i]->shape()(axis_p);
@@ -653,31 +690,63 @@ Bool LatticeConcat<T>::getSlice2 (Array<T>& buffer,
 //
       if (! (blc(axis_p)>end || trc(axis_p)<start)) {
 
-// Find section of input Lattice to copy
+// Find section of input Lattice to copy and where it goes in the buffer
 
          section2 = setup2(first, blc2, trc2, shape2, axis_p, blc, trc, 
                            stride, start);
-
-// Put it in output buffer
-
-//cout << "blc2, trc2, stride2, shape = " 
-//     << section2.start() << section2.end() << section2.stride() << section2.length() << endl;
-
          trc3(axis_p) = blc3(axis_p) + section2.length()(axis_p) - 1;
-
-//IPosition sh(Slicer(blc3, trc3, stride3, Slicer::endIsLast).length());
-//cout << "blc3, trc3, stride3, shape = " << blc3 << trc3 << stride3  << sh << endl << endl;
-
-         buffer(blc3, trc3, stride3) = lattices_p[i]->getSlice(section2);
+         Part part = {i, section2, blc3, trc3};
+         parts.push_back (part);
          blc3(axis_p) += section2.length()(axis_p);
       }
       start += shape2;
-      if (tempClose_p) lattices_p[i]->tempClose();
    }
+   return parts;
+}
 
-// Result is a copy
 
-   return False;
+template <class T>
+template <class U, class Getter>
+void LatticeConcat<T>::readParts (Array<U>& buffer,
+                                  const std::vector<Part>& parts,
+                                  Getter getter)
+{
+// The parts do not overlap, so each can be read by its own thread
+// if the lattices are in different files.
+// An exception cannot leave an OpenMP loop, so it is rethrown thereafter.
+
+   const IPosition stride(buffer.ndim(), 1);
+   const Int nparts = parts.size();
+   const Bool parallel = canParallel_p  &&  nparts > 1;
+   std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+   for (Int j=0; j<nparts; j++) {
+      const Part& part = parts[j];
+      try {
+         acquireLattice (part.lattice);
+         Array<U> buf = getter (*lattices_p[part.lattice], part.section);
+         if (dimUpOne_p) {
+            buffer(part.blc, part.trc, stride) = buf.addDegenerate(1);
+         } else {
+            buffer(part.blc, part.trc, stride) = buf;
+         }
+         releaseLattice (part.lattice);
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(LatticeConcat_readParts)
+#endif
+         {
+            if (! error) {
+               error = std::current_exception();
+            }
+         }
+      }
+   }
+   if (error) {
+      std::rethrow_exception (error);
+   }
 }
 
 
@@ -711,9 +780,10 @@ Bool LatticeConcat<T>::putSlice1 (const Array<T>& buffer, const IPosition& where
       blc3(axis_p) = k;
       trc3(axis_p) = k;
       Array<T> buf0(buffer);
+      acquireLattice (i);
       lattices_p[i]->putSlice(buf0(blc3, trc3, stride3).nonDegenerate(axis_p-1), 
                               section2.start(), section2.stride());
-      if (tempClose_p) lattices_p[i]->tempClose();
+      releaseLattice (i);
       k++;
    }
 //  
@@ -775,8 +845,9 @@ Bool LatticeConcat<T>::putSlice2 (const Array<T>& buffer, const IPosition& where
 //cout << "blc3, trc3, stride3, shape = " << blc3 << trc3 << stride3  << sh << endl << endl;
 
          Array<T> buf(buffer);
+         acquireLattice (i);
          lattices_p[i]->putSlice(buf(blc3, trc3, stride3), blc2, stride);
-         if (tempClose_p) lattices_p[i]->tempClose();
+         releaseLattice (i);
 //
          blc3(axis_p) += section2.length()(axis_p);
       }
@@ -787,97 +858,6 @@ Bool LatticeConcat<T>::putSlice2 (const Array<T>& buffer, const IPosition& where
 }
 
 
-template <class T>
-Bool LatticeConcat<T>::getMaskSlice1 (Array<Bool>& buffer,
-                                      const Slicer& section,
-                                      uInt nLattices)
-{
-   const uInt dimIn = axis_p;
-
-// The concatenated lattice section
-
-   if (section.end()(axis_p)+1 > Int(nLattices)) {
-      throw(AipsError("Number of lattices and requested slice are inconsistent"));
-   }
-   IPosition blc3(dimIn+1,0);
-   IPosition trc3(section.length()-1);
-   IPosition stride3(dimIn+1,1);
-
-
-// The underlying lattice section - it never changes
-   
-   Slicer section2(section.start().getFirst(dimIn), section.end().getFirst(dimIn),
-                   section.stride().getFirst(dimIn), Slicer::endIsLast);
-//
-   buffer.resize(section.length());
-
-// We are looping over the last axis of the concatenated lattice
-// Each input lattice contributes just one pixel to that axis
-                                  
-   uInt k = 0;
-   for (Int i=section.start()(axis_p); i<=section.end()(axis_p); i+=section.stride()(axis_p)) {
-       blc3(axis_p) = k;
-       trc3(axis_p) = k;
-       Array<Bool> buf = lattices_p[i]->getMaskSlice(section2);
-       buffer(blc3, trc3, stride3) = buf.addDegenerate(1);
-       if (tempClose_p) lattices_p[i]->tempClose();
-       k++;
-   }
-
-// Result is a copy
-
-   return False;
-}
- 
-
-
-template <class T>
-Bool LatticeConcat<T>::getMaskSlice2 (Array<Bool>& buffer,
-                                      const Slicer& section,
-                                      uInt nLattices)
-{
-
-// Setup positions
-
-   IPosition blc, trc, stride;   
-   IPosition blc2, trc2;
-   IPosition blc3, trc3, stride3;
-   setup1 (blc, trc, stride, blc2, trc2, blc3, trc3, stride3, section);
-//
-   buffer.resize(section.length());
-//
-   Int start = 0;
-   Bool first = True;
-   Slicer section2;
-//
-   for (uInt i=0; i<nLattices; i++) {
-
-// Find start and end of this lattice inside the concatenated lattice
-
-      Int shape2 = lattices_p[i]->shape()(axis_p);
-      Int end = start + shape2 - 1;
-//
-      if (! (blc(axis_p)>end || trc(axis_p)<start)) {
-
-// Whack slice into the output
-
-         section2 = setup2(first, blc2, trc2, shape2, axis_p, blc, trc, 
-                           stride, start);
-//
-         trc3(axis_p) = blc3(axis_p) + section2.length()(axis_p) - 1;
-         buffer(blc3, trc3, stride3) = lattices_p[i]->getMaskSlice(section2);
-         if (tempClose_p) lattices_p[i]->tempClose();
-//
-         blc3(axis_p) += section2.length()(axis_p);
-      }
-      start += shape2;
-   }
-
-// Result is a copy
-
-   return False;
-}
-
 } //# NAMESPACE CASACORE - END
 
 
@@ -218,35 +218,31 @@ Bool LatticeIndexer::tiledCursorMove (Bool incr, IPosition& cursorPos,
   for (uInt i=0; i<itsNdim; i++) {
     AlwaysAssert (cursorShape(i) > 0, AipsError);
   }
-  uInt activeAxis;
-  uInt indexToActiveAxis = 0;
-  IPosition candidateCursorPos(cursorPos);
-
-  while (indexToActiveAxis < itsNdim) {
-    activeAxis = cursorHeading(indexToActiveAxis);
-    if (incr) {
-      candidateCursorPos(activeAxis) += cursorShape(activeAxis);
-    } else {
-      candidateCursorPos(activeAxis) -= cursorShape(activeAxis);
-    }
-    if ((candidateCursorPos(activeAxis) < itsShape(activeAxis))  &&
-	(candidateCursorPos(activeAxis) + cursorShape(activeAxis) > 0)) {
-      cursorPos = candidateCursorPos;
+  // First find the axis to move, so cursorPos can be updated in place
+  // without making a copy of it.
+  for (uInt indexToActiveAxis=0; indexToActiveAxis<itsNdim;
+       indexToActiveAxis++) {
+    const uInt activeAxis = cursorHeading(indexToActiveAxis);
+    const ssize_t shape = cursorShape(activeAxis);
+    const ssize_t candidatePos = cursorPos(activeAxis) +
+                                 (incr ? shape : -shape);
+    if (candidatePos < itsShape(activeAxis)  &&  candidatePos + shape > 0) {
+      // Wrap the faster varying axes around.
+      for (uInt i=0; i<indexToActiveAxis; i++) {
+        const uInt axis = cursorHeading(i);
+        const ssize_t len = cursorShape(axis);
+        if (incr) {
+          const ssize_t pos = cursorPos(axis) + len;
+          cursorPos(axis) = pos - ((pos + len - 1) / len) * len;
+        } else {
+          const ssize_t pos = cursorPos(axis) - len;
+          cursorPos(axis) = pos + ((itsShape(axis) - pos - 1) / len) * len;
+        }
+      }
+      cursorPos(activeAxis) = candidatePos;
       return True;
     }
-    if (incr) {
-      candidateCursorPos(activeAxis) -= 
-	((candidateCursorPos(activeAxis) + cursorShape(activeAxis) - 1)
-	 / cursorShape(activeAxis))
-	* cursorShape(activeAxis);
-    } else {
-      candidateCursorPos(activeAxis) +=
-	((itsShape(activeAxis) - candidateCursorPos(activeAxis) - 1)
-	 / cursorShape(activeAxis))
-	* cursorShape(activeAxis);
-    }
-    indexToActiveAxis++;
-  } // while 
+  }
   return False;
 }
 
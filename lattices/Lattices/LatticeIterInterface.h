@@ -212,6 +212,14 @@ protected:
   virtual Array<T>& cursor (Bool doRead, Bool autoRewrite);
   //</group>
 
+  // Get the number of tiles the iteration is expected to read and the
+  // number actually read since the iterator was made. Both are 0 if the
+  // lattice is not tiled or if the navigator cannot predict it.
+  // <group>
+  virtual uInt64 expectedTileReads() const;
+  virtual uInt64 actualTileReads() const;
+  // </group>
+
   // Function which checks the internals of the class for consistency.
   // Returns True if everything is fine otherwise returns False. The default
   // implementation of this function always returns True.
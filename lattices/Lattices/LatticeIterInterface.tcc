@@ -388,6 +388,18 @@ void LatticeIterInterface<T>::allocateBuffer()
   setCurPtr2Cursor();
 }
 
+template<class T>
+uInt64 LatticeIterInterface<T>::expectedTileReads() const
+{
+  return 0;
+}
+
+template<class T>
+uInt64 LatticeIterInterface<T>::actualTileReads() const
+{
+  return 0;
+}
+
 template<class T>
 Bool LatticeIterInterface<T>::ok() const
 {
@@ -328,6 +328,18 @@ public:
   const Cube<T>& cubeCursor() const; 
   const Array<T>& cursor() const; 
   // </group>
+
+  // Get the number of tiles the iteration is expected to read and the
+  // number actually read since the iterator was made. They can be
+  // compared to check if the cursor shape and axis path fit the tiling
+  // (see <linkto class=LatticeAccessPlanner>LatticeAccessPlanner</linkto>).
+  // Both are 0 if the lattice is not tiled (e.g. an ArrayLattice) or if the
+  // navigator cannot predict it. The actual number also counts the reads of
+  // other iterators on the same lattice done meanwhile.
+  // <group>
+  uInt64 expectedTileReads() const;
+  uInt64 actualTileReads() const;
+  // </group>
   
   // Function which checks the internals of the class for consistency.
   // Returns True if everything is fine otherwise returns False.
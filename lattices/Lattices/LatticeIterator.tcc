@@ -160,6 +160,18 @@ uInt RO_LatticeIterator<T>::nsteps() const
   return itsIterPtr->nsteps();
 }
 
+template <class T>
+uInt64 RO_LatticeIterator<T>::expectedTileReads() const
+{
+  return itsIterPtr->expectedTileReads();
+}
+
+template <class T>
+uInt64 RO_LatticeIterator<T>::actualTileReads() const
+{
+  return itsIterPtr->actualTileReads();
+}
+
 template <class T>
 IPosition RO_LatticeIterator<T>::position() const
 {
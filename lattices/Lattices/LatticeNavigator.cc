@@ -101,6 +101,12 @@ IPosition LatticeNavigator::increment() const
   return IPosition(latticeShape().nelements(), 1);
 }
 
+uInt64 LatticeNavigator::expectedTileReads (const IPosition&,
+                                            const IPosition&, uInt) const
+{
+  return 0;
+}
+
 Bool LatticeNavigator::ok() const
 {
   return True;
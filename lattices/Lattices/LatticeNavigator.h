@@ -337,6 +337,13 @@ public:
                               const IPosition& tileShape,
                               uInt maxCacheSize, uInt bucketSize) const = 0;
 
+  // Get the expected number of tiles read for this type of access to
+  // a tiled hypercube using a cache of the given size (in tiles).
+  // The default implementation returns 0, meaning that it is unknown.
+  virtual uInt64 expectedTileReads (const IPosition& cubeShape,
+                                    const IPosition& tileShape,
+                                    uInt cacheSize) const;
+
   // Function which returns a pointer to dynamic memory of an exact copy 
   // of this LatticeNavigator. It is the responsibility of the caller to
   // release this memory. 
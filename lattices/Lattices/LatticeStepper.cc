@@ -24,7 +24,7 @@
 //#                        Charlottesville, VA 22903-2475 USA
 
 #include <casacore/lattices/Lattices/LatticeStepper.h>
-#include <casacore/tables/DataMan/TSMCube.h>
+#include <casacore/lattices/Lattices/LatticeAccessPlanner.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
@@ -146,12 +146,12 @@ Bool LatticeStepper::operator++(int)
   if (successful) {
     // test for hang over since cursor has moved.
     if (itsNiceFit == False) {
-      const IPosition curPos(itsCursorPos);
-      const IPosition curEndPos(itsCursorPos+itsCursorShape-1);
-      const IPosition latShape(itsIndexer.shape());
+      const IPosition& latShape = itsIndexer.shape();
       const uInt ndim = itsIndexer.ndim();
       uInt i = 0;
-      while (i < ndim  &&  curEndPos(i) < latShape(i)  &&  curPos(i) >= 0) {
+      while (i < ndim  &&
+             itsCursorPos(i) + itsCursorShape(i) - 1 < latShape(i)  &&
+             itsCursorPos(i) >= 0) {
 	i++;
       }
       itsHangover =  (i != ndim);
@@ -177,13 +177,12 @@ Bool LatticeStepper::operator--(int)
 						itsCursorShape, itsAxisPath);
   if (successful) {
     // test for hang over since cursor has moved
-    const IPosition curPos(itsCursorPos);
-    const uInt ndim = itsIndexer.ndim();
     if (itsNiceFit == False) {
-      const IPosition curEndPos(itsCursorPos+itsCursorShape);
-      const IPosition latShape(itsIndexer.shape());
+      const IPosition& latShape = itsIndexer.shape();
+      const uInt ndim = itsIndexer.ndim();
       uInt i = 0;
-      while (i < ndim  &&  curPos(i) >= 0  &&  curEndPos(i) < latShape(i)) {
+      while (i < ndim  &&  itsCursorPos(i) >= 0  &&
+             itsCursorPos(i) + itsCursorShape(i) < latShape(i)) {
 	i++;
       }
       itsHangover =  (i != ndim);
@@ -204,7 +203,7 @@ void LatticeStepper::reset()
   itsHangover = False;
   if (!itsNiceFit) {
     const uInt ndim = itsIndexer.ndim();
-    const IPosition latShape(itsIndexer.shape());
+    const IPosition& latShape = itsIndexer.shape();
     for (uInt i=0; i<ndim; i++) {
       if (itsCursorShape(i) > latShape(i)) {
 	itsHangover = True;
@@ -461,12 +460,23 @@ uInt LatticeStepper::calcCacheSize (const IPosition& cubeShape,
                                     const IPosition& tileShape,
                                     uInt maxCacheSize, uInt bucketSize) const
 {
-  return (bucketSize == 0  ?  0 :
-          TSMCube::calcCacheSize (cubeShape, tileShape, False,
-                                  itsCursorShape,
-                                  blc(), trc() - blc() + 1,
-                                  itsAxisPath,
-                                  maxCacheSize, bucketSize));
+  if (bucketSize == 0) {
+    return 0;
+  }
+  LatticeAccessPlanner planner (cubeShape, tileShape, itsCursorShape,
+                                blc(), trc(), increment());
+  return planner.cacheSize
+    (itsAxisPath, LatticeAccessPlanner::maxCacheSize (maxCacheSize,
+                                                      bucketSize));
+}
+
+uInt64 LatticeStepper::expectedTileReads (const IPosition& cubeShape,
+                                          const IPosition& tileShape,
+                                          uInt cacheSize) const
+{
+  LatticeAccessPlanner planner (cubeShape, tileShape, itsCursorShape,
+                                blc(), trc(), increment());
+  return planner.tileReads (itsAxisPath, cacheSize);
 }
 
 Bool LatticeStepper::ok() const
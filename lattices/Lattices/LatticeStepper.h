@@ -438,10 +438,18 @@ public:
 
   // Calculate the cache size (in tiles) for this type of access to a lattice
   // in the given row of the tiled hypercube.
+  // It is the smallest cache giving the fewest tile reads as determined by
+  // <linkto class=LatticeAccessPlanner>LatticeAccessPlanner</linkto>.
   virtual uInt calcCacheSize (const IPosition& cubeShape,
                               const IPosition& tileShape,
                               uInt maxCacheSize, uInt bucketSize) const;
 
+  // Get the expected number of tiles read using a cache of the given size
+  // as determined by LatticeAccessPlanner.
+  virtual uInt64 expectedTileReads (const IPosition& cubeShape,
+                                    const IPosition& tileShape,
+                                    uInt cacheSize) const;
+
 private:
   // Prevent the default constructor from being used.
   LatticeStepper();
@@ -119,6 +119,12 @@ protected:
   // Clone the object.
   virtual LatticeIterInterface<T>* clone() const;
 
+  // Get the expected and actual number of tiles read.
+  // <group>
+  virtual uInt64 expectedTileReads() const;
+  virtual uInt64 actualTileReads() const;
+  // </group>
+
 private:
   // Setup the cache in the tiled storage manager.
   void setupTileCache();
@@ -126,6 +132,10 @@ private:
 
   // reference to the PagedArray
   PagedArray<T> itsData;
+  // expected number of tile reads for the iteration
+  uInt64 itsExpectedReads;
+  // number of tiles read before the iteration started
+  uInt   itsStartReads;
 };
 
 
@@ -45,7 +45,9 @@ PagedArrIter<T>::PagedArrIter (const PagedArray<T>& data,
 			       const LatticeNavigator& nav,
 			       Bool useRef)
 : LatticeIterInterface<T> (data, nav, useRef),
-  itsData (data)
+  itsData (data),
+  itsExpectedReads (0),
+  itsStartReads (0)
 {
   setupTileCache();
 }
@@ -53,7 +55,9 @@ PagedArrIter<T>::PagedArrIter (const PagedArray<T>& data,
 template<class T>
 PagedArrIter<T>::PagedArrIter (const PagedArrIter<T>& other)
 : LatticeIterInterface<T> (other),
-  itsData (other.itsData)
+  itsData (other.itsData),
+  itsExpectedReads (other.itsExpectedReads),
+  itsStartReads (other.itsStartReads)
 {}
 
 template<class T>
@@ -70,6 +74,8 @@ PagedArrIter<T>& PagedArrIter<T>::operator= (const PagedArrIter<T>& other)
     itsData.clearCache();
     LatticeIterInterface<T>::operator= (other);
     itsData = other.itsData;
+    itsExpectedReads = other.itsExpectedReads;
+    itsStartReads = other.itsStartReads;
   }
   return *this;
 }
@@ -90,6 +96,26 @@ void PagedArrIter<T>::setupTileCache()
                                              acc.maximumCacheSize(),
                                              acc.bucketSize(rownr));
   itsData.setCacheSizeInTiles (cacheSize);
+  // The storage manager may have limited the cache size.
+  itsExpectedReads = itsNavPtr->expectedTileReads (acc.hypercubeShape(rownr),
+                                                   acc.tileShape(rownr),
+                                                   acc.cacheSize(rownr));
+  itsStartReads = acc.nTileReads (rownr);
+}
+
+template<class T>
+uInt64 PagedArrIter<T>::expectedTileReads() const
+{
+  return itsExpectedReads;
+}
+
+template<class T>
+uInt64 PagedArrIter<T>::actualTileReads() const
+{
+  const ROTiledStManAccessor& acc = itsData.accessor();
+  uInt nread = acc.nTileReads (itsData.rowNumber());
+  // The statistics are reset if the cache was cleared meanwhile.
+  return (nread >= itsStartReads  ?  nread - itsStartReads : nread);
 }
 
 } //# NAMESPACE CASACORE - END
@@ -160,7 +160,7 @@ public:
   // The assignment operator with reference semantics. As with the copy
   // constructor assigning by value does not make sense.
   TempLattice<T>& operator= (const TempLattice<T>& other)
-    { itsImpl = other.itsImpl; }
+    { itsImpl = other.itsImpl; return *this; }
 
   // Make a copy of the object (reference semantics).
   virtual Lattice<T>* clone() const;
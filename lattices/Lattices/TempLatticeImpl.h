@@ -30,9 +30,14 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/lattices/Lattices/Lattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/PagedArrIter.h>
+#include <casacore/lattices/Lattices/TempLatticeMemory.h>
 #include <casacore/lattices/Lattices/TiledShape.h>
 #include <casacore/tables/Tables/Table.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -60,10 +65,22 @@ class Table;
 // This was needed to have a correct implementation of tempClose. Otherwise
 // when deleting a copy of a TempLattice, that destructor would delete the
 // underlying table and the original TempLattice could not reopen it.
+// <p>
+// An in-memory lattice reserves its memory in the budget managed by
+// <linkto class=TempLatticeMemory>TempLatticeMemory</linkto>, which can
+// spill it to disk if memory is needed for another TempLattice. It is only
+// spilled if no iterator or array references its data. A spilled lattice
+// is moved back to memory when accessed if the budget allows it, unless an
+// iterator made for it while on disk still exists. Such an iterator pins
+// the lattice on disk, because it accesses the PagedArray directly.
+// <br>Accesses are guarded by a mutex, because the manager can spill the
+// lattice from another thread. Only bulk accesses (getting or putting a
+// slice, set, apply and making an iterator) mark the lattice as
+// recently used.
 // </synopsis>
 
 
-template<class T> class TempLatticeImpl
+template<class T> class TempLatticeImpl : public TempLatticeMemory::Client
 {
 public:
   // The default constructor creates a TempLatticeImpl containing a
@@ -86,11 +103,13 @@ public:
 
   // Is the TempLattice paged to disk?
   Bool isPaged() const
-    { return  (! itsTableName.empty()); }
+    { std::lock_guard<std::recursive_mutex> lock(itsMutex);
+      return  (! itsTableName.empty()); }
 
   // Can the lattice data be referenced as an array section?
   Bool canReferenceArray() const
-    { return  (itsTableName.empty()); }
+    { std::lock_guard<std::recursive_mutex> lock(itsMutex);
+      return  (itsTableName.empty()); }
 
   // Is the TempLattice writable? It should be.
   Bool isWritable() const
@@ -98,7 +117,8 @@ public:
 
   // Flush the data.
   void flush()
-    { if (!itsTable.isNull()) itsTable.flush(); }
+    { std::lock_guard<std::recursive_mutex> lock(itsMutex);
+      if (!itsTable.isNull()) itsTable.flush(); }
 
   // Close the Lattice temporarily (if it is paged to disk).
   // It'll be reopened automatically when needed or when
@@ -111,11 +131,11 @@ public:
   // Return the shape of the Lattice including all degenerate axes.
   // (ie. axes with a length of one)
   IPosition shape() const
-    { doReopen(); return itsLatticePtr->shape(); } 
+    { return itsShape.shape(); }
 
   // Set all of the elements in the Lattice to the given value.
   void set (const T& value)
-    { doReopen(); itsLatticePtr->set (value); }
+    { Access access(*this, True); itsLatticePtr->set (value); }
 
   // Replace every element, x, of the Lattice with the result of f(x).  You
   // must pass in the address of the function -- so the function must be
@@ -130,36 +150,37 @@ public:
   // issue.
   // <group>
   void apply (T (*function)(T))
-    { doReopen(); itsLatticePtr->apply (function); }
+    { Access access(*this, True); itsLatticePtr->apply (function); }
   void apply (T (*function)(const T&))
-    { doReopen(); itsLatticePtr->apply (function); }
+    { Access access(*this, True); itsLatticePtr->apply (function); }
   void apply (const Functional<T,T>& function)
-    { doReopen(); itsLatticePtr->apply (function); }
+    { Access access(*this, True); itsLatticePtr->apply (function); }
   // </group>
 
   // This function returns the recommended maximum number of pixels to
   // include in the cursor of an iterator.
   uInt advisedMaxPixels() const
-    { doReopen(); return itsLatticePtr->advisedMaxPixels(); }
+    { Access access(*this); return itsLatticePtr->advisedMaxPixels(); }
 
   // Get the best cursor shape.
   IPosition doNiceCursorShape (uInt maxPixels) 
-    { doReopen(); return itsLatticePtr->niceCursorShape (maxPixels); }
+    { Access access(*this); return itsLatticePtr->niceCursorShape (maxPixels); }
 
   // Maximum size - not necessarily all used. In pixels.
   uInt maximumCacheSize() const
-    { return itsLatticePtr->maximumCacheSize(); }
+    { Access access(*this); return itsLatticePtr->maximumCacheSize(); }
 
   // Set the maximum (allowed) cache size as indicated.
   void setMaximumCacheSize (uInt howManyPixels)
-    { itsLatticePtr->setMaximumCacheSize (howManyPixels); }
+    { Access access(*this); itsLatticePtr->setMaximumCacheSize (howManyPixels); }
 
   // Set the cache size as to "fit" the indicated path.
   void setCacheSizeFromPath (const IPosition& sliceShape,
   			             const IPosition& windowStart,
 			             const IPosition& windowLength,
 			             const IPosition& axisPath)
-    { itsLatticePtr->setCacheSizeFromPath (sliceShape, windowStart, windowLength,
+    { Access access(*this);
+      itsLatticePtr->setCacheSizeFromPath (sliceShape, windowStart, windowLength,
                                            axisPath); }
     
   // Set the actual cache size for this Array to be be big enough for the
@@ -168,52 +189,72 @@ public:
   // set using the setMaximumCacheSize member function.
   // tiles. Tiles are cached using a first in first out algorithm. 
   void setCacheSizeInTiles (uInt howManyTiles)
-    { itsLatticePtr->setCacheSizeInTiles (howManyTiles); }
+    { Access access(*this); itsLatticePtr->setCacheSizeInTiles (howManyTiles); }
 
   // Clears and frees up the caches, but the maximum allowed cache size is 
   // unchanged from when setCacheSize was called
   void clearCache()
-    { itsLatticePtr->clearCache(); }
+    { Access access(*this); itsLatticePtr->clearCache(); }
 
   // Report on cache success.
   void showCacheStatistics (ostream& os) const
-    { itsLatticePtr->showCacheStatistics (os); }
+    { Access access(*this); itsLatticePtr->showCacheStatistics (os); }
 
   // Get or put a single element in the lattice.
   // Note that Lattice::operator() can also be used to get a single element.
   // <group>
   T getAt (const IPosition& where) const
-    { doReopen(); return itsLatticePtr->getAt (where); }
+    { Access access(*this); return itsLatticePtr->getAt (where); }
   void putAt (const T& value, const IPosition& where)
-    { doReopen(); itsLatticePtr->putAt (value, where); }
+    { Access access(*this); itsLatticePtr->putAt (value, where); }
   // </group>
   
   // Check class internals - used for debugging. Should always return True
   Bool ok() const
-    { doReopen(); return itsLatticePtr->ok(); }
+    { Access access(*this); return itsLatticePtr->ok(); }
 
   // This function is used by the LatticeIterator class to generate an
   // iterator of the correct type for this Lattice. Not recommended
   // for general use. 
+  // An iterator on a spilled lattice pins it on disk while it exists.
   LatticeIterInterface<T>* makeIter (const LatticeNavigator& navigator,
-                                     Bool useRef) const
-    { doReopen(); return itsLatticePtr->makeIter (navigator, useRef); }
+                                     Bool useRef) const;
 
   // Do the actual getting of an array of values.
   Bool doGetSlice (Array<T>& buffer, const Slicer& section)
-    { doReopen(); return itsLatticePtr->doGetSlice (buffer, section); }
+    { Access access(*this, True);
+      return itsLatticePtr->doGetSlice (buffer, section); }
 
   // Do the actual getting of an array of values.
   void doPutSlice (const Array<T>& sourceBuffer,
                    const IPosition& where,
                    const IPosition& stride)
-    { doReopen(); itsLatticePtr->putSlice (sourceBuffer, where, stride); }
+    { Access access(*this, True);
+      itsLatticePtr->putSlice (sourceBuffer, where, stride); }
   
   // Do the reopen of the table (if not open already).
   void doReopen() const
-    { if (itsIsClosed) tempReopen(); }
+    { std::lock_guard<std::recursive_mutex> lock(itsMutex);
+      if (itsIsClosed) tempReopen(); }
+
+  // Move the data to disk if they are not in use.
+  // It is called by TempLatticeMemory.
+  virtual Bool spill();
 
 private:
+  // Prepare an access to the lattice while holding the mutex.
+  // It reopens the lattice if needed and tries to move a spilled lattice
+  // back to memory. A bulk access marks it as the most recently used one.
+  class Access
+  {
+  public:
+    explicit Access (const TempLatticeImpl<T>& impl, Bool bulk=False)
+      : itsLock (impl.itsMutex)
+      { impl.prepare (bulk); }
+  private:
+    std::lock_guard<std::recursive_mutex> itsLock;
+  };
+
   // The copy constructor cannot be used.
   TempLatticeImpl (const TempLatticeImpl<T>& other) ;
     
@@ -229,11 +270,87 @@ private:
   // Make sure that the temporary table gets deleted.
   void deleteTable();
 
+  // Create the scratch table.
+  void makeTable (Double memoryReq);
+
+  // Prepare an access (see class Access).
+  void prepare (Bool bulk) const;
+
+  // Move a spilled lattice back to memory if it fits in the budget.
+  void promote() const;
+
 
   mutable Table                       itsTable;
   mutable std::shared_ptr<Lattice<T>> itsLatticePtr;
-          String                      itsTableName;
+  mutable String                      itsTableName;
   mutable Bool                        itsIsClosed;
+          TiledShape                  itsShape;
+  // Is the lattice on disk although it fits in memory?
+  mutable Bool                        itsIsSpilled;
+  // The number of existing iterators made while spilled.
+  std::shared_ptr<std::atomic<uInt>>  itsNrPinned;
+  // The release count at which a move back to memory was last considered.
+  mutable uInt64                      itsReleaseCount;
+  mutable std::recursive_mutex        itsMutex;
+};
+
+
+
+// <summary>
+// Iterator pinning a spilled TempLattice on disk
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// TempLatticeImpl makes this iterator for a lattice spilled to disk.
+// It iterates through the PagedArray holding the data and counts itself
+// in the number of pins of the lattice, so the lattice is not moved back
+// to memory while the iterator exists.
+// The pin is a base class preceding PagedArrIter, so it is released after
+// the PagedArrIter destructor has written back the cursor.
+// </synopsis>
+
+class TempLatticePin
+{
+public:
+  explicit TempLatticePin (const std::shared_ptr<std::atomic<uInt>>& nrPinned)
+    : itsNrPinned (nrPinned)
+    { ++(*itsNrPinned); }
+  TempLatticePin (const TempLatticePin& other)
+    : itsNrPinned (other.itsNrPinned)
+    { ++(*itsNrPinned); }
+  ~TempLatticePin()
+    { --(*itsNrPinned); }
+private:
+  TempLatticePin& operator= (const TempLatticePin&);
+  std::shared_ptr<std::atomic<uInt>> itsNrPinned;
+};
+
+template<class T> class TempLatticeIter : private TempLatticePin,
+                                          public PagedArrIter<T>
+{
+public:
+  TempLatticeIter (const PagedArray<T>& data,
+                   const LatticeNavigator& method, Bool useRef,
+                   const std::shared_ptr<std::atomic<uInt>>& nrPinned)
+    : TempLatticePin  (nrPinned),
+      PagedArrIter<T> (data, method, useRef)
+    {}
+
+  TempLatticeIter (const TempLatticeIter<T>& other)
+    : TempLatticePin  (other),
+      PagedArrIter<T> (other)
+    {}
+
+  virtual ~TempLatticeIter()
+    {}
+
+  virtual LatticeIterInterface<T>* clone() const
+    { return new TempLatticeIter<T> (*this); }
+
+private:
+  TempLatticeIter<T>& operator= (const TempLatticeIter<T>& other);
 };
 
 
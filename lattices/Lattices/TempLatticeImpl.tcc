@@ -35,26 +35,37 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/System/AppInfo.h>
 #include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl() 
-  : itsLatticePtr (std::make_shared<ArrayLattice<T>>()),
-    itsIsClosed   (False)
+  : itsLatticePtr   (std::make_shared<ArrayLattice<T>>()),
+    itsIsClosed     (False),
+    itsIsSpilled    (False),
+    itsNrPinned     (std::make_shared<std::atomic<uInt>>(0)),
+    itsReleaseCount (0)
 {}
 
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Int maxMemoryInMB)
-  : itsIsClosed (False)
+  : itsIsClosed     (False),
+    itsIsSpilled    (False),
+    itsNrPinned     (std::make_shared<std::atomic<uInt>>(0)),
+    itsReleaseCount (0)
 {
   init (shape, Double(maxMemoryInMB));
 }
 
 template<class T>
 TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Double maxMemoryInMB)
-  : itsIsClosed (False)
+  : itsIsClosed     (False),
+    itsIsSpilled    (False),
+    itsNrPinned     (std::make_shared<std::atomic<uInt>>(0)),
+    itsReleaseCount (0)
 {
   init(shape, maxMemoryInMB);
 }
@@ -62,6 +73,9 @@ TempLatticeImpl<T>::TempLatticeImpl (const TiledShape& shape, Double maxMemoryIn
 template<class T>
 TempLatticeImpl<T>::~TempLatticeImpl()
 {
+  std::lock_guard<std::recursive_mutex> lock(itsMutex);
+  // Give the memory back; thereafter the manager cannot spill it anymore.
+  TempLatticeMemory::release (*this);
   // Reopen to make sure that temporary table gets deleted.
   doReopen();
 }
@@ -77,21 +91,134 @@ void TempLatticeImpl<T>::init (const TiledShape& shape, Double maxMemoryInMB)
   } else {
     memoryAvail = maxMemoryInMB;
   }
+  // Lock, because the manager can access the lattice once reserved.
+  std::lock_guard<std::recursive_mutex> lock(itsMutex);
+  itsShape = shape;
   if (memoryReq > memoryAvail) {
-    // Create a table with a unique name in a work directory.
-    // We can use exclusive locking, since nobody else should use the table.
-    itsTableName = AppInfo::workFileName (Int(memoryReq), "TempLattice");
-    SetupNewTable newtab (itsTableName, TableDesc(), Table::Scratch);
-    itsTable = Table(newtab, TableLock::PermanentLockingWait);
+    makeTable (memoryReq);
     itsLatticePtr = std::make_shared<PagedArray<T>>(shape, itsTable);
+  } else if (! TempLatticeMemory::reserve
+                 (*this, shape.shape().product()*sizeof(T), True)) {
+    // It does not fit in the memory budget, so it is put on disk until
+    // the budget allows it to be moved to memory.
+    makeTable (memoryReq);
+    itsLatticePtr = std::make_shared<PagedArray<T>>(shape, itsTable);
+    itsIsSpilled    = True;
+    itsReleaseCount = TempLatticeMemory::releaseCount();
   } else {
-    itsLatticePtr = std::make_shared<ArrayLattice<T>>(shape.shape());
+    try {
+      itsLatticePtr = std::make_shared<ArrayLattice<T>>(shape.shape());
+    } catch (...) {
+      TempLatticeMemory::release (*this);
+      throw;
+    }
+  }
+}
+
+template<class T>
+void TempLatticeImpl<T>::makeTable (Double memoryReq)
+{
+  // Create a table with a unique name in a work directory.
+  // We can use exclusive locking, since nobody else should use the table.
+  itsTableName = AppInfo::workFileName (Int(memoryReq), "TempLattice");
+  SetupNewTable newtab (itsTableName, TableDesc(), Table::Scratch);
+  itsTable = Table(newtab, TableLock::PermanentLockingWait);
+}
+
+template<class T>
+LatticeIterInterface<T>* TempLatticeImpl<T>::makeIter
+                                   (const LatticeNavigator& navigator,
+                                    Bool useRef) const
+{
+  Access access(*this, True);
+  if (itsIsSpilled) {
+    const PagedArray<T>* paged =
+      dynamic_cast<const PagedArray<T>*>(itsLatticePtr.get());
+    AlwaysAssert (paged != 0, AipsError);
+    return new TempLatticeIter<T> (*paged, navigator, useRef, itsNrPinned);
+  }
+  return itsLatticePtr->makeIter (navigator, useRef);
+}
+
+template<class T>
+void TempLatticeImpl<T>::prepare (Bool bulk) const
+{
+  if (itsIsClosed) {
+    tempReopen();
+  }
+  // Only try to move back to memory if memory has been released since
+  // the previous attempt.
+  if (itsIsSpilled  &&  itsNrPinned->load() == 0  &&
+      itsReleaseCount != TempLatticeMemory::releaseCount()) {
+    promote();
+  }
+  if (bulk) {
+    touch();
+  }
+}
+
+template<class T>
+Bool TempLatticeImpl<T>::spill()
+{
+  // Do not wait if the lattice is in use; the manager takes another one.
+  std::unique_lock<std::recursive_mutex> lock(itsMutex, std::try_to_lock);
+  if (!lock.owns_lock()  ||  isPaged()  ||  itsLatticePtr.use_count() != 1) {
+    return False;
+  }
+  const ArrayLattice<T>* arrLat =
+    dynamic_cast<const ArrayLattice<T>*>(itsLatticePtr.get());
+  // The data cannot be moved if referenced by an iterator or array.
+  if (arrLat == 0  ||  arrLat->asArray().nrefs() != 1) {
+    return False;
+  }
+  try {
+    makeTable (Double(itsShape.shape().product()*sizeof(T)) /
+               (1024.0*1024.0));
+    std::shared_ptr<Lattice<T>> paged =
+      std::make_shared<PagedArray<T>>(itsShape, itsTable);
+    paged->put (arrLat->asArray());
+    itsLatticePtr = paged;
+  } catch (std::exception&) {
+    itsTable = Table();
+    itsTableName = String();
+    return False;
+  }
+  itsIsSpilled = True;
+  // The manager increments the release count after the spill.
+  itsReleaseCount = TempLatticeMemory::releaseCount() + 1;
+  return True;
+}
+
+template<class T>
+void TempLatticeImpl<T>::promote() const
+{
+  itsReleaseCount = TempLatticeMemory::releaseCount();
+  TempLatticeImpl<T>& self = const_cast<TempLatticeImpl<T>&>(*this);
+  if (! TempLatticeMemory::reserve
+          (self, itsShape.shape().product()*sizeof(T), False)) {
+    return;
+  }
+  try {
+    // Use a non-const array to get a writable lattice.
+    Array<T> data (itsLatticePtr->get());
+    std::shared_ptr<Lattice<T>> arrLat =
+      std::make_shared<ArrayLattice<T>>(data);
+    // Deleting the (scratch) table removes it from disk.
+    itsLatticePtr = arrLat;
+    itsTable.markForDelete();
+    itsTable = Table();
+    itsTableName = String();
+  } catch (...) {
+    TempLatticeMemory::release (self);
+    throw;
   }
+  itsIsSpilled = False;
 }
 
 template<class T>
 void TempLatticeImpl<T>::tempClose()
 {
+  std::lock_guard<std::recursive_mutex> lock(itsMutex);
   if (!itsTable.isNull() && isPaged()) {
     // Take care that table does not get deleted, otherwise we cannot reopen.
     itsTable.unmarkForDelete();
@@ -0,0 +1,261 @@
+//# TempLatticeMemory.cc: Memory budget shared by all TempLattice objects
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/Lattices/TempLatticeMemory.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/iostream.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  const Double MB = 1024.0*1024.0;
+
+  // The state of the manager; all but the counters are guarded by the mutex.
+  struct MemoryState
+  {
+    MemoryState()
+      : budget (-1), used (0), peak (0), nSpilled (0), nPromoted (0)
+    {
+      // Default budget is half of the memory (in MB).
+      Double budgetInMB;
+      AipsrcValue<Double>::find (budgetInMB, "templattice.memory",
+                                 Double(HostInfo::memoryTotal(true)) /
+                                 1024.0 / 2.0);
+      if (budgetInMB >= 0) {
+        budget = Int64(budgetInMB * MB);
+      }
+    }
+
+    std::mutex mutex;
+    // The budget in bytes; negative is unlimited.
+    Int64 budget;
+    uInt64 used;
+    uInt64 peak;
+    uInt64 nSpilled;
+    uInt64 nPromoted;
+    std::map<TempLatticeMemory::Client*, uInt64> clients;
+    // The clients being spilled (outside the mutex) by reserve.
+    std::set<TempLatticeMemory::Client*> spilling;
+    // Notified when a spill has finished.
+    std::condition_variable spillDone;
+  };
+
+  MemoryState& theState()
+  {
+    static MemoryState state;
+    return state;
+  }
+
+  std::atomic<uInt64> theClock (0);
+  std::atomic<uInt64> theReleaseCount (0);
+
+} //# end anonymous namespace
+
+
+TempLatticeMemory::Client::Client()
+: itsLastUse (0)
+{
+  touch();
+}
+
+TempLatticeMemory::Client::~Client()
+{}
+
+void TempLatticeMemory::Client::touch() const
+{
+  itsLastUse.store (++theClock);
+}
+
+
+void TempLatticeMemory::setBudget (Double budgetInMB)
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.budget = (budgetInMB < 0  ?  -1 : Int64(budgetInMB * MB));
+}
+
+Double TempLatticeMemory::budget()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return (state.budget < 0  ?  -1 : state.budget / MB);
+}
+
+Double TempLatticeMemory::used()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.used / MB;
+}
+
+Double TempLatticeMemory::peak()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.peak / MB;
+}
+
+uInt TempLatticeMemory::nInMemory()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.clients.size();
+}
+
+uInt64 TempLatticeMemory::nSpilled()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.nSpilled;
+}
+
+uInt64 TempLatticeMemory::nPromoted()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.nPromoted;
+}
+
+void TempLatticeMemory::resetStatistics()
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.peak = state.used;
+  state.nSpilled = 0;
+  state.nPromoted = 0;
+}
+
+void TempLatticeMemory::showStatistics (ostream& os)
+{
+  MemoryState& state = theState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  os << "TempLattice memory budget: ";
+  if (state.budget < 0) {
+    os << "unlimited";
+  } else {
+    os << state.budget / MB << " MB";
+  }
+  os << endl;
+  os << "  used: " << state.used / MB << " MB by "
+     << state.clients.size() << " lattices" << endl;
+  os << "  peak: " << state.peak / MB << " MB" << endl;
+  os << "  spilled to disk: " << state.nSpilled
+     << "  moved back to memory: " << state.nPromoted << endl;
+}
+
+Bool TempLatticeMemory::reserve (Client& client, uInt64 nbytes,
+                                 Bool spillOthers)
+{
+  MemoryState& state = theState();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  // Wait until another thread has finished spilling the client (it can
+  // move itself back to memory right after the spill).
+  state.spillDone.wait (lock, [&state, &client]()
+                        { return state.spilling.count(&client) == 0; });
+  // A new reservation replaces an old one.
+  auto iter = state.clients.find (&client);
+  if (iter != state.clients.end()) {
+    state.used -= iter->second;
+    state.clients.erase (iter);
+  }
+  // Spill the least recently used clients until the request fits.
+  // A victim is chosen while holding the lock, but spilled outside it
+  // because writing it to disk can take long. Meanwhile its release
+  // waits until the spill has finished, so the victim stays alive.
+  std::set<Client*> tried;
+  while (state.budget >= 0  &&  state.used + nbytes > uInt64(state.budget)) {
+    if (! spillOthers) {
+      return False;
+    }
+    Client* victim = 0;
+    uInt64 victimUse = 0;
+    for (const auto& c : state.clients) {
+      if (state.spilling.count(c.first) == 0  &&  tried.count(c.first) == 0) {
+        uInt64 lastUse = c.first->lastUse();
+        if (victim == 0  ||  lastUse < victimUse) {
+          victim    = c.first;
+          victimUse = lastUse;
+        }
+      }
+    }
+    if (victim == 0) {
+      return False;
+    }
+    tried.insert (victim);
+    state.spilling.insert (victim);
+    lock.unlock();
+    Bool spilled = victim->spill();
+    lock.lock();
+    state.spilling.erase (victim);
+    if (spilled) {
+      auto viter = state.clients.find (victim);
+      if (viter != state.clients.end()) {
+        state.used -= viter->second;
+        state.clients.erase (viter);
+      }
+      state.nSpilled++;
+      theReleaseCount++;
+    }
+    state.spillDone.notify_all();
+  }
+  state.clients[&client] = nbytes;
+  state.used += nbytes;
+  state.peak = std::max (state.peak, state.used);
+  if (! spillOthers) {
+    state.nPromoted++;
+  }
+  return True;
+}
+
+void TempLatticeMemory::release (Client& client)
+{
+  MemoryState& state = theState();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  // Wait until another thread has finished spilling the client.
+  state.spillDone.wait (lock, [&state, &client]()
+                        { return state.spilling.count(&client) == 0; });
+  auto iter = state.clients.find (&client);
+  if (iter != state.clients.end()) {
+    state.used -= iter->second;
+    state.clients.erase (iter);
+    theReleaseCount++;
+  }
+}
+
+uInt64 TempLatticeMemory::releaseCount()
+{
+  return theReleaseCount.load();
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,172 @@
+//# TempLatticeMemory.h: Memory budget shared by all TempLattice objects
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_TEMPLATTICEMEMORY_H
+#define LATTICES_TEMPLATTICEMEMORY_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/iosfwd.h>
+#include <atomic>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Memory budget shared by all TempLattice objects
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTempLattice.cc" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class="TempLattice">TempLattice</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A TempLattice is held in memory if it fits, otherwise in a scratch table
+// on disk. Each TempLattice decides that on its own, so a process creating
+// many of them could exhaust the memory. Therefore all in-memory
+// TempLattices share a memory budget, which is managed by this class.
+// <p>
+// If a new TempLattice does not fit in the remaining budget, the least
+// recently used in-memory TempLattices are spilled to disk until it fits.
+// A TempLattice can only be spilled if its data are not in use, i.e. if no
+// iterator or array references them. If still not enough memory can be
+// freed, the new TempLattice is created on disk.
+// A TempLattice is written to disk without holding the lock of the
+// manager, so other threads can meanwhile use the manager.
+// <br>A spilled TempLattice is moved back to memory when it is accessed
+// and meanwhile enough memory has been released, unless an iterator made
+// for it while on disk still exists. Moving back never spills other
+// TempLattices.
+// <p>
+// The budget (in MB) is given by the aipsrc variable
+// <src>templattice.memory</src>. It defaults to half of the memory
+// (as given by <src>HostInfo::memoryTotal(True)</src>).
+// A negative value means an unlimited budget, thus nothing gets spilled.
+// The budget can also be set at runtime using <src>setBudget</src>.
+// Note that the size given when constructing a TempLattice still limits
+// the memory that lattice can use.
+// <p>
+// Statistics about the memory use can be obtained for monitoring.
+// All functions are thread-safe.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   // Let all temporary lattices use at most 2 GB.
+//   TempLatticeMemory::setBudget (2048);
+//   ... create and use TempLattice objects ...
+//   TempLatticeMemory::showStatistics (cout);
+// </srcblock>
+// </example>
+
+
+class TempLatticeMemory
+{
+public:
+  // The interface of a TempLattice (implementation) to the manager.
+  class Client
+  {
+  public:
+    Client();
+    virtual ~Client();
+
+    // Move the data to disk if they are not in use.
+    // It returns False if not possible.
+    // It is called by the manager, which does the bookkeeping.
+    virtual Bool spill() = 0;
+
+    // Mark the client as the most recently used one.
+    void touch() const;
+
+    // Get the time stamp of the last use.
+    uInt64 lastUse() const
+      { return itsLastUse.load(); }
+
+  private:
+    mutable std::atomic<uInt64> itsLastUse;
+  };
+
+  // Set the memory budget in MB. A negative value means unlimited.
+  // If the budget is lowered, nothing is spilled until memory is needed.
+  static void setBudget (Double budgetInMB);
+
+  // Get the memory budget in MB (negative means unlimited).
+  static Double budget();
+
+  // Get the memory (in MB) used by the in-memory TempLattices.
+  static Double used();
+
+  // Get the peak memory usage (in MB) since the start or the last
+  // call to <src>resetStatistics</src>.
+  static Double peak();
+
+  // Get the number of TempLattices held in memory.
+  static uInt nInMemory();
+
+  // Get the number of times a TempLattice was spilled to disk or moved
+  // back to memory.
+  // <group>
+  static uInt64 nSpilled();
+  static uInt64 nPromoted();
+  // </group>
+
+  // Reset the peak and the spill and promotion counts.
+  static void resetStatistics();
+
+  // Show the budget and statistics.
+  static void showStatistics (ostream& os);
+
+  // Reserve memory for a client. If <src>spillOthers=True</src>, the
+  // least recently used other clients are spilled if needed. Otherwise
+  // the client is moving back to memory, which is counted as a promotion.
+  // It returns False if the memory could not be reserved.
+  // A client has one reservation, so a new one replaces the old one.
+  // If the client is being spilled by another thread, it waits until done.
+  static Bool reserve (Client& client, uInt64 nbytes, Bool spillOthers);
+
+  // Release the memory reserved for a client (if any).
+  // If the client is being spilled by another thread, it waits until done.
+  static void release (Client& client);
+
+  // Get the number of times memory has been released.
+  // A spilled client can compare it with its value at the time it was
+  // spilled to know if it makes sense to try to move back to memory.
+  static uInt64 releaseCount();
+
+private:
+  // This class has only static functions.
+  TempLatticeMemory();
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
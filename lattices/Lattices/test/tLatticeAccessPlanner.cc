@@ -0,0 +1,169 @@
+//# tLatticeAccessPlanner.cc: Test program for class LatticeAccessPlanner
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/Lattices/LatticeAccessPlanner.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
+#include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+
+#include <casacore/casa/namespace.h>
+
+void testModel()
+{
+  // Spectra in a cube with 4x4x4 tiles.
+  IPosition shape(3,64,64,32);
+  IPosition tile(3,16,16,8);
+  LatticeAccessPlanner planner(shape, tile, IPosition(3,1,1,32));
+  IPosition path(3,0,1,2);
+  // Without caching each spectrum reads 4 tiles.
+  AlwaysAssertExit (planner.tileReads(path, 1) == 64*64*4);
+  // Caching the tiles of a spectrum avoids rereading along x.
+  AlwaysAssertExit (planner.tileReads(path, 4) == 4*64*4);
+  // Caching a row of spectra avoids rereading along y.
+  AlwaysAssertExit (planner.tileReads(path, 16) == 64);
+  AlwaysAssertExit (planner.tileReads(path, 1000) == 64);
+  AlwaysAssertExit (planner.cacheSize(path, 0) == 16);
+  AlwaysAssertExit (planner.cacheSize(path, 100) == 16);
+  AlwaysAssertExit (planner.cacheSize(path, 10) == 4);
+  AlwaysAssertExit (planner.cacheSize(path, 2) == 1);
+  // A cursor matching the tiles needs no cache.
+  LatticeAccessPlanner tilePlanner(shape, tile, tile);
+  AlwaysAssertExit (tilePlanner.tileReads(path, 1) == 64);
+  AlwaysAssertExit (tilePlanner.cacheSize(path, 0) == 1);
+  // A window which is not aligned with the tiles.
+  LatticeAccessPlanner winPlanner(shape, tile, IPosition(3,1,1,32),
+                                  IPosition(3,8,8,0), IPosition(3,39,23,31));
+  AlwaysAssertExit (winPlanner.tileReads(path, 1) == 32*16*4);
+  AlwaysAssertExit (winPlanner.tileReads(path, 100) == 3*2*4);
+  // The maximum cache size in tiles allows an overdraft of 10%.
+  AlwaysAssertExit (LatticeAccessPlanner::maxCacheSize(0, 1024) == 0);
+  AlwaysAssertExit (LatticeAccessPlanner::maxCacheSize(1, 1024) == 1126);
+}
+
+void testBestPath()
+{
+  // Lines along x with tiles being x-z planes: stepping along z first
+  // keeps the tiles in a small cache.
+  IPosition shape(3,64,64,64);
+  IPosition tile(3,64,1,16);
+  LatticeAccessPlanner planner(shape, tile, IPosition(3,64,1,1));
+  AlwaysAssertExit (planner.tileReads(IPosition(3,0,1,2), 8) == 64*64);
+  AlwaysAssertExit (planner.tileReads(IPosition(3,0,2,1), 8) == 4*64);
+  IPosition best = planner.bestAxisPath (8);
+  AlwaysAssertExit (planner.tileReads(best, planner.cacheSize(best, 8)) ==
+                    4*64);
+  AlwaysAssertExit (best(0) == 2  ||  best(1) == 2);
+  // Without a limit a path needing a smaller cache is preferred.
+  AlwaysAssertExit (planner.cacheSize(IPosition(3,0,1,2), 0) == 64);
+  AlwaysAssertExit (planner.cacheSize(best, 0) == 1);
+  AlwaysAssertExit (planner.bestAxisPath(0, IPosition(3,0,1,2)) == best);
+  // If all paths are equally good, the given path is kept.
+  LatticeAccessPlanner tilePlanner(shape, tile, tile);
+  AlwaysAssertExit (tilePlanner.bestAxisPath(0, IPosition(3,2,1,0)) ==
+                    IPosition(3,2,1,0));
+  // The stepper visits all lines.
+  LatticeStepper stepper = planner.makeStepper (8);
+  AlwaysAssertExit (stepper.axisPath() == best);
+  uInt nsteps = 0;
+  for (stepper.reset(); !stepper.atEnd(); stepper++) {
+    nsteps++;
+  }
+  AlwaysAssertExit (nsteps == 64*64);
+}
+
+void testIterator()
+{
+  IPosition shape(3,64,64,32);
+  IPosition tile(3,16,16,8);
+  {
+    SetupNewTable newtab ("tLatticeAccessPlanner_tmp.data", TableDesc(),
+                          Table::New);
+    Table tab(newtab);
+    PagedArray<Float> pa(TiledShape(shape, tile), tab);
+    Array<Float> arr(shape);
+    indgen (arr);
+    pa.put (arr);
+  }
+  Table tab("tLatticeAccessPlanner_tmp.data", Table::Update);
+  tab.markForDelete();
+  PagedArray<Float> pa(tab);
+  // Iterating through spectra reads each tile once.
+  {
+    RO_LatticeIterator<Float> iter(pa, IPosition(3,1,1,32));
+    Float sum = 0;
+    for (iter.reset(); !iter.atEnd(); iter++) {
+      sum += iter.cursor()(IPosition(3,0));
+    }
+    cout << "spectra: expected " << iter.expectedTileReads()
+         << " actual " << iter.actualTileReads() << endl;
+    AlwaysAssertExit (iter.expectedTileReads() == 64);
+    AlwaysAssertExit (iter.actualTileReads() == 64);
+  }
+  // The model also predicts the reads with a too small cache.
+  {
+    LatticeStepper stepper(shape, IPosition(3,1,1,32));
+    RO_LatticeIterator<Float> iter(pa, stepper);
+    pa.setCacheSizeInTiles (4);
+    for (iter.reset(); !iter.atEnd(); iter++) {
+      AlwaysAssertExit (iter.cursor().nelements() == 32);
+    }
+    LatticeAccessPlanner planner(shape, tile, IPosition(3,1,1,32));
+    AlwaysAssertExit (iter.actualTileReads() ==
+                      planner.tileReads(stepper.axisPath(), 4));
+  }
+  // An iterator on an in-memory lattice does not read tiles.
+  {
+    ArrayLattice<Float> lat(shape);
+    RO_LatticeIterator<Float> iter(lat, IPosition(3,1,1,32));
+    AlwaysAssertExit (iter.expectedTileReads() == 0);
+    AlwaysAssertExit (iter.actualTileReads() == 0);
+  }
+}
+
+int main()
+{
+  try {
+    testModel();
+    testBestPath();
+    testIterator();
+  } catch (std::exception& x) {
+    cout << "Caught exception: " << x.what() << endl;
+    cout << "FAIL" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -37,6 +37,9 @@
 #include <casacore/lattices/LRegions/LCBox.h>
 #include <casacore/lattices/Lattices/LatticeConcat.h>
 #include <casacore/lattices/Lattices/SubLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableUtil.h>
 #include <casacore/casa/iostream.h>
 
 
@@ -54,6 +57,7 @@ void check5 (const Slicer& sl, MaskedLattice<Float>& ml1,
 void check6 (uInt axis, Lattice<Bool>& ml,
              Lattice<Bool>& ml1, Lattice<Bool>& ml2);
 void check7 (const Slicer& sl, LatticeConcat<Float>& lc, Float val, Bool valMask);
+void checkPaged();
 
 
 int main() {
@@ -714,6 +718,10 @@ int main() {
          check (0, lc, ml1, ml2);
      }
 
+// Paged lattices
+
+      checkPaged();
+
 // Some forced errors
 
       {
@@ -839,3 +847,88 @@ void check7 (const Slicer& sl, LatticeConcat<Float>& lc, Float val, Bool valMask
    AlwaysAssert(allNear(lc.getSlice(sl),val,tol),AipsError);
    AlwaysAssert(allEQ(lc.getMaskSlice(sl),valMask),AipsError);
 }
+
+
+void checkPaged()
+{
+   cout << "Paged lattices" << endl;
+   const uInt nlat = 5;
+   IPosition shape(3,8,6,2);
+   Vector<String> names(nlat);
+   for (uInt i=0; i<nlat; i++) {
+      names(i) = "tLatticeConcat_tmp.data" + String::toString(i);
+      PagedArray<Float> pa(shape, names(i));
+      pa.set (Float(i));
+   }
+//
+   for (uInt maxOpen=0; maxOpen<=nlat+1; maxOpen+=2) {
+      LatticeConcat<Float> lc(2, True);
+      LatticeConcat<Float> lc1(3, True);
+      lc.setMaxOpen (maxOpen);
+      lc1.setMaxOpen (maxOpen);
+      AlwaysAssert(lc.maxOpen()==maxOpen, AipsError);
+      for (uInt i=0; i<nlat; i++) {
+         PagedArray<Float> pa(names(i));
+         SubLattice<Float> ml(pa, True);
+         lc.setLattice (ml);
+         lc1.setLattice (ml);
+      }
+      AlwaysAssert(lc.shape()==IPosition(3,8,6,2*nlat), AipsError);
+      AlwaysAssert(lc1.shape()==IPosition(4,8,6,2,nlat), AipsError);
+
+// Read spectra across all lattices (in parallel if possible).
+
+      for (uInt iter=0; iter<2; iter++) {
+         Array<Float> spec = lc.getSlice (IPosition(3,1,2,0),
+                                          IPosition(3,1,1,2*nlat));
+         Array<Float> spec1 = lc1.getSlice (IPosition(4,3,4,1,0),
+                                            IPosition(4,1,1,1,nlat));
+         for (uInt i=0; i<nlat; i++) {
+            AlwaysAssert(spec(IPosition(3,0,0,2*i))==Float(i), AipsError);
+            AlwaysAssert(spec(IPosition(3,0,0,2*i+1))==Float(i), AipsError);
+            AlwaysAssert(spec1(IPosition(4,0,0,0,i))==Float(i), AipsError);
+         }
+      }
+      Array<Float> strided = lc.getSlice (Slicer(IPosition(3,0,1,1),
+                                                 IPosition(3,7,5,2*nlat-1),
+                                                 IPosition(3,2,2,2),
+                                                 Slicer::endIsLast));
+      AlwaysAssert(strided.shape()==IPosition(3,4,3,nlat), AipsError);
+      for (uInt i=0; i<nlat; i++) {
+         AlwaysAssert(allEQ(strided(IPosition(3,0,0,i), IPosition(3,3,2,i)),
+                            Float(i)), AipsError);
+      }
+      AlwaysAssert(allEQ(lc.getMask(), True), AipsError);
+
+// At most maxOpen lattices are kept open.
+
+      lc1.tempClose();
+      uInt nopen = 0;
+      for (uInt i=0; i<nlat; i++) {
+         if (Table::isOpened(names(i))) nopen++;
+      }
+      AlwaysAssert(nopen==min(maxOpen,nlat), AipsError);
+      lc.tempClose();
+      for (uInt i=0; i<nlat; i++) {
+         AlwaysAssert(!Table::isOpened(names(i)), AipsError);
+      }
+
+// Writing obeys maxOpen as well.
+
+      Array<Float> orig = lc.get();
+      Array<Float> arr(lc.shape(), Float(-1));
+      lc.put (arr);
+      nopen = 0;
+      for (uInt i=0; i<nlat; i++) {
+         if (Table::isOpened(names(i))) nopen++;
+      }
+      AlwaysAssert(nopen==min(maxOpen,nlat), AipsError);
+      AlwaysAssert(allEQ(lc.get(), Float(-1)), AipsError);
+      lc.put (orig);
+      lc.tempClose();
+   }
+//
+   for (uInt i=0; i<nlat; i++) {
+      TableUtil::deleteTable (names(i));
+   }
+}
@@ -29,6 +29,8 @@
 #include <casacore/lattices/Lattices/LatticeStepper.h>
 #include <casacore/lattices/Lattices/TileStepper.h>
 #include <casacore/lattices/Lattices/TiledLineStepper.h>
+#include <casacore/lattices/LEL/LatticeExpr.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/iostream.h>
 
@@ -97,9 +99,33 @@ void getTiles (const Lattice<Float>& lattice)
   timer.show ("getTiles");
 }
 
+void evalExpr (const Lattice<Float>& lattice)
+{
+  // Evaluate an expression into a scratch lattice with the same tiling
+  // using 1 thread and all threads.
+  PagedArray<Float> out (TiledShape(lattice.shape(), lattice.niceCursorShape()),
+                         "tLatticePerf_tmp.out");
+  LatticeExpr<Float> expr ((lattice - 2*lattice) / sqrt(abs(lattice) + 1));
+  uInt nthread = OMP::maxThreads();
+  for (uInt n=1; n<=nthread; n*=2) {
+    if (n*2 > nthread) {
+      n = nthread;
+    }
+    OMP::setNumThreads (n);
+    Timer timer;
+    out.copyData (expr);
+    cout << n << (n==1 ? " thread  " : " threads ");
+    timer.show ("expr    ");
+  }
+  OMP::setNumThreads (nthread);
+}
+
 void getCube (const Lattice<Float>& lattice, const String& trav)
 {
-  if (trav == "x") {
+  if (trav == "expr") {
+    cout << endl;
+    evalExpr (lattice);
+  } else if (trav == "x") {
     cout << "x  ";
     getLine (lattice, 0);
   } else if (trav == "y") {
@@ -134,6 +160,8 @@ int main (int argc, char* argv[])
     cerr << "        else       use PagedArray<Float> (is default)" << endl;
     cerr << "  type  x,y,z      read vectors along this axis" << endl;
     cerr << "        xy,xz,yz   read planes along these axes" << endl;
+    cerr << "        expr       evaluate an expression using 1..n threads"
+         << endl;
     cerr << "        else       read tile by tile" << endl;
     exit(0);
   }
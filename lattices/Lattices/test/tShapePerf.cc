@@ -0,0 +1,186 @@
+//# tShapePerf.cc: Time the shape arithmetic in tiled I/O paths
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
+#include <casacore/tables/DataMan/TSMShape.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/sstream.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+// This program times the shape arithmetic done for each step in the
+// inner loops of tiled I/O, i.e. the IPosition helper functions, the
+// TSMShape offset increments, small sections read from a tiled cube
+// (each read goes through TSMCube::accessSection) and the stepping of
+// a LatticeStepper with a small cursor.
+// Run it as:  tShapePerf [nloops]
+
+
+void timeIPosition (const IPosition& shape, uInt nloops)
+{
+  cout << "IPosition functions for shape " << shape << endl;
+  const uInt nd = shape.size();
+  IPosition axes(2, 0, nd-1);
+  IPosition degShape(shape);
+  degShape[1] = 1;
+  IPosition other(2, 3, 4);
+  size_t n = 0;
+  Timer timer;
+  for (uInt i=0; i<nloops; ++i) {
+    n += shape.removeAxes(axes).size();
+  }
+  timer.show ("  removeAxes        ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    n += shape.keepAxes(axes).size();
+  }
+  timer.show ("  keepAxes          ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    n += degShape.nonDegenerate().size();
+  }
+  timer.show ("  nonDegenerate     ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    n += shape.concatenate(other).size();
+  }
+  timer.show ("  concatenate       ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    n += shape.getFirst(nd-1).size();
+  }
+  timer.show ("  getFirst          ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    n += IPosition::makeAxisPath(nd, axes).size();
+  }
+  timer.show ("  makeAxisPath      ");
+  timer.mark();
+  IPosition start, end, stride;
+  for (uInt i=0; i<nloops; ++i) {
+    Slicer slicer(IPosition(nd,0), shape, Slicer::endIsLength);
+    n += slicer.inferShapeFromSource(shape, start, end, stride).size();
+  }
+  timer.show ("  Slicer            ");
+  AlwaysAssertExit (n > 0);
+}
+
+void timeTSMShape (const IPosition& shape, uInt nloops)
+{
+  cout << "TSMShape offset increments for shape " << shape << endl;
+  TSMShape tsmShape(shape);
+  IPosition subShape(shape);
+  subShape[0] = 2;
+  IPosition incr;
+  ssize_t n = 0;
+  Timer timer;
+  for (uInt i=0; i<nloops; ++i) {
+    incr = tsmShape.offsetIncrement (subShape);
+    incr *= 4;
+    n += incr[0];
+  }
+  timer.show ("  offsetIncrement   ");
+  timer.mark();
+  for (uInt i=0; i<nloops; ++i) {
+    tsmShape.offsetIncrement (incr, subShape, 4);
+    n -= incr[0];
+  }
+  timer.show ("  in-place          ");
+  AlwaysAssertExit (n == 0);
+}
+
+void timeSections (const IPosition& shape, const IPosition& tileShape,
+                   const IPosition& sectionShape)
+{
+  cout << "Reading sections " << sectionShape << " from a cube " << shape
+       << " with tile shape " << tileShape << endl;
+  PagedArray<Float> lattice (TiledShape(shape, tileShape),
+                             "tShapePerf_tmp.tab");
+  lattice.set (1);
+  // Read the entire cube to have all tiles in the cache.
+  lattice.setCacheSizeInTiles (lattice.shape().product() /
+                               tileShape.product() + 1);
+  Array<Float> arr;
+  lattice.getSlice (arr, IPosition(shape.size(), 0), shape);
+  LatticeStepper stepper(shape, sectionShape);
+  Double sum = 0;
+  Timer timer;
+  for (stepper.reset(); !stepper.atEnd(); stepper++) {
+    lattice.getSlice (arr, stepper.position(), sectionShape);
+    sum += arr.data()[0];
+  }
+  timer.show ("  getSlice          ");
+  cout << "  nsteps " << stepper.nsteps() << endl;
+  AlwaysAssertExit (sum == stepper.nsteps());
+}
+
+void timeStepper (const IPosition& shape, const IPosition& cursorShape)
+{
+  cout << "Stepping cursor " << cursorShape << " through " << shape << endl;
+  LatticeStepper stepper(shape, cursorShape);
+  Timer timer;
+  for (stepper.reset(); !stepper.atEnd(); stepper++) {
+  }
+  timer.show ("  forward           ");
+  uInt nsteps = stepper.nsteps();
+  timer.mark();
+  while (stepper--) {
+  }
+  timer.show ("  backward          ");
+  cout << "  nsteps " << nsteps << endl;
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt nloops = 1000000;
+    if (argc > 1) {
+      istringstream istr(argv[1]);
+      istr >> nloops;
+    }
+    timeIPosition (IPosition(3, 100, 100, 50), nloops);
+    timeIPosition (IPosition(6, 10, 20, 4, 5, 6, 3), nloops);
+    timeTSMShape (IPosition(3, 100, 100, 50), nloops);
+    timeTSMShape (IPosition(6, 10, 20, 4, 5, 6, 3), nloops);
+    timeSections (IPosition(5, 32, 32, 16, 4, 8),
+                  IPosition(5, 16, 16, 4, 2, 2),
+                  IPosition(5, 2, 2, 1, 1, 1));
+    timeSections (IPosition(3, 128, 128, 64),
+                  IPosition(3, 32, 32, 8),
+                  IPosition(3, 4, 1, 1));
+    // A cursor not fitting nicely causes hangover checks.
+    timeStepper (IPosition(5, 64, 64, 16, 4, 8), IPosition(5, 3, 3, 1, 1, 1));
+    timeStepper (IPosition(3, 512, 512, 64), IPosition(3, 4, 4, 1));
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -25,15 +25,19 @@
 
 
 #include <casacore/lattices/Lattices/TempLattice.h>
+#include <casacore/lattices/Lattices/TempLatticeMemory.h>
 #include <casacore/lattices/Lattices/LatticeIterator.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Utilities/COWPtr.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <atomic>
+#include <thread>
 
 
 #include <casacore/casa/namespace.h>
@@ -71,6 +75,125 @@ void doIt (TempLattice<Int>& scratch)
     AlwaysAssert(scratch.getAt(IPosition(3,7)) == 7, AipsError);
 }
 
+void checkData (const TempLattice<Float>& lat, Float offset)
+{
+    Array<Float> expected(lat.shape());
+    indgen (expected, offset);
+    AlwaysAssertExit (allEQ (lat.get(), expected));
+}
+
+TempLattice<Float> makeLattice (Float offset)
+{
+    // Each lattice uses 0.5 MB.
+    TempLattice<Float> lat(IPosition(2,512,256));
+    Array<Float> arr(lat.shape());
+    indgen (arr, offset);
+    lat.put (arr);
+    return lat;
+}
+
+void testBudget()
+{
+    Double oldBudget = TempLatticeMemory::budget();
+    TempLatticeMemory::setBudget (1.2);
+    TempLatticeMemory::resetStatistics();
+    {
+      TempLattice<Float> a = makeLattice(0);
+      TempLattice<Float> b = makeLattice(1);
+      AlwaysAssertExit (!a.isPaged() && !b.isPaged());
+      AlwaysAssertExit (TempLatticeMemory::nInMemory() == 2);
+      AlwaysAssertExit (near (TempLatticeMemory::used(), 1.));
+      // Use a, so b is spilled when c is created.
+      checkData (a, 0);
+      {
+        TempLattice<Float> c = makeLattice(2);
+        AlwaysAssertExit (!a.isPaged() && b.isPaged() && !c.isPaged());
+        AlwaysAssertExit (TempLatticeMemory::nSpilled() == 1);
+        checkData (b, 1);
+        // No memory was released, so b stays on disk.
+        AlwaysAssertExit (b.isPaged());
+        checkData (c, 2);
+      }
+      // c has gone, so b moves back to memory when used.
+      checkData (b, 1);
+      AlwaysAssertExit (!b.isPaged());
+      AlwaysAssertExit (TempLatticeMemory::nPromoted() == 1);
+      AlwaysAssertExit (near (TempLatticeMemory::peak(), 1.));
+      {
+        // A lattice whose data are referenced cannot be spilled.
+        COWPtr<Array<Float> > refa;
+        a.getSlice (refa, IPosition(2,0), a.shape(), IPosition(2,1));
+        RO_LatticeIterator<Float> iterb(b, IPosition(2,512,1));
+        TempLattice<Float> c = makeLattice(2);
+        AlwaysAssertExit (!a.isPaged() && !b.isPaged() && c.isPaged());
+        AlwaysAssertExit (TempLatticeMemory::nSpilled() == 1);
+        checkData (c, 2);
+      }
+      {
+        // The reference is gone, so a (least recently used) is spilled.
+        checkData (b, 1);
+        TempLattice<Float> c = makeLattice(2);
+        AlwaysAssertExit (a.isPaged() && !b.isPaged() && !c.isPaged());
+        // An iterator made on disk keeps a on disk while it exists.
+        {
+          LatticeIterator<Float> itera(a, IPosition(2,512,1));
+          LatticeIterator<Float> itera2(itera);
+          b = TempLattice<Float>();
+          checkData (c, 2);
+          for (itera.reset(); !itera.atEnd(); itera++) {
+            itera.woCursor() = -1;
+            AlwaysAssertExit (a.isPaged());
+          }
+          AlwaysAssertExit (a.getAt(IPosition(2,0,1)) == -1);
+          AlwaysAssertExit (a.isPaged());
+        }
+        // The iterators are gone, so a moves back to memory when used.
+        AlwaysAssertExit (a.getAt(IPosition(2,0,255)) == -1);
+        AlwaysAssertExit (!a.isPaged());
+        AlwaysAssertExit (allEQ (a.get(), Float(-1)));
+        AlwaysAssertExit (TempLatticeMemory::nPromoted() == 2);
+      }
+      AlwaysAssertExit (TempLatticeMemory::nSpilled() == 2);
+      TempLatticeMemory::showStatistics (cout);
+    }
+    AlwaysAssertExit (TempLatticeMemory::nInMemory() == 0);
+    AlwaysAssertExit (TempLatticeMemory::used() == 0);
+    TempLatticeMemory::setBudget (oldBudget);
+}
+
+void testSpillPromote()
+{
+    // One thread uses a, which moves it back to memory if possible, while
+    // another thread makes lattices needing its memory, which spills it.
+    Double oldBudget = TempLatticeMemory::budget();
+    TempLatticeMemory::setBudget (1.2);
+    {
+      TempLattice<Float> a = makeLattice(0);
+      std::atomic<Bool> done(False);
+      std::thread user ([&a, &done]() {
+          while (!done) {
+            checkData (a, 0);
+          }
+        });
+      for (uInt i=0; i<50; ++i) {
+        TempLattice<Float> b = makeLattice(1);
+        TempLattice<Float> c = makeLattice(2);
+        checkData (b, 1);
+        checkData (c, 2);
+      }
+      done = True;
+      user.join();
+      checkData (a, 0);
+      // The budget must only account for a.
+      uInt nmem = (a.isPaged()  ?  0 : 1);
+      AlwaysAssertExit (TempLatticeMemory::nInMemory() == nmem);
+      AlwaysAssertExit (near (TempLatticeMemory::used(), 0.5*nmem));
+    }
+    AlwaysAssertExit (TempLatticeMemory::nInMemory() == 0);
+    AlwaysAssertExit (TempLatticeMemory::used() == 0);
+    TempLatticeMemory::setBudget (oldBudget);
+}
+
 int main() {
   try {
     {
@@ -84,6 +207,8 @@ int main() {
       AlwaysAssertExit (! small.isPaged());
       doIt (small);
     }
+    testBudget();
+    testSpillPromote();
   } catch (std::exception& x) {
     cerr << x.what() << endl;
     cout << "FAIL" << endl;
@@ -41,6 +41,7 @@
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/ColDescSet.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableAttr.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/DataMan/StManAipsIO.h>
@@ -65,14 +66,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 MeasurementSet::MeasurementSet()
 : doNotLockSubtables_p (False),
-  hasBeenDestroyed_p(True) { }
+  hasBeenDestroyed_p(True),
+  subtablesOnDemand_p (False) { }
 
 
 MeasurementSet::MeasurementSet(const String &tableName,
 			       TableOption option) 
     : MSTable<MSMainEnums>(tableName, option), 
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
     // verify that the now opened table is valid
     checkVersion();
@@ -104,7 +107,8 @@ MeasurementSet::MeasurementSet (const String &tableName, const TableLock& lockOp
                                 bool doNotLockSubtables, TableOption option)
 : MSTable<MSMainEnums>(tableName, lockOptions, option),
   doNotLockSubtables_p (doNotLockSubtables),
-  hasBeenDestroyed_p(False)
+  hasBeenDestroyed_p(False),
+  subtablesOnDemand_p (False)
 {
 
   mainLock_p=lockOptions;
@@ -124,7 +128,8 @@ MeasurementSet::MeasurementSet(const String &tableName,
 			       TableOption option) 
     : MSTable<MSMainEnums>(tableName, lockOptions, option), 
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
 
   mainLock_p=lockOptions;
@@ -141,7 +146,8 @@ MeasurementSet::MeasurementSet(const String& tableName, const String &tableDescN
 			       TableOption option)
     : MSTable<MSMainEnums>(tableName, tableDescName, option),
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
   mainLock_p=TableLock(TableLock::AutoNoReadLocking);
     // verify that the now opened table is valid 
@@ -157,7 +163,8 @@ MeasurementSet::MeasurementSet(const String& tableName, const String &tableDescN
 			       const TableLock& lockOptions, TableOption option)
     : MSTable<MSMainEnums>(tableName, tableDescName, lockOptions, option),
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
     // verify that the now opened table is valid 
   mainLock_p=lockOptions;
@@ -173,7 +180,8 @@ MeasurementSet::MeasurementSet(SetupNewTable &newTab, rownr_t nrrow,
 			       Bool initialize)
     : MSTable<MSMainEnums>(newTab, nrrow, initialize), 
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
   mainLock_p=TableLock(TableLock::AutoNoReadLocking);
     // verify that the now opened table is valid
@@ -188,7 +196,8 @@ MeasurementSet::MeasurementSet(SetupNewTable &newTab,
 			       Bool initialize)
     : MSTable<MSMainEnums>(newTab, lockOptions, nrrow, initialize), 
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
   mainLock_p=lockOptions;
     // verify that the now opened table is valid
@@ -201,7 +210,8 @@ MeasurementSet::MeasurementSet(SetupNewTable &newTab,
 MeasurementSet::MeasurementSet(const Table &table, const MeasurementSet * otherMs)
 : MSTable<MSMainEnums>(table),
   doNotLockSubtables_p (False),
-  hasBeenDestroyed_p(False)
+  hasBeenDestroyed_p(False),
+  subtablesOnDemand_p (False)
 {
     mainLock_p=TableLock(TableLock::AutoNoReadLocking);
 
@@ -227,7 +237,8 @@ MeasurementSet::MeasurementSet (MPI_Comm comm,
 			       Bool initialize)
     : MSTable<MSMainEnums>(comm, newTab, nrrow, initialize),
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
   mainLock_p=TableLock(TableLock::AutoNoReadLocking);
     // verify that the now opened table is valid
@@ -243,7 +254,8 @@ MeasurementSet::MeasurementSet (MPI_Comm comm,
 			       Bool initialize)
     : MSTable<MSMainEnums>(comm, newTab, lockOptions, nrrow, initialize),
       doNotLockSubtables_p (False),
-      hasBeenDestroyed_p(False)
+      hasBeenDestroyed_p(False),
+      subtablesOnDemand_p (False)
 {
   mainLock_p=lockOptions;
     // verify that the now opened table is valid
@@ -257,7 +269,8 @@ MeasurementSet::MeasurementSet (MPI_Comm comm,
 MeasurementSet::MeasurementSet(const MeasurementSet &other)
 : MSTable<MSMainEnums>(other),
   doNotLockSubtables_p(other.doNotLockSubtables_p),
-  hasBeenDestroyed_p  (other.hasBeenDestroyed_p)
+  hasBeenDestroyed_p  (other.hasBeenDestroyed_p),
+  subtablesOnDemand_p (False)
 {
   if (! isNull()) {
     copySubtables (other); // others will be handled by initRefs
@@ -325,6 +338,7 @@ MeasurementSet::copySubtables (const MeasurementSet & other)
   // Replace the current subtables with the ones in the other MS
   // if they exist in the other MS; otherwise leave them unchanged.
 
+  std::lock_guard<std::mutex> lock(other.subtableMutex_p);
   copySubtable (other.antenna_p, antenna_p);
   copySubtable (other.dataDesc_p, dataDesc_p);
   copySubtable (other.doppler_p, doppler_p);
@@ -617,6 +631,7 @@ MeasurementSet::openMrSubtable (Subtable & subtable, const String & subtableName
 {
     if (this->keywordSet().isDefined (subtableName) &&  // exists in this MS
         isEligibleForMemoryResidency (subtableName) &&  // is permitted to be MR
+        !openedSubtable (subtable, subtableName).isNull() &&
         subtable.tableType() != Table::Memory){         // is not already MR
 
         MrsDebugLog (2, tableName() + " ---> Converting " + subtable.tableName() + " to MR.");
@@ -675,129 +690,100 @@ MeasurementSet::setMemoryResidentSubtables (const MrsEligibility & mrsEligibilit
 }
 
 
+template <typename Subtable>
+String
+MeasurementSet::subtableTableName (const Subtable & subtable,
+                                   const String & subtableName) const
+{
+    std::lock_guard<std::mutex> lock(subtableMutex_p);
+    if (! subtable.isNull()) {
+        return subtable.tableName();
+    }
+    // Not opened yet; take the name from the keyword, which can refer to
+    // a subtable elsewhere (e.g. for a reference MS).
+    if (! isNull()) {
+        const TableRecord& keys = this->keywordSet();
+        Int fieldNr = keys.fieldNumber (subtableName);
+        if (fieldNr >= 0  &&  keys.type(fieldNr) == TpTable) {
+            return keys.tableAttributes(fieldNr).name();
+        }
+    }
+    return tableName() + "/" + subtableName;
+}
+
 String MeasurementSet::antennaTableName() const
 {
-  if (antenna_p.isNull()) {
-    return tableName()+"/ANTENNA";
-  }
-  return antenna_p.tableName();
+  return subtableTableName (antenna_p, "ANTENNA");
 }
 String MeasurementSet::dataDescriptionTableName() const
 {
-  if (dataDesc_p.isNull()) {
-    return tableName()+"/DATA_DESCRIPTION";
-  }
-  return dataDesc_p.tableName();
+  return subtableTableName (dataDesc_p, "DATA_DESCRIPTION");
 }
 String MeasurementSet::dopplerTableName() const
 {
-  if (doppler_p.isNull()) {
-    return tableName()+"/DOPPLER";
-  }
-  return doppler_p.tableName();
+  return subtableTableName (doppler_p, "DOPPLER");
 }
 String MeasurementSet::feedTableName() const
 {
-  if (feed_p.isNull()) {
-    return tableName()+"/FEED";
-  }
-  return feed_p.tableName();
+  return subtableTableName (feed_p, "FEED");
 }
 String MeasurementSet::fieldTableName() const
 {
-  if (field_p.isNull()) {
-    return tableName()+"/FIELD";
-  }
-  return field_p.tableName();
+  return subtableTableName (field_p, "FIELD");
 }
 String MeasurementSet::flagCmdTableName() const
 {
-  if (flagCmd_p.isNull()) {
-    return tableName()+"/FLAG_CMD";
-  }
-  return flagCmd_p.tableName();
+  return subtableTableName (flagCmd_p, "FLAG_CMD");
 }
 String MeasurementSet::freqOffsetTableName() const
 {
-  if (freqOffset_p.isNull()) {
-    return tableName()+"/FREQ_OFFSET";
-  }
-  return freqOffset_p.tableName();
+  return subtableTableName (freqOffset_p, "FREQ_OFFSET");
 }
 String MeasurementSet::historyTableName() const
 {
-  if (history_p.isNull()) {
-    return tableName()+"/HISTORY";
-  }
-  return history_p.tableName();
+  return subtableTableName (history_p, "HISTORY");
 }
 String MeasurementSet::observationTableName() const
 {
-  if (observation_p.isNull()) {
-    return tableName()+"/OBSERVATION";
-  }
-  return observation_p.tableName();
+  return subtableTableName (observation_p, "OBSERVATION");
 }
 String MeasurementSet::pointingTableName() const
 {
-  if (pointing_p.isNull()) {
-    return tableName()+"/POINTING";
-  }
-  return pointing_p.tableName();
+  return subtableTableName (pointing_p, "POINTING");
 }
 String MeasurementSet::polarizationTableName() const
 {
-  if (polarization_p.isNull()) {
-    return tableName()+"/POLARIZATION";
-  }
-  return polarization_p.tableName();
+  return subtableTableName (polarization_p, "POLARIZATION");
 }
 String MeasurementSet::processorTableName() const
 {
-  if (processor_p.isNull()) {
-    return tableName()+"/PROCESSOR";
-  }
-  return processor_p.tableName();
+  return subtableTableName (processor_p, "PROCESSOR");
 }
 String MeasurementSet::sourceTableName() const
 {
-  if (source_p.isNull()) {
-    return tableName()+"/SOURCE";
-  }
-  return source_p.tableName();
+  return subtableTableName (source_p, "SOURCE");
 }
 String MeasurementSet::spectralWindowTableName() const
 {
-  if (spectralWindow_p.isNull()) {
-    return tableName()+"/SPECTRAL_WINDOW";
-  }
-  return spectralWindow_p.tableName();
+  return subtableTableName (spectralWindow_p, "SPECTRAL_WINDOW");
 }
 String MeasurementSet::stateTableName() const
 {
-  if (state_p.isNull()) {
-    return tableName()+"/STATE";
-  }
-  return state_p.tableName();
+  return subtableTableName (state_p, "STATE");
 }
 String MeasurementSet::sysCalTableName() const
 {
-  if (sysCal_p.isNull()) {
-    return tableName()+"/SYSCAL";
-  }
-  return sysCal_p.tableName();
+  return subtableTableName (sysCal_p, "SYSCAL");
 }
 String MeasurementSet::weatherTableName() const
 {
-  if (weather_p.isNull()) {
-    return tableName()+"/WEATHER";
-  }
-  return weather_p.tableName();
+  return subtableTableName (weather_p, "WEATHER");
 }
 
 void
 MeasurementSet::clearSubtables ()
 {
+    std::lock_guard<std::mutex> lock(subtableMutex_p);
     antenna_p=MSAntenna();
     dataDesc_p=MSDataDescription();
     doppler_p=MSDoppler();
@@ -819,7 +805,7 @@ MeasurementSet::clearSubtables ()
 
 template <typename Subtable>
 void
-MeasurementSet::openSubtable (Subtable & subtable, const String & subtableName, Bool useLock)
+MeasurementSet::openSubtable (Subtable & subtable, const String & subtableName, Bool useLock) const
 {
     if (subtable.isNull() && this->keywordSet().isDefined (subtableName)){
 
@@ -863,29 +849,183 @@ void MeasurementSet::initRefs(Bool clear)
 				      " holding measurements from a Telescope");
     }
 
-    Bool useLock = (this->tableOption() != Table::Scratch);
-
-    openSubtable (antenna_p, "ANTENNA", useLock);
-    openSubtable (dataDesc_p, "DATA_DESCRIPTION", useLock);
-    openSubtable (doppler_p, "DOPPLER", useLock);
-    openSubtable (feed_p, "FEED", useLock);
-    openSubtable (field_p, "FIELD", useLock);
-    openSubtable (flagCmd_p, "FLAG_CMD", useLock);
-    openSubtable (freqOffset_p, "FREQ_OFFSET", useLock);
-    openSubtable (history_p, "HISTORY", useLock);
-    openSubtable (observation_p, "OBSERVATION", useLock);
-    openSubtable (pointing_p, "POINTING", useLock);
-    openSubtable (polarization_p, "POLARIZATION", useLock);
-    openSubtable (processor_p, "PROCESSOR", useLock);
-    openSubtable (source_p, "SOURCE", useLock);
-    openSubtable (spectralWindow_p, "SPECTRAL_WINDOW", useLock);
-    openSubtable (state_p, "STATE", useLock);
-    openSubtable (sysCal_p, "SYSCAL", useLock);
-    openSubtable (weather_p, "WEATHER", useLock);
+    // The subtables are opened on demand (see openedSubtable).
+    subtablesOnDemand_p = True;
 
   }
 }
 
+template <typename Subtable>
+Subtable&
+MeasurementSet::openedSubtable (Subtable & subtable, const String & subtableName) const
+{
+    // Serialize opening, because const accessors can be used concurrently.
+    std::lock_guard<std::mutex> lock(subtableMutex_p);
+    if (subtable.isNull() && subtablesOnDemand_p && !isNull()) {
+        openSubtable (subtable, subtableName,
+                      this->tableOption() != Table::Scratch);
+    }
+    return subtable;
+}
+
+void MeasurementSet::openSubtables()
+{
+    openedSubtable (antenna_p, "ANTENNA");
+    openedSubtable (dataDesc_p, "DATA_DESCRIPTION");
+    openedSubtable (doppler_p, "DOPPLER");
+    openedSubtable (feed_p, "FEED");
+    openedSubtable (field_p, "FIELD");
+    openedSubtable (flagCmd_p, "FLAG_CMD");
+    openedSubtable (freqOffset_p, "FREQ_OFFSET");
+    openedSubtable (history_p, "HISTORY");
+    openedSubtable (observation_p, "OBSERVATION");
+    openedSubtable (pointing_p, "POINTING");
+    openedSubtable (polarization_p, "POLARIZATION");
+    openedSubtable (processor_p, "PROCESSOR");
+    openedSubtable (source_p, "SOURCE");
+    openedSubtable (spectralWindow_p, "SPECTRAL_WINDOW");
+    openedSubtable (state_p, "STATE");
+    openedSubtable (sysCal_p, "SYSCAL");
+    openedSubtable (weather_p, "WEATHER");
+}
+
+MSAntenna& MeasurementSet::antenna()
+{
+  return openedSubtable (antenna_p, "ANTENNA");
+}
+MSDataDescription& MeasurementSet::dataDescription()
+{
+  return openedSubtable (dataDesc_p, "DATA_DESCRIPTION");
+}
+MSDoppler& MeasurementSet::doppler()
+{
+  return openedSubtable (doppler_p, "DOPPLER");
+}
+MSFeed& MeasurementSet::feed()
+{
+  return openedSubtable (feed_p, "FEED");
+}
+MSField& MeasurementSet::field()
+{
+  return openedSubtable (field_p, "FIELD");
+}
+MSFlagCmd& MeasurementSet::flagCmd()
+{
+  return openedSubtable (flagCmd_p, "FLAG_CMD");
+}
+MSFreqOffset& MeasurementSet::freqOffset()
+{
+  return openedSubtable (freqOffset_p, "FREQ_OFFSET");
+}
+MSHistory& MeasurementSet::history()
+{
+  return openedSubtable (history_p, "HISTORY");
+}
+MSObservation& MeasurementSet::observation()
+{
+  return openedSubtable (observation_p, "OBSERVATION");
+}
+MSPointing& MeasurementSet::pointing()
+{
+  return openedSubtable (pointing_p, "POINTING");
+}
+MSPolarization& MeasurementSet::polarization()
+{
+  return openedSubtable (polarization_p, "POLARIZATION");
+}
+MSProcessor& MeasurementSet::processor()
+{
+  return openedSubtable (processor_p, "PROCESSOR");
+}
+MSSource& MeasurementSet::source()
+{
+  return openedSubtable (source_p, "SOURCE");
+}
+MSSpectralWindow& MeasurementSet::spectralWindow()
+{
+  return openedSubtable (spectralWindow_p, "SPECTRAL_WINDOW");
+}
+MSState& MeasurementSet::state()
+{
+  return openedSubtable (state_p, "STATE");
+}
+MSSysCal& MeasurementSet::sysCal()
+{
+  return openedSubtable (sysCal_p, "SYSCAL");
+}
+MSWeather& MeasurementSet::weather()
+{
+  return openedSubtable (weather_p, "WEATHER");
+}
+const MSAntenna& MeasurementSet::antenna() const
+{
+  return openedSubtable (antenna_p, "ANTENNA");
+}
+const MSDataDescription& MeasurementSet::dataDescription() const
+{
+  return openedSubtable (dataDesc_p, "DATA_DESCRIPTION");
+}
+const MSDoppler& MeasurementSet::doppler() const
+{
+  return openedSubtable (doppler_p, "DOPPLER");
+}
+const MSFeed& MeasurementSet::feed() const
+{
+  return openedSubtable (feed_p, "FEED");
+}
+const MSField& MeasurementSet::field() const
+{
+  return openedSubtable (field_p, "FIELD");
+}
+const MSFlagCmd& MeasurementSet::flagCmd() const
+{
+  return openedSubtable (flagCmd_p, "FLAG_CMD");
+}
+const MSFreqOffset& MeasurementSet::freqOffset() const
+{
+  return openedSubtable (freqOffset_p, "FREQ_OFFSET");
+}
+const MSHistory& MeasurementSet::history() const
+{
+  return openedSubtable (history_p, "HISTORY");
+}
+const MSObservation& MeasurementSet::observation() const
+{
+  return openedSubtable (observation_p, "OBSERVATION");
+}
+const MSPointing& MeasurementSet::pointing() const
+{
+  return openedSubtable (pointing_p, "POINTING");
+}
+const MSPolarization& MeasurementSet::polarization() const
+{
+  return openedSubtable (polarization_p, "POLARIZATION");
+}
+const MSProcessor& MeasurementSet::processor() const
+{
+  return openedSubtable (processor_p, "PROCESSOR");
+}
+const MSSource& MeasurementSet::source() const
+{
+  return openedSubtable (source_p, "SOURCE");
+}
+const MSSpectralWindow& MeasurementSet::spectralWindow() const
+{
+  return openedSubtable (spectralWindow_p, "SPECTRAL_WINDOW");
+}
+const MSState& MeasurementSet::state() const
+{
+  return openedSubtable (state_p, "STATE");
+}
+const MSSysCal& MeasurementSet::sysCal() const
+{
+  return openedSubtable (sysCal_p, "SYSCAL");
+}
+const MSWeather& MeasurementSet::weather() const
+{
+  return openedSubtable (weather_p, "WEATHER");
+}
+
 template<typename T>
 static Table create_table(SetupNewTable &tableSetup, T /*comm*/)
 {
@@ -1040,23 +1180,25 @@ Bool MeasurementSet::validateMeasureRefs()
 
 void MeasurementSet::flush(Bool sync) {
   MSTable<MSMainEnums>::flush(sync);
-  antenna_p.flush(sync);
-  dataDesc_p.flush(sync);
+  // Subtables not opened yet (they are opened on demand) need no flush.
+  std::lock_guard<std::mutex> lock(subtableMutex_p);
+  if (!antenna_p.isNull()) antenna_p.flush(sync);
+  if (!dataDesc_p.isNull()) dataDesc_p.flush(sync);
   if (!doppler_p.isNull()) doppler_p.flush(sync);
-  feed_p.flush(sync);
-  field_p.flush(sync);
-  flagCmd_p.flush(sync);
-  if (!freqOffset_p.isNull())  freqOffset_p.flush(sync);
-  history_p.flush(sync);
-  observation_p.flush(sync);
-  pointing_p.flush(sync);
-  polarization_p.flush(sync);
-  processor_p.flush(sync);
-  if (!source_p.isNull())  source_p.flush(sync);
-  spectralWindow_p.flush(sync);
-  state_p.flush(sync);
-  if (!sysCal_p.isNull())  sysCal_p.flush(sync);
-  if (!weather_p.isNull())  weather_p.flush(sync);
+  if (!feed_p.isNull()) feed_p.flush(sync);
+  if (!field_p.isNull()) field_p.flush(sync);
+  if (!flagCmd_p.isNull()) flagCmd_p.flush(sync);
+  if (!freqOffset_p.isNull()) freqOffset_p.flush(sync);
+  if (!history_p.isNull()) history_p.flush(sync);
+  if (!observation_p.isNull()) observation_p.flush(sync);
+  if (!pointing_p.isNull()) pointing_p.flush(sync);
+  if (!polarization_p.isNull()) polarization_p.flush(sync);
+  if (!processor_p.isNull()) processor_p.flush(sync);
+  if (!source_p.isNull()) source_p.flush(sync);
+  if (!spectralWindow_p.isNull()) spectralWindow_p.flush(sync);
+  if (!state_p.isNull()) state_p.flush(sync);
+  if (!sysCal_p.isNull()) sysCal_p.flush(sync);
+  if (!weather_p.isNull()) weather_p.flush(sync);
 }
 
 void MeasurementSet::checkVersion()
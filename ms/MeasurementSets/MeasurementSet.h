@@ -46,6 +46,7 @@
 #include <casacore/ms/MeasurementSets/MSState.h>
 #include <casacore/ms/MeasurementSets/MSSysCal.h>
 #include <casacore/ms/MeasurementSets/MSWeather.h>
+#include <mutex>
 #include <set>
 
  
@@ -311,6 +312,10 @@ public:
 
   // Return the name of each of the subtables. This should be used by the
   // filler to create the subtables in the correct location.
+  // If the subtable has not been opened yet, the name is taken from the
+  // table keyword defining it (which can point outside this table, e.g.
+  // for a reference or selected MS). Only if no such keyword exists yet,
+  // the default location inside this MS is returned.
   // <group>
   String antennaTableName() const;
   String dataDescriptionTableName() const;
@@ -331,52 +336,64 @@ public:
   String weatherTableName() const;
   // </group>
     
-  // Access functions for the subtables, using the MS-like interface for each
+  // Access functions for the subtables, using the MS-like interface for each.
+  // The subtables are opened on demand, i.e. when accessed for the first
+  // time (after initRefs has been called).
   // <group>
-  MSAntenna& antenna() {return antenna_p;}
-  MSDataDescription& dataDescription() {return dataDesc_p;}
-  MSDoppler& doppler() {return doppler_p;}
-  MSFeed& feed() {return feed_p;}
-  MSField& field() {return field_p;}
-  MSFlagCmd& flagCmd() {return flagCmd_p;}
-  MSFreqOffset& freqOffset() {return freqOffset_p;}
-  MSHistory& history() {return history_p;}
-  MSObservation& observation() {return observation_p;}
-  MSPointing& pointing() {return pointing_p;}
-  MSPolarization& polarization() {return polarization_p;}
-  MSProcessor& processor() {return processor_p;}
-  MSSource& source() {return source_p;}
-  MSSpectralWindow& spectralWindow() {return spectralWindow_p;}
-  MSState& state() {return state_p;}
-  MSSysCal& sysCal() {return sysCal_p;}
-  MSWeather& weather() {return weather_p;}
-  const MSAntenna& antenna() const {return antenna_p;}
-  const MSDataDescription& dataDescription() const {return dataDesc_p;}
-  const MSDoppler& doppler() const {return doppler_p;}
-  const MSFeed& feed() const {return feed_p;}
-  const MSField& field() const {return field_p;}
-  const MSFlagCmd& flagCmd() const {return flagCmd_p;}
-  const MSFreqOffset& freqOffset() const {return freqOffset_p;}
-  const MSHistory& history() const {return history_p;}
-  const MSObservation& observation() const {return observation_p;}
-  const MSPointing& pointing() const {return pointing_p;}
-  const MSPolarization& polarization() const {return polarization_p;}
-  const MSProcessor& processor() const {return processor_p;}
-  const MSSource& source() const {return source_p;}
-  const MSSpectralWindow& spectralWindow() const {return spectralWindow_p;}
-  const MSState& state() const {return state_p;}
-  const MSSysCal& sysCal() const {return sysCal_p;}
-  const MSWeather& weather() const {return weather_p;}
+  MSAntenna& antenna();
+  MSDataDescription& dataDescription();
+  MSDoppler& doppler();
+  MSFeed& feed();
+  MSField& field();
+  MSFlagCmd& flagCmd();
+  MSFreqOffset& freqOffset();
+  MSHistory& history();
+  MSObservation& observation();
+  MSPointing& pointing();
+  MSPolarization& polarization();
+  MSProcessor& processor();
+  MSSource& source();
+  MSSpectralWindow& spectralWindow();
+  MSState& state();
+  MSSysCal& sysCal();
+  MSWeather& weather();
+  const MSAntenna& antenna() const;
+  const MSDataDescription& dataDescription() const;
+  const MSDoppler& doppler() const;
+  const MSFeed& feed() const;
+  const MSField& field() const;
+  const MSFlagCmd& flagCmd() const;
+  const MSFreqOffset& freqOffset() const;
+  const MSHistory& history() const;
+  const MSObservation& observation() const;
+  const MSPointing& pointing() const;
+  const MSPolarization& polarization() const;
+  const MSProcessor& processor() const;
+  const MSSource& source() const;
+  const MSSpectralWindow& spectralWindow() const;
+  const MSState& state() const;
+  const MSSysCal& sysCal() const;
+  const MSWeather& weather() const;
   // </group>
 
   MrsEligibility getMrsEligibility () const;
 
   // Initialize the references to the subtables. You need to call
   // this only if you assign new subtables to the table keywords.
-  // This also checks for validity of the table and its subtables.
+  // The subtables themselves are not opened; that is done on demand
+  // when they are accessed for the first time. In this way opening an
+  // MS is fast, also if it has many (large) subtables.
+  // Note that, as a consequence, a missing or invalid subtable is not
+  // detected when the MS is opened, but only when the subtable is accessed
+  // (which throws an exception). Use openSubtables to check the validity
+  // of all subtables at once.
   // Set clear to True to clear the subtable references (used in assignment)
   void initRefs(Bool clear=False);
 
+  // Open all subtables defined in the table keywords that have not been
+  // opened yet. An exception is thrown if a subtable is not valid.
+  void openSubtables();
+
   // Create default subtables: fills the required subtable keywords with
   // tables of the correct type, mainly for testing and as an example of
   // how to do this for specific fillers. In practice these tables will
@@ -462,31 +479,46 @@ private:
   // Opens a single subtable if not present in MS object but defined in on-disk MS
   template <typename Subtable>
   void
-  openSubtable (Subtable & subtable, const String & subtableName, Bool useLock);
+  openSubtable (Subtable & subtable, const String & subtableName, Bool useLock) const;
+
+  // Returns the subtable after opening it if not opened yet and if
+  // initRefs has been done.
+  template <typename Subtable>
+  Subtable&
+  openedSubtable (Subtable & subtable, const String & subtableName) const;
+
+  // Returns the name of the subtable; if not opened yet, the name is
+  // taken from the subtable keyword.
+  template <typename Subtable>
+  String
+  subtableTableName (const Subtable & subtable, const String & subtableName) const;
 
   // keep references to the subtables
-  MSAntenna antenna_p;
-  MSDataDescription dataDesc_p;
-  MSDoppler doppler_p; //optional
-  MSFeed feed_p;
-  MSField field_p;
-  MSFlagCmd flagCmd_p;
-  MSFreqOffset freqOffset_p; //optional
-  MSHistory history_p;
-  MSObservation observation_p;
-  MSPointing pointing_p;
-  MSPolarization polarization_p;
-  MSProcessor processor_p;
-  MSSource source_p; //optional
-  MSSpectralWindow spectralWindow_p;
-  MSState state_p;
-  MSSysCal sysCal_p; //optional
-  MSWeather weather_p; //optional
+  // (they are mutable, because they are opened on demand)
+  mutable MSAntenna antenna_p;
+  mutable MSDataDescription dataDesc_p;
+  mutable MSDoppler doppler_p; //optional
+  mutable MSFeed feed_p;
+  mutable MSField field_p;
+  mutable MSFlagCmd flagCmd_p;
+  mutable MSFreqOffset freqOffset_p; //optional
+  mutable MSHistory history_p;
+  mutable MSObservation observation_p;
+  mutable MSPointing pointing_p;
+  mutable MSPolarization polarization_p;
+  mutable MSProcessor processor_p;
+  mutable MSSource source_p; //optional
+  mutable MSSpectralWindow spectralWindow_p;
+  mutable MSState state_p;
+  mutable MSSysCal sysCal_p; //optional
+  mutable MSWeather weather_p; //optional
 
   bool doNotLockSubtables_p; // used to prevent subtable locking to allow parallel interprocess sharing
   int mrsDebugLevel_p; // logging level currently enabled
   Bool hasBeenDestroyed_p; // required by the need to throw an exception in the destructor
+  Bool subtablesOnDemand_p; // open subtables on first access (set by initRefs)
   TableLock mainLock_p;
+  mutable std::mutex subtableMutex_p; // guards opening subtables on demand
   Bool memoryResidentSubtables_p;   // true if memory resident subtables are enabled
   MrsEligibility mrsEligibility_p;  // subtables which can be made memory resident
 
@@ -557,6 +557,81 @@ uInt tNullMS(const String& msName)
   return errCount;
 }
 
+// test that subtables are opened on demand
+
+uInt tLazySubtables(const String& msName, const String& selMSName,
+                    const String& badMSName)
+{
+  uInt errCount = 0;
+  String antName;
+  {
+    MeasurementSet ms(msName);
+    // The name must be known before opening the subtable.
+    antName = ms.antennaTableName();
+    if (antName != ms.antenna().tableName()) {
+      cout << "tLazySubtables: wrong ANTENNA name " << antName << endl;
+      errCount++;
+    }
+    // A selection refers to the subtables of the original MS.
+    Table sel = ms(ms.nodeRownr() < 5);
+    sel.rename (selMSName, Table::New);
+  }
+  {
+    MeasurementSet selMS(selMSName);
+    if (selMS.antennaTableName() != antName) {
+      cout << "tLazySubtables: selected MS ANTENNA name "
+           << selMS.antennaTableName() << " should be " << antName << endl;
+      errCount++;
+    }
+    if (selMS.antenna().tableName() != antName) {
+      cout << "tLazySubtables: selected MS opened wrong ANTENNA table "
+           << selMS.antenna().tableName() << endl;
+      errCount++;
+    }
+    selMS.markForDelete();
+  }
+  {
+    // Make an MS with an invalid ANTENNA subtable.
+    {
+      MeasurementSet ms(msName);
+      ms.deepCopy (badMSName, Table::New);
+    }
+    {
+      Table antTab(badMSName + "/ANTENNA", Table::Update);
+      antTab.removeColumn ("NAME");
+    }
+    // Opening the MS succeeds; the error surfaces on first access.
+    MeasurementSet badMS(badMSName);
+    Bool thrown = False;
+    try {
+      badMS.antenna();
+    } catch (std::exception& x) {
+      thrown = True;
+    }
+    if (!thrown) {
+      cout << "tLazySubtables: accessing invalid ANTENNA should throw" << endl;
+      errCount++;
+    }
+    thrown = False;
+    try {
+      badMS.openSubtables();
+    } catch (std::exception& x) {
+      thrown = True;
+    }
+    if (!thrown) {
+      cout << "tLazySubtables: openSubtables should throw" << endl;
+      errCount++;
+    }
+    // Other subtables can still be used.
+    if (badMS.field().isNull()) {
+      cout << "tLazySubtables: FIELD should be opened" << endl;
+      errCount++;
+    }
+    badMS.markForDelete();
+  }
+  return errCount;
+}
+
 // test exceptions in constructions
 
 uInt tSetupNewTabError()
@@ -624,6 +699,8 @@ int main() {
 
     String msName = "tMeasurementSet_tmp.Table";
     String refMSName = "tMeasurementSet_tmp.Ref-Table";
+    String selMSName = "tMeasurementSet_tmp.Sel-Table";
+    String badMSName = "tMeasurementSet_tmp.Bad-Table";
 
     cout << "\nMS::PredefinedColumns - test of static functions ... ";
     newErrors = tColumnStatics();
@@ -660,6 +737,11 @@ int main() {
     checkErrors(newErrors);
     errCount += newErrors;
     
+    cout << "\nTest subtables opened on demand ... ";
+    newErrors = tLazySubtables(msName, selMSName, badMSName);
+    checkErrors(newErrors);
+    errCount += newErrors;
+    
     cout << "\nTest exceptions" << endl;
     cout << "in Constructors ... ";
     newErrors = tSetupNewTabError();
@@ -275,6 +275,46 @@
     return arr;
   }
 
+  // Tell if the Array for the numpy data type is made by ArrayCopy::toArray.
+  Bool isDirectType (int type)
+  {
+    switch (type) {
+    case NPY_BOOL:
+    case NPY_INT16:
+    case NPY_UINT16:
+    case NPY_INT32:
+    case NPY_UINT32:
+    case NPY_INT64:
+    case NPY_FLOAT32:
+    case NPY_FLOAT64:
+    case NPY_COMPLEX64:
+    case NPY_COMPLEX128:
+    case NPY_OBJECT:
+      return True;
+    default:
+      return False;
+    }
+  }
+
+  // Make the Array from the numpy data.
+  // A Fortran ordered numpy array has the axes order of an Array, so
+  // its data are transposed while making the Array (which is faster
+  // than letting numpy make a C ordered copy first).
+  template <typename T>
+  Array<T> toOrderedArray (const IPosition& shape, void* data,
+                           bool copy, bool fortran)
+  {
+    if (!fortran) {
+      return ArrayCopy<T>::toArray (shape, data, copy);
+    }
+    IPosition reversedAxes(shape.size());
+    for (size_t i=0; i<shape.size(); i++) {
+      reversedAxes[i] = shape.size() - i - 1;
+    }
+    return reorderArray (ArrayCopy<T>::toArray(shape, data, False),
+                         reversedAxes);
+  }
+
   ValueHolder makeArray (PyObject* obj_ptr, Bool copyData)
   {
     if (! PycArrayCheck(obj_ptr)) {
@@ -283,9 +323,12 @@
     PyArrayObject* po = (PyArrayObject*)obj_ptr;
     boost::python::object obj;
     bool docopy = copyData;               // copy data if wanted or needed
-    if (! PyArray_ISCONTIGUOUS(po)
-	||  ! PyArray_ISALIGNED(po)
-	||  PyArray_ISBYTESWAPPED(po)) {
+    bool fortran = (PyArray_ISFORTRAN(po)  &&  PyArray_ISALIGNED(po)
+                    &&  ! PyArray_ISBYTESWAPPED(po)
+                    &&  isDirectType(PyArray_TYPE(po)));
+    if (! fortran  &&  (! PyArray_ISCONTIGUOUS(po)
+                        ||  ! PyArray_ISALIGNED(po)
+                        ||  PyArray_ISBYTESWAPPED(po))) {
       boost::python::handle<> py_hdl(obj_ptr);
       boost::python::object py_obj(py_hdl);
       // incr refcount, because ~object decrements it
@@ -296,45 +339,46 @@
     }
     // Swap axes, because Casacore has row minor and Python row major order.
     // A scalar is treated as a vector with length 1.
+    // A Fortran ordered array is reordered in toOrderedArray.
     int nd = PyArray_NDIM(po);
     IPosition shp(1, 1);
     if (nd > 0) {
       shp.resize (nd);
       for (int i=0; i<nd; i++) {
-	shp[i] = PyArray_DIMS(po)[nd-i-1];
+	shp[i] = PyArray_DIMS(po)[fortran ? i : nd-i-1];
       }
     }
     // Assert array is contiguous now.
     // If the array is empty, numarray still sees it as non-contiguous.
     if (shp.product() > 0) {
-      AlwaysAssert (PyArray_ISCONTIGUOUS(po)
+      AlwaysAssert ((fortran  ||  PyArray_ISCONTIGUOUS(po))
 		    ///&&  PyArray_ISALIGNED(po)   fails on MIPS (see issue 531)
 		    &&  !PyArray_ISBYTESWAPPED(po), AipsError);
     }
     // Create the correct array.
     switch (PyArray_TYPE(po)) {
     case NPY_BOOL:
-      return ValueHolder (ArrayCopy<Bool>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Bool>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_INT16:
-      return ValueHolder (ArrayCopy<Short>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Short>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_UINT16:
-      return ValueHolder (ArrayCopy<uShort>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<uShort>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_INT32:
-      return ValueHolder (ArrayCopy<Int>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Int>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_UINT32:
-      return ValueHolder (ArrayCopy<uInt>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<uInt>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_INT64:
-      return ValueHolder (ArrayCopy<Int64>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Int64>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_FLOAT32:
-      return ValueHolder (ArrayCopy<Float>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Float>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_FLOAT64:
-      return ValueHolder (ArrayCopy<Double>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Double>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_COMPLEX64:
-      return ValueHolder (ArrayCopy<Complex>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<Complex>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_COMPLEX128:
-      return ValueHolder (ArrayCopy<DComplex>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<DComplex>(shp, PyArray_DATA(po), docopy, fortran));
     case NPY_OBJECT:
-      return ValueHolder (ArrayCopy<String>::toArray(shp, PyArray_DATA(po), docopy));
+      return ValueHolder (toOrderedArray<String>(shp, PyArray_DATA(po), docopy, fortran));
     default:
       // Some types can be the same as other types, so they cannot
       // be used in the switch (compiler complains).
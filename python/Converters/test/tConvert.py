@@ -88,6 +88,10 @@ def dotest(t):
     print (t.testvh(NUM.array([21.])));
     print (t.testvh(NUM.array(21.)));
 
+    # A Fortran ordered array must give the same result as a C ordered one.
+    b = NUM.arange(24.).reshape(2,3,4);
+    print (NUM.array_equal (t.testvh (NUM.asfortranarray(b)), t.testvh (b)));
+
     print ('>>>');
     res = t.testvh (NUM.array([]));
     print ('<<<');
@@ -139,6 +139,8 @@ public:
 // (G. Rodrigue, ed.), Academic Press, 1982, pp. 51--83. </em><br>
 // <br>If at build time it is chosen to use FFTW in a multi-threaded way,
 // it will try to use as many cores as possible.
+// <br>The FFTW plans are kept in a process-wide cache (see class FFTW), so
+// creating an FFTServer for a shape that was transformed before is cheap.
 
 // In this class a forward transform is defined as one that goes from the real
 // to the complex (or the time to frequency) domain. In a forward transform the
@@ -24,7 +24,11 @@
 
 
 #include <casacore/scimath/Mathematics/FFTW.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/System/Aipsrc.h>
 
 #ifdef HAVE_FFTW3
 # include <fftw3.h>
@@ -33,7 +37,12 @@
 # include <omp.h>
 #endif
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
 
 
 namespace casacore {
@@ -76,9 +85,125 @@ std::mutex FFTW::theirMutex;
     fftwf_plan itsPlan;
   };
 
-    
+namespace {
+
+  // The transform types of the cached plans.
+  enum FFTWPlanType { PlanR2C, PlanC2R, PlanC2CForward, PlanC2CBackward };
+
+  // The key of a plan in the plan cache. FFTW can only execute a plan
+  // on arrays with the same alignment and placement as the planned arrays.
+  struct FFTWPlanKey
+  {
+    FFTWPlanType type;
+    std::vector<int> shape;
+    int alignIn;
+    int alignOut;
+    bool inPlace;
+    bool operator< (const FFTWPlanKey& other) const
+    {
+      return std::tie (type, shape, alignIn, alignOut, inPlace) <
+        std::tie (other.type, other.shape, other.alignIn, other.alignOut,
+                  other.inPlace);
+    }
+  };
+
+  // A cache of plans of one precision. If it gets full, the oldest plan
+  // is removed (FFTW objects using it keep it alive).
+  template<typename PLAN>
+  struct FFTWPlanCache
+  {
+    std::map<FFTWPlanKey, std::shared_ptr<PLAN>> plans;
+    std::deque<FFTWPlanKey> order;      // keys in order of insertion
+    void clear()
+      { plans.clear(); order.clear(); }
+  };
+
+  // The plan cache and settings; all guarded by FFTW::theirMutex.
+  FFTWPlanCache<FFTWPlan>  thePlanCache;
+  FFTWPlanCache<FFTWPlanf> thePlanCachef;
+  unsigned thePlannerFlags = FFTW_ESTIMATE;
+  String   theWisdomFile;
+
+  // Scratch arrays with the alignment of the user's arrays on which
+  // a plan is made, so planning never overwrites the user's data.
+  class FFTWScratch
+  {
+  public:
+    // An in-place array must be large enough for input and output.
+    FFTWScratch (size_t nbytesIn, int alignIn, size_t nbytesOut,
+                 int alignOut, bool inPlace)
+      : itsIn  (static_cast<char*>(fftw_malloc
+                 ((inPlace ? std::max(nbytesIn, nbytesOut) : nbytesIn) + 64))),
+        itsOut (inPlace  ?  0 : static_cast<char*>(fftw_malloc (nbytesOut + 64))),
+        itsAlignIn  (alignIn),
+        itsAlignOut (alignOut)
+    {}
+    ~FFTWScratch()
+    {
+      fftw_free (itsIn);
+      if (itsOut) {
+        fftw_free (itsOut);
+      }
+    }
+    template<typename T> T* in()
+      { return reinterpret_cast<T*>(itsIn + itsAlignIn); }
+    template<typename T> T* out()
+      { return itsOut  ?  reinterpret_cast<T*>(itsOut + itsAlignOut) : in<T>(); }
+  private:
+    FFTWScratch (const FFTWScratch&);
+    FFTWScratch& operator= (const FFTWScratch&);
+    char* itsIn;
+    char* itsOut;
+    int   itsAlignIn;
+    int   itsAlignOut;
+  };
+
+  // Write the wisdom if planning with more rigor than estimate.
+  void exportWisdom()
+  {
+    if (! theWisdomFile.empty()  &&  thePlannerFlags != FFTW_ESTIMATE) {
+      fftw_export_wisdom_to_filename (theWisdomFile.c_str());
+      fftwf_export_wisdom_to_filename ((theWisdomFile + "f").c_str());
+    }
+  }
+
+  // Get a plan from the cache or make it using the given function.
+  // FFTW::theirMutex must be locked.
+  template<typename PLAN, typename MAKER>
+  std::shared_ptr<PLAN> cachedPlan
+  (FFTWPlanCache<PLAN>& cache, const FFTWPlanKey& key, MAKER makePlan)
+  {
+    auto iter = cache.plans.find (key);
+    if (iter != cache.plans.end()) {
+      return iter->second;
+    }
+    auto fftwPlan = makePlan();
+    if (! fftwPlan) {
+      throw AipsError ("FFTW could not make a plan");
+    }
+    std::shared_ptr<PLAN> plan (new PLAN(fftwPlan));
+    cache.plans[key] = plan;
+    cache.order.push_back (key);
+    if (cache.order.size() > FFTW::maxCachedPlans) {
+      cache.plans.erase (cache.order.front());
+      cache.order.pop_front();
+    }
+    exportWisdom();
+    return plan;
+  }
+
+  // Get the number of complex values in a real-to-complex transform
+  // of the given FFTW shape (the last axis is the fastest varying).
+  size_t nComplexR2C (const IPosition& size)
+  {
+    size_t nlast = size[size.nelements() - 1];
+    return size.product() / nlast * (nlast/2 + 1);
+  }
 
-  FFTW::FFTW() : flags(FFTW_ESTIMATE)
+} // end anonymous namespace
+
+
+  FFTW::FFTW()
   { 
     initialize_fftw();
   }
@@ -99,6 +224,28 @@ std::mutex FFTW::theirMutex;
       fftwf_plan_with_nthreads(nthreads);
       fftw_plan_with_nthreads(nthreads);
 #endif
+      String planner;
+      if (Aipsrc::find (planner, "fftw.planner")) {
+        planner.downcase();
+        if (planner == "measure") {
+          thePlannerFlags = FFTW_MEASURE;
+        } else if (planner == "patient") {
+          thePlannerFlags = FFTW_PATIENT;
+        } else if (planner == "exhaustive") {
+          thePlannerFlags = FFTW_EXHAUSTIVE;
+        } else if (planner != "estimate") {
+          std::cerr << "FFTW: unknown value " << planner
+                    << " of aipsrc variable fftw.planner; using estimate"
+                    << std::endl;
+        }
+      }
+      String wisdomFile;
+      if (Aipsrc::find (wisdomFile, "fftw.wisdom")  &&  !wisdomFile.empty()) {
+        theWisdomFile = Path(wisdomFile).expandedName();
+        // The files do not exist the first time, which is fine.
+        fftw_import_wisdom_from_filename (theWisdomFile.c_str());
+        fftwf_import_wisdom_from_filename ((theWisdomFile + "f").c_str());
+      }
       is_initialized_fftw = true;
     }
   }
@@ -119,120 +266,184 @@ std::mutex FFTW::theirMutex;
 
   void FFTW::plan_r2c(const IPosition &size, float *in, std::complex<float> *out) 
   {
-    itsPlanR2Cf.reset( new FFTWPlanf
-      (fftwf_plan_dft_r2c(size.nelements(),
-                          size.asStdVector().data(),
-                          in,
-                          reinterpret_cast<fftwf_complex *>(out), 
-                          flags)) );
+    float* fout = reinterpret_cast<float*>(out);
+    FFTWPlanKey key {PlanR2C, size.asStdVector(), fftwf_alignment_of(in),
+                     fftwf_alignment_of(fout), in == fout};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanR2Cf = cachedPlan (thePlanCachef, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(float), key.alignIn,
+                            nComplexR2C(size) * sizeof(fftwf_complex),
+                            key.alignOut, key.inPlace);
+        return fftwf_plan_dft_r2c(size.nelements(), key.shape.data(),
+                                  scratch.in<float>(),
+                                  scratch.out<fftwf_complex>(),
+                                  thePlannerFlags);
+      });
   }
 
   void FFTW::plan_r2c(const IPosition &size, double *in, std::complex<double> *out) 
   {
-    itsPlanR2C.reset( new FFTWPlan
-      (fftw_plan_dft_r2c(size.nelements(),
-                         size.asStdVector().data(),
-                         in,
-                         reinterpret_cast<fftw_complex *>(out), 
-                         flags)) );
+    double* dout = reinterpret_cast<double*>(out);
+    FFTWPlanKey key {PlanR2C, size.asStdVector(), fftw_alignment_of(in),
+                     fftw_alignment_of(dout), in == dout};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanR2C = cachedPlan (thePlanCache, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(double), key.alignIn,
+                            nComplexR2C(size) * sizeof(fftw_complex),
+                            key.alignOut, key.inPlace);
+        return fftw_plan_dft_r2c(size.nelements(), key.shape.data(),
+                                 scratch.in<double>(),
+                                 scratch.out<fftw_complex>(),
+                                 thePlannerFlags);
+      });
   }
 
   void FFTW::plan_c2r(const IPosition &size, std::complex<float> *in, float *out) {
-    itsPlanC2Rf.reset( new FFTWPlanf
-      (fftwf_plan_dft_c2r(size.nelements(),
-                          size.asStdVector().data(),
-                          reinterpret_cast<fftwf_complex *>(in),
-                          out, 
-                          flags)) );
-
+    float* fin = reinterpret_cast<float*>(in);
+    FFTWPlanKey key {PlanC2R, size.asStdVector(), fftwf_alignment_of(fin),
+                     fftwf_alignment_of(out), fin == out};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2Rf = cachedPlan (thePlanCachef, key, [&]() {
+        FFTWScratch scratch(nComplexR2C(size) * sizeof(fftwf_complex),
+                            key.alignIn, size.product() * sizeof(float),
+                            key.alignOut, key.inPlace);
+        return fftwf_plan_dft_c2r(size.nelements(), key.shape.data(),
+                                  scratch.in<fftwf_complex>(),
+                                  scratch.out<float>(),
+                                  thePlannerFlags);
+      });
   }
 
   void FFTW::plan_c2r(const IPosition &size, std::complex<double> *in, double *out) {
-    itsPlanC2R.reset( new FFTWPlan
-      (fftw_plan_dft_c2r(size.nelements(),
-                         size.asStdVector().data(),
-                         reinterpret_cast<fftw_complex *>(in), 
-                         out,
-                         flags)) );
+    double* din = reinterpret_cast<double*>(in);
+    FFTWPlanKey key {PlanC2R, size.asStdVector(), fftw_alignment_of(din),
+                     fftw_alignment_of(out), din == out};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2R = cachedPlan (thePlanCache, key, [&]() {
+        FFTWScratch scratch(nComplexR2C(size) * sizeof(fftw_complex),
+                            key.alignIn, size.product() * sizeof(double),
+                            key.alignOut, key.inPlace);
+        return fftw_plan_dft_c2r(size.nelements(), key.shape.data(),
+                                 scratch.in<fftw_complex>(),
+                                 scratch.out<double>(),
+                                 thePlannerFlags);
+      });
   }
 
   void FFTW::plan_c2c_forward(const IPosition &size, std::complex<double> *in) {
-    itsPlanC2CF.reset( new FFTWPlan
-      (fftw_plan_dft(size.nelements(),
-                     size.asStdVector().data(),
-                     reinterpret_cast<fftw_complex *>(in), 
-                     reinterpret_cast<fftw_complex *>(in), 
-                     FFTW_FORWARD, flags)) );
-
+    int align = fftw_alignment_of(reinterpret_cast<double*>(in));
+    FFTWPlanKey key {PlanC2CForward, size.asStdVector(), align, align, true};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2CF = cachedPlan (thePlanCache, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(fftw_complex), align,
+                            0, align, true);
+        return fftw_plan_dft(size.nelements(), key.shape.data(),
+                             scratch.in<fftw_complex>(),
+                             scratch.in<fftw_complex>(),
+                             FFTW_FORWARD, thePlannerFlags);
+      });
   }
     
   void FFTW::plan_c2c_forward(const IPosition &size, std::complex<float> *in) {
-    itsPlanC2CFf.reset( new FFTWPlanf
-      (fftwf_plan_dft(size.nelements(),
-                      size.asStdVector().data(),
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      FFTW_FORWARD, flags)) );
+    int align = fftwf_alignment_of(reinterpret_cast<float*>(in));
+    FFTWPlanKey key {PlanC2CForward, size.asStdVector(), align, align, true};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2CFf = cachedPlan (thePlanCachef, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(fftwf_complex), align,
+                            0, align, true);
+        return fftwf_plan_dft(size.nelements(), key.shape.data(),
+                              scratch.in<fftwf_complex>(),
+                              scratch.in<fftwf_complex>(),
+                              FFTW_FORWARD, thePlannerFlags);
+      });
   }
 
   void FFTW::plan_c2c_backward(const IPosition &size, std::complex<double> *in) {
-    itsPlanC2CB.reset( new FFTWPlan
-      (fftw_plan_dft(size.nelements(),
-                     size.asStdVector().data(),
-                     reinterpret_cast<fftw_complex *>(in), 
-                     reinterpret_cast<fftw_complex *>(in), 
-                     FFTW_BACKWARD, flags)) );
-      
+    int align = fftw_alignment_of(reinterpret_cast<double*>(in));
+    FFTWPlanKey key {PlanC2CBackward, size.asStdVector(), align, align, true};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2CB = cachedPlan (thePlanCache, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(fftw_complex), align,
+                            0, align, true);
+        return fftw_plan_dft(size.nelements(), key.shape.data(),
+                             scratch.in<fftw_complex>(),
+                             scratch.in<fftw_complex>(),
+                             FFTW_BACKWARD, thePlannerFlags);
+      });
   }
     
   void FFTW::plan_c2c_backward(const IPosition &size, std::complex<float> *in) {
-    itsPlanC2CBf.reset( new FFTWPlanf
-      (fftwf_plan_dft(size.nelements(),
-                      size.asStdVector().data(),
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      FFTW_BACKWARD, flags)) );
+    int align = fftwf_alignment_of(reinterpret_cast<float*>(in));
+    FFTWPlanKey key {PlanC2CBackward, size.asStdVector(), align, align, true};
+    std::lock_guard<std::mutex> lock(theirMutex);
+    itsPlanC2CBf = cachedPlan (thePlanCachef, key, [&]() {
+        FFTWScratch scratch(size.product() * sizeof(fftwf_complex), align,
+                            0, align, true);
+        return fftwf_plan_dft(size.nelements(), key.shape.data(),
+                              scratch.in<fftwf_complex>(),
+                              scratch.in<fftwf_complex>(),
+                              FFTW_BACKWARD, thePlannerFlags);
+      });
   }
 
-  // the parameters are used only in order to overload this function
-  void FFTW::r2c(const IPosition&, float*, std::complex<float>*) 
+  // the size is used only in order to overload this function
+  void FFTW::r2c(const IPosition&, float* in, std::complex<float>* out) 
   {
-    fftwf_execute(itsPlanR2Cf->getPlan());
+    fftwf_execute_dft_r2c(itsPlanR2Cf->getPlan(), in,
+                          reinterpret_cast<fftwf_complex*>(out));
   }
     
-  void FFTW::r2c(const IPosition&, double*, std::complex<double>*) 
+  void FFTW::r2c(const IPosition&, double* in, std::complex<double>* out) 
   {
-    fftw_execute(itsPlanR2C->getPlan());
+    fftw_execute_dft_r2c(itsPlanR2C->getPlan(), in,
+                         reinterpret_cast<fftw_complex*>(out));
   }
 
-  void FFTW::c2r(const IPosition&, std::complex<float>*, float*)
+  void FFTW::c2r(const IPosition&, std::complex<float>* in, float* out)
   {
-    fftwf_execute(itsPlanC2Rf->getPlan());
+    fftwf_execute_dft_c2r(itsPlanC2Rf->getPlan(),
+                          reinterpret_cast<fftwf_complex*>(in), out);
   }
     
-  void FFTW::c2r(const IPosition&, std::complex<double>*, double*)
+  void FFTW::c2r(const IPosition&, std::complex<double>* in, double* out)
   {
-    fftw_execute(itsPlanC2R->getPlan());
+    fftw_execute_dft_c2r(itsPlanC2R->getPlan(),
+                         reinterpret_cast<fftw_complex*>(in), out);
   }
     
-  void FFTW::c2c(const IPosition&, std::complex<float>*, bool forward)
+  void FFTW::c2c(const IPosition&, std::complex<float>* in, bool forward)
   {
+    fftwf_complex* data = reinterpret_cast<fftwf_complex*>(in);
     if (forward) {
-      fftwf_execute(itsPlanC2CFf->getPlan());
+      fftwf_execute_dft(itsPlanC2CFf->getPlan(), data, data);
     } else {
-      fftwf_execute(itsPlanC2CBf->getPlan());
+      fftwf_execute_dft(itsPlanC2CBf->getPlan(), data, data);
     }
   }
     
-  void FFTW::c2c(const IPosition&, std::complex<double>*, bool forward)
+  void FFTW::c2c(const IPosition&, std::complex<double>* in, bool forward)
   {
+    fftw_complex* data = reinterpret_cast<fftw_complex*>(in);
     if (forward) {
-      fftw_execute(itsPlanC2CF->getPlan());
+      fftw_execute_dft(itsPlanC2CF->getPlan(), data, data);
     } else {
-      fftw_execute(itsPlanC2CB->getPlan());
+      fftw_execute_dft(itsPlanC2CB->getPlan(), data, data);
     }
   }
 
+  void FFTW::clearPlanCache()
+  {
+    std::lock_guard<std::mutex> lock(theirMutex);
+    thePlanCache.clear();
+    thePlanCachef.clear();
+  }
+
+  size_t FFTW::planCacheSize()
+  {
+    std::lock_guard<std::mutex> lock(theirMutex);
+    return thePlanCache.plans.size() + thePlanCachef.plans.size();
+  }
+
   FFTW::Plan FFTW::plan_redft00(const IPosition &size, float *in, float *out)
   {
     initialize_fftw();
@@ -303,6 +514,11 @@ std::mutex FFTW::theirMutex;
   void FFTW::c2c(const IPosition&, std::complex<double>*, Bool)
   {}
 
+  void FFTW::clearPlanCache()
+  {}
+  size_t FFTW::planCacheSize()
+  { return 0; }
+
   FFTW::Plan FFTW::plan_redft00(const IPosition &, float *, float *)
   { throw std::runtime_error("FFTW not available"); }
   
@@ -49,6 +49,24 @@ class FFTWPlanf;
 // The interface is such that the presence of FFTW3 is only visible
 // in the implementation. The header file does not need to know.
 // In this way external code using this class does not need to set HAVE_FFTW.
+//
+// The plans are kept in a process-wide cache keyed on the transform type,
+// precision, shape, and alignment of the arrays, so planning a shape
+// that was planned before (e.g. by another FFTServer object) is cheap.
+// The cache holds at most <src>maxCachedPlans</src> plans per precision.
+// A plan is made on scratch arrays, thus the arrays passed to the plan
+// functions are never overwritten. The plan is executed on the arrays
+// passed to the transform functions, which must have the shape and
+// alignment of the arrays given when planning. Planning is guarded by a
+// mutex, so different FFTW objects can be used in different threads.
+//
+// The planning rigor is given by the aipsrc variable
+// <src>fftw.planner</src>, which can be estimate (default), measure,
+// patient, or exhaustive. Apart from estimate, planning can take a long
+// time. To do it only once, the aipsrc variable <src>fftw.wisdom</src> can
+// give the name of a file holding the FFTW wisdom. It is read at
+// initialization and written after each new plan; the single precision
+// wisdom is kept in the file with an <src>f</src> appended to its name.
 // </synopsis>
 
 class FFTW
@@ -68,9 +86,7 @@ public:
   void plan_c2c_backward(const IPosition &size, std::complex<double> *in) ;
   void plan_c2c_backward(const IPosition &size, std::complex<float> *in) ;
   
-  // TODO These overloads do not use their parameters at all. This should
-  // be written to use an interface like plan_redft00().
-  // overloaded interface to fftw[f]_execute...
+  // overloaded interface to fftw[f]_execute... using the given arrays
   void r2c(const IPosition &size, float *in, std::complex<float> *out) ;
   void r2c(const IPosition &size, double *in, std::complex<double> *out) ;
   void c2r(const IPosition &size, std::complex<float> *in, float *out);
@@ -103,37 +119,43 @@ public:
   
   static Plan plan_redft00(const IPosition &size, float *in, float *out);
   static Plan plan_redft00(const IPosition &size, double *in, double *out);
+
+  // The maximum number of plans per precision kept in the plan cache.
+  // If exceeded, the oldest plan is removed from the cache.
+  static const size_t maxCachedPlans = 256;
+
+  // Remove all plans from the plan cache. Plans in use by FFTW objects
+  // stay valid until these objects release them.
+  static void clearPlanCache();
+
+  // Get the number of plans in the plan cache.
+  static size_t planCacheSize();
   
 private:
   static void initialize_fftw();
   
-  std::unique_ptr<FFTWPlanf> itsPlanR2Cf;
-  std::unique_ptr<FFTWPlan>  itsPlanR2C;
+  std::shared_ptr<FFTWPlanf> itsPlanR2Cf;
+  std::shared_ptr<FFTWPlan>  itsPlanR2C;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2Rf;
-  std::unique_ptr<FFTWPlan>  itsPlanC2R;
+  std::shared_ptr<FFTWPlanf> itsPlanC2Rf;
+  std::shared_ptr<FFTWPlan>  itsPlanC2R;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2CFf;   // forward
-  std::unique_ptr<FFTWPlan>  itsPlanC2CF;
+  std::shared_ptr<FFTWPlanf> itsPlanC2CFf;   // forward
+  std::shared_ptr<FFTWPlan>  itsPlanC2CF;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2CBf;   // backward
-  std::unique_ptr<FFTWPlan>  itsPlanC2CB;
+  std::shared_ptr<FFTWPlanf> itsPlanC2CBf;   // backward
+  std::shared_ptr<FFTWPlan>  itsPlanC2CB;
   
   std::unique_ptr<FFTWPlanf> itsPlanR2Rf;
   std::unique_ptr<FFTWPlan>  itsPlanR2R;
-  
-  unsigned flags;
 
   static bool is_initialized_fftw;  // FFTW needs initialization
                                              // only once per process,
                                              // not once per object
                                              
-  // TODO this mutex does not make FFTW thread safe, because
-  // planning an FFT with FFTW is not thread safe either.
-  // So either the plan..() methods should take the mutex, or
-  // FFTW should leave synchronization fully to the user of
-  // this class: currently it's halfway in between.
-  static std::mutex theirMutex;          // Initialization mutex
+  // Guards the initialization, the plan cache, and the planning, because
+  // planning an FFT with FFTW is not thread safe. Executing a plan is.
+  static std::mutex theirMutex;
 };    
     
 } //# NAMESPACE CASACORE - END
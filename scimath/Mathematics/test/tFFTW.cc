@@ -0,0 +1,188 @@
+//# tFFTW.cc: Test the plan cache and wisdom of the FFTW wrapper
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/scimath/Mathematics/FFTW.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/fstream.h>
+#include <casacore/casa/iostream.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// This program tests the process-wide plan cache of class FFTW and the
+// writing of the FFTW wisdom. Planning is done with FFTW_MEASURE, which
+// uses the (scratch) arrays.
+
+// Calculate the 2-dim real-to-complex DFT directly.
+template<typename T>
+std::vector<std::complex<T>> dft (const T* in, int ny, int nx, int instride)
+{
+  int nh = nx/2 + 1;
+  std::vector<std::complex<T>> out(ny*nh);
+  for (int ky=0; ky<ny; ++ky) {
+    for (int kx=0; kx<nh; ++kx) {
+      std::complex<double> sum;
+      for (int y=0; y<ny; ++y) {
+        for (int x=0; x<nx; ++x) {
+          double ang = -2*M_PI * (double(ky*y)/ny + double(kx*x)/nx);
+          sum += double(in[y*instride + x]) *
+            std::complex<double>(cos(ang), sin(ang));
+        }
+      }
+      out[ky*nh + kx] = std::complex<T>(sum);
+    }
+  }
+  return out;
+}
+
+template<typename T>
+void checkEqual (const std::vector<std::complex<T>>& ref,
+                 const std::complex<T>* res)
+{
+  for (size_t i=0; i<ref.size(); ++i) {
+    AlwaysAssertExit (std::abs(res[i] - ref[i]) < 1e-4);
+  }
+}
+
+template<typename T>
+void checkPlanCache()
+{
+  const int ny = 6;
+  const int nx = 8;
+  const int nh = nx/2 + 1;
+  IPosition shape(2, ny, nx);
+  // The cache contains plans of both precisions.
+  size_t nplan = FFTW::planCacheSize();
+  // Use an offset of one element to get another alignment.
+  std::vector<T> in(ny*nx + 1);
+  for (size_t i=0; i<in.size(); ++i) {
+    in[i] = T(i%7) - T(i%3);
+  }
+  const std::vector<T> orig(in);
+  std::vector<std::complex<T>> out(ny*nh + 1);
+  FFTW fftw1;
+  fftw1.plan_r2c (shape, in.data(), out.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == nplan + 1);
+  // The same key reuses the plan, also in another object.
+  fftw1.plan_r2c (shape, in.data(), out.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == nplan + 1);
+  FFTW fftw2;
+  fftw2.plan_r2c (shape, in.data(), out.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == nplan + 1);
+  // Planning (with measure) does not overwrite the input.
+  AlwaysAssertExit (in == orig);
+  // Another alignment needs another plan.
+  fftw2.plan_r2c (shape, in.data()+1, out.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == nplan + 2);
+  // Check the results of both plans.
+  std::vector<std::complex<T>> ref0 = dft (in.data(), ny, nx, nx);
+  std::vector<std::complex<T>> ref1 = dft (in.data()+1, ny, nx, nx);
+  fftw1.r2c (shape, in.data(), out.data());
+  checkEqual (ref0, out.data());
+  fftw2.r2c (shape, in.data()+1, out.data());
+  checkEqual (ref1, out.data());
+  // An in-place transform needs another plan. Its input is padded
+  // (as required by FFTW), so the output fits in it.
+  std::vector<std::complex<T>> inout(ny*nh);
+  T* rinout = reinterpret_cast<T*>(inout.data());
+  for (int y=0; y<ny; ++y) {
+    for (int x=0; x<nx; ++x) {
+      rinout[y*2*nh + x] = in[y*nx + x];
+    }
+  }
+  const std::vector<std::complex<T>> inoutOrig(inout);
+  FFTW fftw3;
+  fftw3.plan_r2c (shape, rinout, inout.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == nplan + 3);
+  AlwaysAssertExit (inout == inoutOrig);
+  fftw3.r2c (shape, rinout, inout.data());
+  checkEqual (ref0, inout.data());
+  // Removing the plans from the cache does not invalidate them.
+  FFTW::clearPlanCache();
+  AlwaysAssertExit (FFTW::planCacheSize() == 0);
+  fftw1.r2c (shape, in.data(), out.data());
+  checkEqual (ref0, out.data());
+}
+
+void checkMaxPlans()
+{
+  // Make more plans than the cache can hold.
+  FFTW::clearPlanCache();
+  size_t nplan = FFTW::maxCachedPlans + 10;
+  std::vector<std::complex<float>> data(nplan);
+  FFTW fftw;
+  for (size_t i=1; i<=nplan; ++i) {
+    fftw.plan_c2c_forward (IPosition(1, i), data.data());
+  }
+  AlwaysAssertExit (FFTW::planCacheSize() == FFTW::maxCachedPlans);
+  // The last one is still cached.
+  fftw.plan_c2c_forward (IPosition(1, nplan), data.data());
+  AlwaysAssertExit (FFTW::planCacheSize() == FFTW::maxCachedPlans);
+  FFTW::clearPlanCache();
+}
+
+void checkWisdom (const String& wisdomFile)
+{
+  // The wisdom has been written after making the plans.
+  AlwaysAssertExit (File(wisdomFile).exists());
+  AlwaysAssertExit (File(wisdomFile + "f").exists());
+  AlwaysAssertExit (RegularFile(wisdomFile).size() > 0);
+  AlwaysAssertExit (RegularFile(wisdomFile + "f").size() > 0);
+  RegularFile(wisdomFile).remove();
+  RegularFile(wisdomFile + "f").remove();
+}
+
+int main()
+{
+  // Without FFTW no plans are made and no wisdom is written.
+#ifdef HAVE_FFTW3
+  try {
+    // Plan with measure and write the wisdom.
+    String rcFile ("tFFTW_tmp.rc");
+    String wisdomFile ("tFFTW_tmp.wisdom");
+    {
+      ofstream ofs(rcFile.c_str());
+      ofs << "fftw.planner: measure" << endl;
+      ofs << "fftw.wisdom: " << wisdomFile << endl;
+    }
+    EnvironmentVariable::set ("CASARCFILES", rcFile + ":");
+    checkPlanCache<float>();
+    checkPlanCache<double>();
+    checkMaxPlans();
+    checkWisdom (wisdomFile);
+    RegularFile(rcFile).remove();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+#endif
+  cout << "OK" << endl;
+  return 0;
+}
@@ -28,6 +28,7 @@
 
 #include <casacore/scimath/StatsFramework/StatisticsAlgorithmQuantileComputer.h>
 
+#include <casacore/scimath/StatsFramework/QuantileSketch.h>
 #include <casacore/scimath/StatsFramework/StatisticsUtilities.h>
 
 #include <casacore/casa/aips.h>
@@ -111,6 +112,23 @@ public:
     // reset the private fields
     virtual void reset();
 
+    // Set the maximum relative rank error of approximate quantiles. If it is
+    // larger than 0, the median, quantiles, and median absolute deviation from
+    // the median of a data set which has not been sorted in memory are taken
+    // from a QuantileSketch, which is filled in a single pass through the
+    // data. A value of 0 (the default) means that these are computed exactly.
+    void setSketchRankError(Double rankError);
+
+    Double getSketchRankError() const { return _sketchRankError; }
+
+    // Get the number of good points, the minimum, and the maximum from the
+    // sketch, creating the sketch if necessary. Should only be called if the
+    // rank error is larger than 0.
+    void getSketchNptsMinMax(uInt64& npts, AccumType& mymin, AccumType& mymax);
+
+    // delete the sketch, e.g. because data have been added
+    void deleteSketch() { _sketch.reset(); }
+
 protected:
 
     // <group>
@@ -399,6 +417,8 @@ private:
     Bool _doMedAbsDevMed{False};
     // for use in often repeatedly run macros
     AccumType _myMedian{0};
+    Double _sketchRankError{0};
+    std::shared_ptr<QuantileSketch<AccumType>> _sketch{};
 
     // tally the number of data points that fall into each bin provided by
     // <src>hist</src>. Any points that are less than hist.minLimit or greater
@@ -447,6 +467,10 @@ private:
         const IncludeLimits& includeLimits, uInt64 maxCount
     );
 
+    // Fill a sketch of the good data in a single pass through the data set.
+    // Each thread fills its own sketch, which are merged at the end.
+    void _createSketch();
+
     // extract data from multiple histograms given by <src>hist</src>.
     // <src>dataIndices</src> represent the indices of the sorted arrays of
     // values to extract. There should be exactly one set of data indices to
@@ -475,6 +499,10 @@ private:
         const IndexSet& dataIndices, Bool persistSortedArray, uInt nBins
     );
 
+    // get the values for the specified indices from the sketch. Returns False
+    // if no sketch is used.
+    Bool _valuesFromSketch(IndexValueMap& values, const IndexSet& indices);
+
     // get the index (for odd npts) or indices (for even npts) of the median of
     // the sorted array.
     static IndexSet _medianIndices(uInt64 mynpts);
@@ -49,7 +49,8 @@ CASA_STATD
 ClassicalQuantileComputer<CASA_STATP>::ClassicalQuantileComputer(
     const ClassicalQuantileComputer<CASA_STATP>& other
 ) : StatisticsAlgorithmQuantileComputer<CASA_STATP>(other),
-    _doMedAbsDevMed(other._doMedAbsDevMed), _myMedian(other._myMedian)  {}
+    _doMedAbsDevMed(other._doMedAbsDevMed), _myMedian(other._myMedian),
+    _sketchRankError(other._sketchRankError), _sketch(other._sketch) {}
 
 CASA_STATD
 ClassicalQuantileComputer<CASA_STATP>&
@@ -62,6 +63,8 @@ ClassicalQuantileComputer<CASA_STATP>::operator=(
     StatisticsAlgorithmQuantileComputer<CASA_STATP>::operator=(other);
     _doMedAbsDevMed = other._doMedAbsDevMed;
     _myMedian = other._myMedian;
+    _sketchRankError = other._sketchRankError;
+    _sketch = other._sketch;
     return *this;
 }
 
@@ -224,6 +227,36 @@ CASA_STATD
 void ClassicalQuantileComputer<CASA_STATP>::reset() {
     StatisticsAlgorithmQuantileComputer<CASA_STATP>::reset();
     _doMedAbsDevMed = False;
+    _sketch.reset();
+}
+
+CASA_STATD
+void ClassicalQuantileComputer<CASA_STATP>::setSketchRankError(
+    Double rankError
+) {
+    ThrowIf(
+        rankError < 0 || rankError >= 1,
+        "Quantile rank error must be between 0 and 1"
+    );
+    if (rankError != _sketchRankError) {
+        _sketchRankError = rankError;
+        _sketch.reset();
+    }
+}
+
+CASA_STATD
+void ClassicalQuantileComputer<CASA_STATP>::getSketchNptsMinMax(
+    uInt64& npts, AccumType& mymin, AccumType& mymax
+) {
+    ThrowIf(_sketchRankError <= 0, "No quantile rank error has been set");
+    if (! _sketch) {
+        _createSketch();
+    }
+    npts = _sketch->npts();
+    if (npts > 0) {
+        mymin = _sketch->min();
+        mymax = _sketch->max();
+    }
 }
 
 CASA_STATD std::vector<std::vector<uInt64>>
@@ -467,6 +500,69 @@ void ClassicalQuantileComputer<CASA_STATP>::_createDataArray(DataArray& ary) {
     }
 }
 
+CASA_STATD
+void ClassicalQuantileComputer<CASA_STATP>::_createSketch() {
+    auto* ds = this->_getDataset();
+    ds->initIterators();
+    const auto nThreadsMax = StatisticsUtilities<AccumType>::nThreadsMax(
+        ds->getDataProvider()
+    );
+    const auto nPadded = ClassicalStatisticsData::CACHE_PADDING*nThreadsMax;
+    std::unique_ptr<DataArray[]> tAry(new DataArray[nPadded]);
+    std::vector<std::unique_ptr<QuantileSketch<AccumType>>> tSketch(nPadded);
+    for (uInt tid=0; tid<nThreadsMax; ++tid) {
+        tSketch[ClassicalStatisticsData::CACHE_PADDING*tid].reset(
+            new QuantileSketch<AccumType>(_sketchRankError)
+        );
+    }
+    while (True) {
+        const auto& chunk = ds->initLoopVars();
+        uInt nBlocks, nthreads;
+        uInt64 extra;
+        std::unique_ptr<DataIterator[]> dataIter;
+        std::unique_ptr<MaskIterator[]> maskIter;
+        std::unique_ptr<WeightsIterator[]> weightsIter;
+        std::unique_ptr<uInt64[]> offset;
+        ds->initThreadVars(
+            nBlocks, extra, nthreads, dataIter,
+            maskIter, weightsIter, offset, nThreadsMax
+        );
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads)
+#endif
+        for (uInt i=0; i<nBlocks; ++i) {
+            uInt idx8 = StatisticsUtilities<AccumType>::threadIdx();
+            uInt64 dataCount = (chunk.count - offset[idx8])
+                < ClassicalStatisticsData::BLOCK_SIZE
+                ? extra : ClassicalStatisticsData::BLOCK_SIZE;
+            // the good data of a block are collected first, so the filters
+            // of derived classes are applied
+            auto& block = tAry[idx8];
+            _computeDataArray(
+                block, dataIter[idx8], maskIter[idx8],
+                weightsIter[idx8], dataCount, chunk
+            );
+            auto& sketch = *tSketch[idx8];
+            for (const auto& v : block) {
+                sketch.add(v);
+            }
+            block.clear();
+            ds->incrementThreadIters(
+                dataIter[idx8], maskIter[idx8], weightsIter[idx8],
+                offset[idx8], nthreads
+            );
+        }
+        if (ds->increment(False)) {
+            break;
+        }
+    }
+    // merge the per-thread sketches
+    for (uInt tid=1; tid<nThreadsMax; ++tid) {
+        tSketch[0]->merge(*tSketch[ClassicalStatisticsData::CACHE_PADDING*tid]);
+    }
+    _sketch.reset(tSketch[0].release());
+}
+
 CASA_STATD
 void ClassicalQuantileComputer<CASA_STATP>::_computeDataArray(
     DataArray& ary, DataIterator dataIter, MaskIterator maskIter,
@@ -938,7 +1034,11 @@ ClassicalQuantileComputer<CASA_STATP>::_indicesToValues(
 ) {
     IndexValueMap indexToValue;
     if (
-        _valuesFromSortedArray(
+        (
+            this->_getSortedArray().empty()
+            && _valuesFromSketch(indexToValue, indices)
+        )
+        || _valuesFromSortedArray(
             indexToValue, mynpts, indices, maxArraySize, persistSortedArray
         )
     ) {
@@ -974,6 +1074,41 @@ ClassicalQuantileComputer<CASA_STATP>::_indicesToValues(
     )[0];
 }
 
+CASA_STATD
+Bool ClassicalQuantileComputer<CASA_STATP>::_valuesFromSketch(
+    IndexValueMap& values, const IndexSet& indices
+) {
+    if (_sketchRankError <= 0) {
+        return False;
+    }
+    if (_doMedAbsDevMed) {
+        // Derived classes may transform the data in this mode, so the sketch
+        // can only be used if it was made before.
+        if (! _sketch) {
+            return False;
+        }
+        // The absolute deviations of the sketch items have the same weights
+        // as the items, so no pass through the data is needed.
+        auto median = this->_getMedian();
+        ThrowIf(! median, "median is null");
+        auto items = _sketch->items();
+        for (auto& item : items) {
+            item.first = abs(item.first - *median);
+        }
+        for (auto idx : indices) {
+            values[idx] = QuantileSketch<AccumType>::valueFromItems(items, idx);
+        }
+        return True;
+    }
+    if (! _sketch) {
+        _createSketch();
+    }
+    for (auto idx : indices) {
+        values[idx] = _sketch->value(idx);
+    }
+    return True;
+}
+
 CASA_STATD
 std::set<uInt64> ClassicalQuantileComputer<CASA_STATP>::_medianIndices(
     uInt64 mynpts
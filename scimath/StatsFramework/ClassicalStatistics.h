@@ -222,6 +222,18 @@ public:
         _qComputer = qc;
     }
 
+    // Set the maximum relative rank error of the median, quantiles, and median
+    // absolute deviation from the median. If it is larger than 0, these are
+    // approximated using a QuantileSketch, which is filled in a single pass
+    // through the data, also yielding npts, min, and max if these are not
+    // known. The sorted index of an approximate value typically differs less
+    // than <src>rankError*npts</src> from the requested index; the error of
+    // the median absolute deviation is about twice as large. Results may
+    // differ slightly with the number of threads used. The default, 0, means
+    // that these statistics are computed exactly. Changing the rank error
+    // clears the statistics computed so far.
+    void setQuantileRankError(Double rankError);
+
     virtual void setStatsToCalculate(std::set<StatisticsData::STATS>& stats);
 
 protected:
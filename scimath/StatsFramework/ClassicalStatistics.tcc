@@ -139,7 +139,24 @@ void ClassicalStatistics<CASA_STATP>::_doNptsMinMax(
         mynpts = *knownNpts;
         ThrowIf(mynpts == 0, "No valid data found");
     }
-    if ((! knownMin || ! knownMax) && ! knownNpts) {
+    if (
+        _qComputer->getSketchRankError() > 0
+        && (! knownMin || ! knownMax || ! knownNpts)
+    ) {
+        // the sketch is made in one pass and also has npts, min, and max
+        uInt64 npts = 0;
+        AccumType vmin = 0, vmax = 0;
+        _qComputer->getSketchNptsMinMax(npts, vmin, vmax);
+        ThrowIf(npts == 0, "No valid data found");
+        if (! knownMin || ! knownMax) {
+            mymin = vmin;
+            mymax = vmax;
+        }
+        if (! knownNpts) {
+            mynpts = npts;
+        }
+    }
+    else if ((! knownMin || ! knownMax) && ! knownNpts) {
         getMinMaxNpts(mynpts, mymin, mymax);
     }
     else if (! knownMin || ! knownMax) {
@@ -328,9 +345,18 @@ void ClassicalStatistics<CASA_STATP>::setStatsToCalculate(
     StatisticsAlgorithm<CASA_STATP>::setStatsToCalculate(stats);
 }
 
+CASA_STATD
+void ClassicalStatistics<CASA_STATP>::setQuantileRankError(Double rankError) {
+    if (rankError != _qComputer->getSketchRankError()) {
+        _qComputer->setSketchRankError(rankError);
+        _clearStats();
+    }
+}
+
 CASA_STATD
 void ClassicalStatistics<CASA_STATP>::_addData() {
     _qComputer->_setSortedArray(std::vector<AccumType>());
+    _qComputer->deleteSketch();
     _getStatsData().median = NULL;
     _mustAccumulate = True;
     if (_calculateAsAdded) {
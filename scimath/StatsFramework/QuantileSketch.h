@@ -0,0 +1,122 @@
+//# Copyright (C) 2000,2001
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+
+#ifndef SCIMATH_QUANTILESKETCH_H
+#define SCIMATH_QUANTILESKETCH_H
+
+#include <casacore/casa/aips.h>
+
+#include <utility>
+#include <vector>
+
+namespace casacore {
+
+// Summary of a stream of values from which quantiles can be estimated
+// using a bounded amount of memory. It is a KLL sketch (Karnin, Lang and
+// Liberty, 2016): values are kept in a hierarchy of compactors, where an
+// item in level h represents 2^h values. When a level is full, it is
+// sorted and every other item is moved to the next level. The offset of
+// the moved items alternates per level, so results are reproducible.
+//
+// The rank of a returned value typically differs less than
+// <src>rankError*npts</src> from the requested rank. The number of items
+// kept is at most about 12/rankError. Two sketches made with the same rank
+// error can be merged, so sketches of parts of a dataset (e.g. filled by
+// different threads) can be combined to the sketch of the entire dataset.
+// The number of values, the minimum and the maximum are exact.
+//
+// The sorted index of a value is defined as in the StatsFramework, thus a
+// quantile q is the value with zero-based index ceil(q*npts)-1.
+
+template <class AccumType> class QuantileSketch {
+public:
+
+    // Create a sketch with the given maximum relative rank error,
+    // which must be between 0 and 1.
+    explicit QuantileSketch(Double rankError);
+
+    ~QuantileSketch();
+
+    // add a value
+    void add(const AccumType& value);
+
+    // add all values of a sketch made with the same rank error
+    void merge(const QuantileSketch<AccumType>& other);
+
+    // the number of values added
+    uInt64 npts() const { return _npts; }
+
+    // the exact minimum and maximum of the values added. Not valid if
+    // npts() is 0.
+    // <group>
+    AccumType min() const { return _min; }
+    AccumType max() const { return _max; }
+    // </group>
+
+    // the (approximate) value at the given zero-based index in the sorted
+    // list of all values added. The first and last index give the exact
+    // minimum and maximum.
+    AccumType value(uInt64 index) const;
+
+    // get the items in the sketch with their weights, i.e. the number of
+    // values they represent. The weights add up to npts().
+    std::vector<std::pair<AccumType, uInt64>> items() const;
+
+    // get the value at the given zero-based index in the sorted list of values
+    // represented by the weighted items. The items are sorted in place.
+    static AccumType valueFromItems(
+        std::vector<std::pair<AccumType, uInt64>>& items, uInt64 index
+    );
+
+    // the number of items kept, which is at most about 12/rankError
+    uInt64 size() const;
+
+private:
+
+    uInt _k;
+    uInt64 _npts{0};
+    AccumType _min{0}, _max{0};
+    std::vector<std::vector<AccumType>> _levels;
+    // per level the offset of the items moved up at the next compaction
+    std::vector<Bool> _odd;
+
+    // the maximum number of items in the given level
+    uInt _capacity(uInt level) const;
+
+    // compact the levels that are full
+    void _compress();
+
+    // move half of the items of the given level to the next level
+    void _compact(uInt level);
+
+};
+
+}
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/scimath/StatsFramework/QuantileSketch.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+
+#endif
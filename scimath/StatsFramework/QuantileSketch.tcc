@@ -0,0 +1,213 @@
+//# Copyright (C) 2000,2001
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+
+#ifndef SCIMATH_QUANTILESKETCH_TCC
+#define SCIMATH_QUANTILESKETCH_TCC
+
+#include <casacore/scimath/StatsFramework/QuantileSketch.h>
+
+#include <casacore/casa/Exceptions/Error.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace casacore {
+
+template <class AccumType>
+QuantileSketch<AccumType>::QuantileSketch(Double rankError)
+    : _k(0), _levels(1), _odd(1, False) {
+    ThrowIf(
+        ! (rankError > 0 && rankError < 1),
+        "QuantileSketch rank error must be between 0 and 1"
+    );
+    _k = std::max(8u, uInt(std::ceil(4/rankError)));
+    _levels[0].reserve(_k);
+}
+
+template <class AccumType> QuantileSketch<AccumType>::~QuantileSketch() {}
+
+template <class AccumType>
+void QuantileSketch<AccumType>::add(const AccumType& value) {
+    if (_npts == 0) {
+        _min = value;
+        _max = value;
+    }
+    else if (value < _min) {
+        _min = value;
+    }
+    else if (value > _max) {
+        _max = value;
+    }
+    ++_npts;
+    _levels[0].push_back(value);
+    if (_levels[0].size() >= _capacity(0)) {
+        _compress();
+    }
+}
+
+template <class AccumType>
+void QuantileSketch<AccumType>::merge(const QuantileSketch<AccumType>& other) {
+    ThrowIf(
+        other._k != _k,
+        "QuantileSketch::merge: sketches have a different rank error"
+    );
+    if (other._npts == 0) {
+        return;
+    }
+    if (_npts == 0) {
+        _min = other._min;
+        _max = other._max;
+    }
+    else {
+        if (other._min < _min) {
+            _min = other._min;
+        }
+        if (other._max > _max) {
+            _max = other._max;
+        }
+    }
+    _npts += other._npts;
+    if (other._levels.size() > _levels.size()) {
+        _levels.resize(other._levels.size());
+        _odd.resize(other._levels.size(), False);
+    }
+    for (uInt h=0; h<other._levels.size(); ++h) {
+        _levels[h].insert(
+            _levels[h].end(), other._levels[h].begin(), other._levels[h].end()
+        );
+    }
+    _compress();
+}
+
+template <class AccumType>
+AccumType QuantileSketch<AccumType>::value(uInt64 index) const {
+    ThrowIf(_npts == 0, "QuantileSketch is empty");
+    ThrowIf(index >= _npts, "QuantileSketch index out of range");
+    if (index == 0) {
+        return _min;
+    }
+    if (index == _npts-1) {
+        return _max;
+    }
+    auto myItems = items();
+    return valueFromItems(myItems, index);
+}
+
+template <class AccumType>
+std::vector<std::pair<AccumType, uInt64>>
+QuantileSketch<AccumType>::items() const {
+    std::vector<std::pair<AccumType, uInt64>> myItems;
+    myItems.reserve(size());
+    uInt64 weight = 1;
+    for (const auto& level : _levels) {
+        for (const auto& v : level) {
+            myItems.push_back(std::make_pair(v, weight));
+        }
+        weight *= 2;
+    }
+    return myItems;
+}
+
+template <class AccumType>
+AccumType QuantileSketch<AccumType>::valueFromItems(
+    std::vector<std::pair<AccumType, uInt64>>& items, uInt64 index
+) {
+    ThrowIf(items.empty(), "QuantileSketch has no items");
+    std::sort(
+        items.begin(), items.end(),
+        [](const std::pair<AccumType, uInt64>& a,
+           const std::pair<AccumType, uInt64>& b) {
+            return a.first < b.first;
+        }
+    );
+    // An item of weight w represents the w values at the sorted indices
+    // from the sum of the preceding weights onwards.
+    uInt64 cumWeight = 0;
+    for (const auto& item : items) {
+        cumWeight += item.second;
+        if (cumWeight > index) {
+            return item.first;
+        }
+    }
+    return items.back().first;
+}
+
+template <class AccumType>
+uInt64 QuantileSketch<AccumType>::size() const {
+    uInt64 n = 0;
+    for (const auto& level : _levels) {
+        n += level.size();
+    }
+    return n;
+}
+
+template <class AccumType>
+uInt QuantileSketch<AccumType>::_capacity(uInt level) const {
+    // The capacity decreases by a factor 2/3 for each level below the top.
+    const uInt depth = _levels.size() - 1 - level;
+    return std::max(2u, uInt(std::ceil(_k * std::pow(2./3., Double(depth)))));
+}
+
+template <class AccumType>
+void QuantileSketch<AccumType>::_compress() {
+    // Adding a level reduces the capacity of the lower levels, so repeat
+    // until all levels fit.
+    Bool compacted = True;
+    while (compacted) {
+        compacted = False;
+        for (uInt h=0; h<_levels.size(); ++h) {
+            if (_levels[h].size() >= _capacity(h)) {
+                _compact(h);
+                compacted = True;
+            }
+        }
+    }
+}
+
+template <class AccumType>
+void QuantileSketch<AccumType>::_compact(uInt level) {
+    if (level+1 == _levels.size()) {
+        _levels.emplace_back();
+        _odd.push_back(False);
+    }
+    auto& items = _levels[level];
+    std::sort(
+        items.begin(), items.end(),
+        [](const AccumType& a, const AccumType& b) { return a < b; }
+    );
+    // Keep the last item if the number of items is odd, so the total
+    // weight is preserved.
+    const size_t n = items.size() - items.size() % 2;
+    auto& next = _levels[level+1];
+    for (size_t i=(_odd[level] ? 1 : 0); i<n; i+=2) {
+        next.push_back(items[i]);
+    }
+    _odd[level] = ! _odd[level];
+    items.erase(items.begin(), items.begin() + n);
+}
+
+}
+
+#endif
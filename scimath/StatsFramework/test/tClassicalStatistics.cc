@@ -1941,6 +1941,58 @@ int main() {
             }
             AlwaysAssert(cs.getNPts() == expec, AipsError);
         }
+        {
+            // approximate quantiles from a sketch
+            vector<Double> big(200000);
+            vector<Bool> mask(big.size(), True);
+            for (uInt i=0; i<big.size(); ++i) {
+                big[i] = i;
+            }
+            random_shuffle(big.begin(), big.end());
+            // mask out the values that are a multiple of 3
+            for (uInt i=0; i<big.size(); ++i) {
+                mask[i] = ((uInt)big[i] % 3) != 0;
+            }
+            ClassicalStatistics<
+                Double, vector<Double>::const_iterator, vector<Bool>::const_iterator
+            > exact, approx;
+            exact.setData(big.begin(), mask.begin(), big.size());
+            approx.setData(big.begin(), mask.begin(), big.size());
+            Double rankError = 0.005;
+            approx.setQuantileRankError(rankError);
+            std::set<Double> quantiles {0.1, 0.25, 0.75, 0.9};
+            std::map<Double, Double> exactQ, approxQ;
+            Double exactMedian = exact.getMedianAndQuantiles(
+                exactQ, quantiles, nullptr, nullptr, nullptr, 100
+            );
+            Double approxMedian = approx.getMedianAndQuantiles(
+                approxQ, quantiles, nullptr, nullptr, nullptr, 100
+            );
+            // each value is 1.5 times its index in the sorted good data
+            Double tol = 1.5*rankError*exact.getNPts();
+            AlwaysAssert(abs(approxMedian - exactMedian) <= tol, AipsError);
+            for (auto q : quantiles) {
+                AlwaysAssert(abs(approxQ[q] - exactQ[q]) <= tol, AipsError);
+            }
+            Double exactMad = exact.getMedianAbsDevMed(
+                nullptr, nullptr, nullptr, 100
+            );
+            Double approxMad = approx.getMedianAbsDevMed(
+                nullptr, nullptr, nullptr, 100
+            );
+            AlwaysAssert(abs(approxMad - exactMad) <= 2*tol, AipsError);
+            uInt64 npts;
+            Double mymin, mymax;
+            approx.getMinMaxNpts(npts, mymin, mymax);
+            AlwaysAssert(npts == exact.getNPts(), AipsError);
+            AlwaysAssert(mymin == 1 && mymax == big.size() - 1, AipsError);
+            // with a rank error of 0, the exact values are computed again
+            approx.setQuantileRankError(0);
+            AlwaysAssert(
+                approx.getMedian(nullptr, nullptr, nullptr, 100) == exactMedian,
+                AipsError
+            );
+        }
         {
             ClassicalStatistics<
                 Double, vector<Double>::const_iterator, vector<Bool>::const_iterator
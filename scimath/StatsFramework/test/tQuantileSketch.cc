@@ -0,0 +1,159 @@
+//# Copyright (C) 1999,2000,2001
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+
+#include <casacore/scimath/StatsFramework/QuantileSketch.h>
+
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// check that the sorted index of each estimated quantile differs less than
+// the rank error from the requested index
+void checkRanks(
+    const QuantileSketch<Double>& sketch, std::vector<Double> values,
+    Double rankError
+) {
+    std::sort(values.begin(), values.end());
+    const uInt64 npts = values.size();
+    AlwaysAssert(sketch.npts() == npts, AipsError);
+    AlwaysAssert(sketch.min() == values.front(), AipsError);
+    AlwaysAssert(sketch.max() == values.back(), AipsError);
+    AlwaysAssert(sketch.value(0) == values.front(), AipsError);
+    AlwaysAssert(sketch.value(npts-1) == values.back(), AipsError);
+    for (uInt i=1; i<100; ++i) {
+        uInt64 idx = i*npts/100;
+        auto v = sketch.value(idx);
+        Double low = std::lower_bound(values.begin(), values.end(), v)
+            - values.begin();
+        Double high = std::upper_bound(values.begin(), values.end(), v)
+            - values.begin() - 1;
+        AlwaysAssert(low - idx <= rankError*npts, AipsError);
+        AlwaysAssert(idx - high <= rankError*npts, AipsError);
+    }
+}
+
+int main() {
+    try {
+        {
+            cout << "Test small data set is exact" << endl;
+            QuantileSketch<Double> sketch(0.01);
+            std::vector<Double> values;
+            for (Int i=0; i<100; ++i) {
+                values.push_back((i*37) % 100);
+                sketch.add(values.back());
+            }
+            std::sort(values.begin(), values.end());
+            for (uInt i=0; i<100; ++i) {
+                AlwaysAssert(sketch.value(i) == values[i], AipsError);
+            }
+        }
+        std::mt19937 gen(1);
+        std::normal_distribution<Double> dist(5, 2);
+        std::vector<Double> values(200000);
+        for (auto& v : values) {
+            v = dist(gen);
+        }
+        for (Double rankError : {0.01, 0.002}) {
+            {
+                cout << "Test random values, rank error " << rankError << endl;
+                QuantileSketch<Double> sketch(rankError);
+                for (auto v : values) {
+                    sketch.add(v);
+                }
+                AlwaysAssert(sketch.size() < 12/rankError, AipsError);
+                checkRanks(sketch, values, rankError);
+            }
+            {
+                cout << "Test sorted values, rank error " << rankError << endl;
+                auto sorted = values;
+                std::sort(sorted.begin(), sorted.end());
+                QuantileSketch<Double> sketch(rankError);
+                for (auto v : sorted) {
+                    sketch.add(v);
+                }
+                checkRanks(sketch, sorted, rankError);
+            }
+            {
+                cout << "Test merge, rank error " << rankError << endl;
+                std::vector<QuantileSketch<Double>> parts(
+                    4, QuantileSketch<Double>(rankError)
+                );
+                for (uInt i=0; i<values.size(); ++i) {
+                    parts[(i/1000) % 4].add(values[i]);
+                }
+                QuantileSketch<Double> sketch(rankError);
+                for (const auto& part : parts) {
+                    sketch.merge(part);
+                }
+                checkRanks(sketch, values, rankError);
+                auto items = sketch.items();
+                uInt64 weight = 0;
+                for (const auto& item : items) {
+                    weight += item.second;
+                }
+                AlwaysAssert(weight == values.size(), AipsError);
+            }
+        }
+        {
+            cout << "Test exceptions" << endl;
+            Bool thrown = False;
+            try {
+                QuantileSketch<Double> sketch(0);
+            }
+            catch (const AipsError&) {
+                thrown = True;
+            }
+            AlwaysAssert(thrown, AipsError);
+            thrown = False;
+            QuantileSketch<Double> sketch(0.1);
+            try {
+                sketch.value(0);
+            }
+            catch (const AipsError&) {
+                thrown = True;
+            }
+            AlwaysAssert(thrown, AipsError);
+            thrown = False;
+            try {
+                sketch.merge(QuantileSketch<Double>(0.01));
+            }
+            catch (const AipsError&) {
+                thrown = True;
+            }
+            AlwaysAssert(thrown, AipsError);
+        }
+        cout << "OK" << endl;
+    }
+    catch (const std::exception& x) {
+        cout << x.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -713,6 +713,14 @@ uInt TSMCube::cacheSize() const
     return cache_p->cacheSize();
 }
 
+uInt TSMCube::nTileReads() const
+{
+    if (cache_p == 0) {
+	return 0;
+    }
+    return cache_p->nRead();
+}
+
 uInt TSMCube::validateCacheSize (uInt cacheSize) const
 {
   return validateCacheSize (cacheSize, stmanPtr_p->maximumCacheSize(),
@@ -898,6 +906,13 @@ void TSMCube::resizeTileSections()
     startPixelInFirstTile_p.resize(nrdim_p);
     endPixelInFirstTile_p.resize(nrdim_p);
     endPixelInLastTile_p.resize(nrdim_p);
+    sectionShape_p.resize(nrdim_p);
+    tilePos_p.resize(nrdim_p);
+    startPixel_p.resize(nrdim_p);
+    endPixel_p.resize(nrdim_p);
+    dataLength_p.resize(nrdim_p);
+    dataPos_p.resize(nrdim_p);
+    sectionPos_p.resize(nrdim_p);
   }
   return;
 }
@@ -991,17 +1006,28 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     // startPixel and endPixel will contain the first and last pixels
     // needed in the current tile.
     // tilePos contains the position of the current tile.
-    IPosition startSection (start);            // start of section in cube
-    IPosition sectionShape (end - start + 1);  // section shape
-    TSMShape expandedSectionShape (sectionShape);
-    IPosition startPixel (startPixelInFirstTile_p);
-    IPosition endPixel   (endPixelInFirstTile_p);
-    IPosition tilePos    (startTile_p);
-    IPosition tileIncr = 
-      expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
-    IPosition dataLength(nrdim_p);
-    IPosition dataPos   (nrdim_p);
-    IPosition sectionPos(nrdim_p);
+    // The IPositions are member variables to avoid creating them for
+    // each call (which allocates for more than 4 dimensions).
+    const IPosition& startSection = start;     // start of section in cube
+    IPosition& sectionShape = sectionShape_p;  // section shape
+    for (uInt i=0; i<nrdim_p; i++) {
+        sectionShape(i) = end(i) - start(i) + 1;
+    }
+    TSMShape& expandedSectionShape = expandedSectionShape_p;
+    expandedSectionShape.setShape (sectionShape);
+    IPosition& startPixel = startPixel_p;
+    IPosition& endPixel   = endPixel_p;
+    IPosition& tilePos    = tilePos_p;
+    startPixel = startPixelInFirstTile_p;
+    endPixel   = endPixelInFirstTile_p;
+    tilePos    = startTile_p;
+    IPosition& tileIncr = tileIncr_p;
+    expandedTilesPerDim_p.offsetIncrement (tileIncr, nrTileSection_p, 1);
+    IPosition& dataLength = dataLength_p;
+    IPosition& dataPos    = dataPos_p;
+    IPosition& sectionPos = sectionPos_p;
+    IPosition& dataIncr    = dataIncr_p;
+    IPosition& sectionIncr = sectionIncr_p;
     uInt dataOffset;
     size_t sectionOffset;
     uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
@@ -1032,10 +1058,10 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
                             expandedTileShape_p.offset (startPixel);
         sectionOffset = localPixelSize *
                             expandedSectionShape.offset (sectionPos);
-        IPosition dataIncr    = localPixelSize *
-                            expandedTileShape_p.offsetIncrement (dataLength);
-        IPosition sectionIncr = localPixelSize *
-                            expandedSectionShape.offsetIncrement (dataLength);
+        expandedTileShape_p.offsetIncrement (dataIncr, dataLength,
+                                             localPixelSize);
+        expandedSectionShape.offsetIncrement (sectionIncr, dataLength,
+                                              localPixelSize);
 
         while (True) {
             uInt localSize = dataLength(0) * localPixelSize;
@@ -1334,6 +1360,8 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
     TSMShape expandedSectionShape (sectionShape);
     IPosition dataLength(nrdim_p);
     IPosition dataPos   (nrdim_p);
+    IPosition dataIncr;
+    IPosition sectionIncr;
     uInt dataOffset;
     size_t sectionOffset;
 
@@ -1390,10 +1418,10 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
         // Calculate the start and end pixel in the tile.
         // Initialize the pixel position in the data and section.
         dataPos = startPixel;
-        IPosition dataIncr    = localPixelSize *
-                         expandedTileShape_p.offsetIncrement (nrPixel, stride);
-        IPosition sectionIncr = localPixelSize *
-                         expandedSectionShape.offsetIncrement (nrPixel);
+        expandedTileShape_p.offsetIncrement (dataIncr, nrPixel, stride,
+                                             localPixelSize);
+        expandedSectionShape.offsetIncrement (sectionIncr, nrPixel,
+                                              localPixelSize);
         dataOffset = pixelOffset + localPixelSize *
                          expandedTileShape_p.offset (startPixel);
         sectionOffset = localPixelSize *
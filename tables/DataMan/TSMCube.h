@@ -235,6 +235,10 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Get the number of tiles read since the cache statistics were
+    // (re)initialized (which is done when the cache is cleared).
+    uInt nTileReads() const;
+
     // Calculate the cache size (in buckets) for the given slice
     // and access path.
     // <group>
@@ -414,6 +418,23 @@ protected:
     IPosition endPixelInFirstTile_p;
     // Last pixel in last tile
     IPosition endPixelInLastTile_p;
+    // Shape of the section
+    IPosition sectionShape_p;
+    // Offsets of the section
+    TSMShape expandedSectionShape_p;
+    // Current tile and first and last pixel needed in it
+    IPosition tilePos_p;
+    IPosition startPixel_p;
+    IPosition endPixel_p;
+    // Increments to step to the next tile
+    IPosition tileIncr_p;
+    // Length and position of the part in the current tile
+    IPosition dataLength_p;
+    IPosition dataPos_p;
+    IPosition sectionPos_p;
+    // Increments (in bytes) to step through the tile and section
+    IPosition dataIncr_p;
+    IPosition sectionIncr_p;
 };
 
 
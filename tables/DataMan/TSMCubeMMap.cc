@@ -248,17 +248,28 @@ void TSMCubeMMap::accessSection (const IPosition& start, const IPosition& end,
   // startPixel and endPixel will contain the first and last pixels
   // needed in the current tile.
   // tilePos contains the position of the current tile.
-  IPosition startSection (start);            // start of section in cube
-  IPosition sectionShape (end - start + 1);  // section shape
-  TSMShape expandedSectionShape (sectionShape);
-  IPosition startPixel (startPixelInFirstTile_p);
-  IPosition endPixel   (endPixelInFirstTile_p);
-  IPosition tilePos    (startTile_p);
-  IPosition tileIncr = 
-    expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
-  IPosition dataLength(nrdim_p);
-  IPosition dataPos   (nrdim_p);
-  IPosition sectionPos(nrdim_p);
+  // The IPositions are member variables to avoid creating them for
+  // each call (which allocates for more than 4 dimensions).
+  const IPosition& startSection = start;     // start of section in cube
+  IPosition& sectionShape = sectionShape_p;  // section shape
+  for (uInt i=0; i<nrdim_p; i++) {
+    sectionShape(i) = end(i) - start(i) + 1;
+  }
+  TSMShape& expandedSectionShape = expandedSectionShape_p;
+  expandedSectionShape.setShape (sectionShape);
+  IPosition& startPixel = startPixel_p;
+  IPosition& endPixel   = endPixel_p;
+  IPosition& tilePos    = tilePos_p;
+  startPixel = startPixelInFirstTile_p;
+  endPixel   = endPixelInFirstTile_p;
+  tilePos    = startTile_p;
+  IPosition& tileIncr = tileIncr_p;
+  expandedTilesPerDim_p.offsetIncrement (tileIncr, nrTileSection_p, 1);
+  IPosition& dataLength = dataLength_p;
+  IPosition& dataPos    = dataPos_p;
+  IPosition& sectionPos = sectionPos_p;
+  IPosition& dataIncr    = dataIncr_p;
+  IPosition& sectionIncr = sectionIncr_p;
   uInt dataOffset;
   size_t sectionOffset;
   uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
@@ -282,10 +293,10 @@ void TSMCubeMMap::accessSection (const IPosition& start, const IPosition& end,
     }
     dataOffset    = expandedTileShape_p.offset (startPixel);
     sectionOffset = localPixelSize * expandedSectionShape.offset (sectionPos);
-    IPosition dataIncr    = dataPixelSize *
-      expandedTileShape_p.offsetIncrement (dataLength);
-    IPosition sectionIncr = localPixelSize *
-      expandedSectionShape.offsetIncrement (dataLength);
+    expandedTileShape_p.offsetIncrement (dataIncr, dataLength,
+                                         dataPixelSize);
+    expandedSectionShape.offsetIncrement (sectionIncr, dataLength,
+                                          localPixelSize);
 
     // Calculate the largest number of pixels, nSec
     // that are consequtive in data and in section
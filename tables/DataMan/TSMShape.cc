@@ -38,6 +38,13 @@ TSMShape::TSMShape (const IPosition& shape)
 : data_p (shape.nelements()),
   size_p (shape.nelements())
 {
+    setShape (shape);
+}
+
+void TSMShape::setShape (const IPosition& shape)
+{
+    size_p = shape.nelements();
+    data_p.resize (size_p, False);
     if (size_p > 0) {
 	data_p(0) = 1;
 	for (uInt i=1; i<size_p; i++) {
@@ -149,5 +156,38 @@ IPosition TSMShape::offsetIncrement (const IPosition& subShape,
     return incr;
 }
 
+void TSMShape::offsetIncrement (IPosition& incr, const IPosition& subShape,
+                                ssize_t factor) const
+{
+    if (size_p != subShape.nelements()) {
+	throw (ArrayConformanceError(
+                        "TSMShape::offsetIncrement - shapes do not conform"));
+    }
+    incr.resize (size_p, False);
+    if (size_p > 0) {
+        incr(0) = factor;
+    }
+    for (uInt i=1; i<size_p; i++) {
+	incr(i) = factor * (data_p(i) - subShape(i-1) * data_p(i-1));
+    }
+}
+
+void TSMShape::offsetIncrement (IPosition& incr, const IPosition& subShape,
+                                const IPosition& stride, ssize_t factor) const
+{
+    if (size_p != subShape.nelements()  ||  size_p != stride.nelements()) {
+	throw (ArrayConformanceError(
+                        "TSMShape::offsetIncrement - shapes do not conform"));
+    }
+    incr.resize (size_p, False);
+    if (size_p > 0) {
+        incr(0) = factor;
+    }
+    for (uInt i=1; i<size_p; i++) {
+	incr(i) = factor * (stride(i) * data_p(i) -
+                            subShape(i-1) * stride(i-1) * data_p(i-1));
+    }
+}
+
 } //# NAMESPACE CASACORE - END
 
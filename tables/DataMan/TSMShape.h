@@ -153,6 +153,21 @@ public:
 			       const IPosition& stride) const;
     // </group>
 
+    // Calculate the increments as above, but multiplied by
+    // <src>factor</src> (e.g. a pixel size in bytes) and stored in
+    // <src>incr</src>, which is resized if needed. In this way no
+    // temporary IPositions are created when used in a loop.
+    // <group>
+    void offsetIncrement (IPosition& incr, const IPosition& subShape,
+                          ssize_t factor) const;
+    void offsetIncrement (IPosition& incr, const IPosition& subShape,
+                          const IPosition& stride, ssize_t factor) const;
+    // </group>
+
+    // Recalculate the values for another shape. It avoids creating a new
+    // object if the dimensionality is unchanged.
+    void setShape (const IPosition& shape);
+
 private:
     IPosition data_p;
     uInt      size_p;     //# Not necessary, but done for speedup
@@ -432,6 +432,11 @@ uInt TiledStMan::cacheSize (rownr_t rownr) const
     return getHypercube(rownr)->cacheSize();
 }
 
+uInt TiledStMan::nTileReads (rownr_t rownr) const
+{
+    return getHypercube(rownr)->nTileReads();
+}
+
 uInt TiledStMan::calcCacheSize (rownr_t rownr,
                                 const IPosition& sliceShape,
                                 const IPosition& windowStart,
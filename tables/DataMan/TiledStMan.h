@@ -180,6 +180,10 @@ public:
     // the given row.
     uInt cacheSize (rownr_t rownr) const;
 
+    // Get the number of tiles read for the hypercube in the given row
+    // since its cache was cleared.
+    uInt nTileReads (rownr_t rownr) const;
+
     // Get the hypercube shape of the data in the given row.
     const IPosition& hypercubeShape (rownr_t rownr) const;
 
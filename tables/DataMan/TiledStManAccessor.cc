@@ -91,6 +91,11 @@ uInt ROTiledStManAccessor::cacheSize (rownr_t rownr) const
     return dataManPtr_p->cacheSize (rownr);
 }
 
+uInt ROTiledStManAccessor::nTileReads (rownr_t rownr) const
+{
+    return dataManPtr_p->nTileReads (rownr);
+}
+
 const IPosition& ROTiledStManAccessor::hypercubeShape (rownr_t rownr) const
 {
     return dataManPtr_p->hypercubeShape (rownr);
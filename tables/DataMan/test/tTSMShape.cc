@@ -105,6 +105,27 @@ int main()
     check (shape, incr, IPosition(4,1,1,1,1), "(1,3,2,6,4) ");
   }
 
+  {
+    // The in-place increments must equal the scaled normal increments.
+    IPosition shape (5,4,5,6,7,3);
+    IPosition subShape (5,3,2,6,4,2);
+    IPosition stride (5,1,2,1,1,2);
+    TSMShape tsmShape (IPosition(2,3,3));
+    tsmShape.setShape (shape);
+    IPosition incr;
+    tsmShape.offsetIncrement (incr, subShape, 8);
+    if (incr != 8 * tsmShape.offsetIncrement (subShape)) {
+      cout << "invalid in-place incr " << incr << endl;
+    }
+    tsmShape.offsetIncrement (incr, subShape, stride, 4);
+    if (incr != 4 * tsmShape.offsetIncrement (subShape, stride)) {
+      cout << "invalid in-place strided incr " << incr << endl;
+    }
+    if (tsmShape.offset (IPosition(5,1,2,3,4,2)) != 1+2*4+3*20+4*120+2*840) {
+      cout << "invalid offset after setShape" << endl;
+    }
+  }
+
   cout << "OK" << endl;
   return 0;
 }
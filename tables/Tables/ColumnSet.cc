@@ -889,17 +889,17 @@ rownr_t ColumnSet::getFile (AipsIO& ios, Table& tab, rownr_t nrrow, Bool bigEndi
 	BLOCKDATAMANVAL(i)->linkToTable (tab);
     }
     //# Finally open the data managers and let them prepare themselves.
+    //# The same buffer is used for all data manager headers.
+    Block<uChar> data;
     for (i=0; i<nr; i++) {
-	uChar* data;
 	uInt leng;
-	ios.getnew (leng, data);
-        auto memio = std::make_shared<MemoryIO>(data, leng);
+	ios.getinto (leng, data);
+        auto memio = std::make_shared<MemoryIO>(data.storage(), leng);
 	AipsIO aio(memio);
 	rownr_t nrrow = BLOCKDATAMANVAL(i)->open64 (nrrow_p, aio);
         if (nrrow > nrrow_p) {
           nrrow_p = nrrow;
         }
-	delete [] data;
     }
     prepareSomeDataManagers (0);
     return nrrow_p;
@@ -28,6 +28,7 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Utilities/GenSort.h>
+#include <exception>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -216,72 +217,85 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   void ConcatColumn::getArrayColumn (ArrayBase& arr) const
   {
-    accessColumn (0, arr, &getColumnPart);
+    accessColumn (0, arr, &getColumnPart, True);
   }
 
   void ConcatColumn::getColumnSlice (const Slicer& ns,
 				     ArrayBase& arr) const
   {
-    accessColumn (&ns, arr, &getColumnSlicePart);
+    accessColumn (&ns, arr, &getColumnSlicePart, True);
   }
 
   void ConcatColumn::getArrayColumnCells (const RefRows& rownrs,
 					  ArrayBase& arr) const
   {
-    accessRows (rownrs, 0, arr, &getRowsPart);
+    accessRows (rownrs, 0, arr, &getRowsPart, True);
   }
 
   void ConcatColumn::getColumnSliceCells (const RefRows& rownrs,
 					  const Slicer& ns,
 					  ArrayBase& arr) const
   {
-    accessRows (rownrs, &ns, arr, &getRowsSlicePart);
+    accessRows (rownrs, &ns, arr, &getRowsSlicePart, True);
   }
 
   void ConcatColumn::putArrayColumn (const ArrayBase& arr)
   {
-    accessColumn (0, const_cast<ArrayBase&>(arr), &putColumnPart);
+    accessColumn (0, const_cast<ArrayBase&>(arr), &putColumnPart, False);
   }
 
   void ConcatColumn::putColumnSlice (const Slicer& ns,
 				     const ArrayBase& arr)
   {
-    accessColumn (&ns, const_cast<ArrayBase&>(arr), &putColumnSlicePart);
+    accessColumn (&ns, const_cast<ArrayBase&>(arr), &putColumnSlicePart,
+                  False);
   }
 
   void ConcatColumn::putArrayColumnCells (const RefRows& rownrs,
 					  const ArrayBase& arr)
   {
-    accessRows (rownrs, 0, const_cast<ArrayBase&>(arr), &putRowsPart);
+    accessRows (rownrs, 0, const_cast<ArrayBase&>(arr), &putRowsPart, False);
   }
 
   void ConcatColumn::putColumnSliceCells (const RefRows& rownrs,
 					  const Slicer& ns,
 					  const ArrayBase& arr)
   {
-    accessRows (rownrs, &ns, const_cast<ArrayBase&>(arr), &putRowsSlicePart);
+    accessRows (rownrs, &ns, const_cast<ArrayBase&>(arr), &putRowsSlicePart,
+                False);
   }
 
   void ConcatColumn::accessColumn (const Slicer* ns,
 				   ArrayBase& arr,
-				   AccessColumnFunc* accessFunc) const
-  {
+				   AccessColumnFunc* accessFunc,
+                                   Bool parallel) const
+  {
+    // Create the (disjoint) array part for each table beforehand,
+    // so the tables can be accessed independently.
+    uInt ntab = refColPtr_p.nelements();
+    std::vector<std::unique_ptr<ArrayBase>> parts(ntab);
+    std::vector<uInt> tableNrs(ntab);
     IPosition st(arr.ndim(), 0);
     IPosition sz(arr.shape());
     uInt nlast = arr.ndim() - 1;
-    for (uInt i=0; i<refColPtr_p.nelements(); ++i) {
+    for (uInt i=0; i<ntab; ++i) {
       rownr_t nr = refColPtr_p[i]->nrow();
       sz[nlast] = nr;
-      std::unique_ptr<ArrayBase> part (arr.getSection (Slicer(st, sz)));
-      accessFunc (refColPtr_p[i], ns, *part);
+      parts[i] = arr.getSection (Slicer(st, sz));
+      tableNrs[i] = i;
       st[nlast] += nr;
     }
+    accessTables (tableNrs, parallel,
+                  [&](uInt tableNr) {
+                    accessFunc (refColPtr_p[tableNr], ns, *parts[tableNr]);
+                  });
   }
 
   void ConcatColumn::accessRows (const RefRows& rownrs,
 				 const Slicer* ns,
 				 ArrayBase& arr,
-				 AccessRowsFunc* accessFunc) const
+				 AccessRowsFunc* accessFunc,
+                                 Bool parallel) const
   {
     // The rows to access.
     Vector<rownr_t> rows = rownrs.convert();
@@ -295,37 +309,85 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Vector<rownr_t> tabRowNrs(rows.nelements());
     // The rows are handled by combining them as much as possible in a RefRows
     // slice. This is possible until a different underlying table needs to
-    // be accessed.
-    // First setup the various loop variables.
-    uInt rowAxis = arr.ndim() - 1;   // row axis in array
-    IPosition st(arr.ndim(), 0);     // start of array part
-    IPosition sz(arr.shape());       // size of array part
+    // be accessed. Each such run is a disjoint part of the array.
+    // The runs are collected per table, so different tables can be
+    // accessed independently.
+    std::vector<std::vector<std::pair<rownr_t,rownr_t>>> runs
+      (refColPtr_p.nelements());
+    std::vector<uInt> tableNrs;
     Int lastTabNr = -1;
+    rownr_t stRow = 0;
     uInt tableNr;
     // Step through all concat rownrs.
     for (rownr_t i=0; i<rows.nelements(); ++i) {
       // Map to the table and rownr in it.
       ccRows.mapRownr (tableNr, tabRowNrs[i], rows[i]);
-      // An access has to be done if we have another table.
+      // A new run starts if we have another table.
       if (Int(tableNr) != lastTabNr) {
-	// Access the cells if not the first time.
 	if (lastTabNr >= 0) {
-	  rownr_t nrrow = i - st[rowAxis];
-	  sz[rowAxis] = nrrow;
-	  Vector<rownr_t> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
-	  std::unique_ptr<ArrayBase> part (arr.getSection (Slicer(st, sz)));
-	  accessFunc (refColPtr_p[lastTabNr], RefRows(rowPart), ns, *part);
+          if (runs[lastTabNr].empty()) {
+            tableNrs.push_back (lastTabNr);
+          }
+          runs[lastTabNr].push_back (std::make_pair(stRow, i - stRow));
 	}
-        st[rowAxis] = i;
+        stRow = i;
         lastTabNr = tableNr;
       }
     }
     if (lastTabNr >= 0) {
-      rownr_t nrrow = rows.nelements() - st[rowAxis];
-      sz[rowAxis] = nrrow;
-      Vector<rownr_t> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
-      std::unique_ptr<ArrayBase> part (arr.getSection (Slicer(st, sz)));
-      accessFunc (refColPtr_p[lastTabNr], RefRows(rowPart), ns, *part);
+      if (runs[lastTabNr].empty()) {
+        tableNrs.push_back (lastTabNr);
+      }
+      runs[lastTabNr].push_back (std::make_pair(stRow,
+                                                rows.nelements() - stRow));
+    }
+    // Access the cells of each run.
+    uInt rowAxis = arr.ndim() - 1;   // row axis in array
+    accessTables (tableNrs, parallel,
+                  [&](uInt tabNr) {
+                    IPosition st(arr.ndim(), 0);     // start of array part
+                    IPosition sz(arr.shape());       // size of array part
+                    for (const auto& run : runs[tabNr]) {
+                      st[rowAxis] = run.first;
+                      sz[rowAxis] = run.second;
+                      Vector<rownr_t> rowPart
+                        (tabRowNrs(Slice(run.first, run.second)));
+                      std::unique_ptr<ArrayBase> part
+                        (arr.getSection (Slicer(st, sz)));
+                      accessFunc (refColPtr_p[tabNr], RefRows(rowPart),
+                                  ns, *part);
+                    }
+                  });
+  }
+
+  void ConcatColumn::accessTables (const std::vector<uInt>& tableNrs,
+                                   Bool parallel,
+                                   const std::function<void(uInt)>& accessFunc) const
+  {
+    Int ntab = tableNrs.size();
+    parallel = parallel  &&  ntab > 1  &&  refTabPtr_p->canReadParallel();
+    // Exceptions cannot cross an OpenMP region, so keep the first one
+    // and rethrow it at the end.
+    std::exception_ptr excp;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+    for (Int i=0; i<ntab; ++i) {
+      try {
+        accessFunc (tableNrs[i]);
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(ConcatColumn_accessTables)
+#endif
+        {
+          if (!excp) {
+            excp = std::current_exception();
+          }
+        }
+      }
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
     }
   }
 
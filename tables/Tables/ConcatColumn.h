@@ -33,6 +33,8 @@
 #include <casacore/tables/Tables/ColumnCache.h>
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
+#include <functional>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -231,15 +233,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                                  const Slicer*, ArrayBase& array);
 
     // Access the data for an entire column.
+    // If <src>parallel=True</src>, the parts are accessed concurrently
+    // if possible (see <src>ConcatTable::canReadParallel</src>).
     void accessColumn (const Slicer* ns,
 		       ArrayBase& dataPtr,
-		       AccessColumnFunc*) const;
+		       AccessColumnFunc*,
+                       Bool parallel) const;
 
     // Access the data with multiple rows combined.
+    // If <src>parallel=True</src>, the parts are accessed concurrently
+    // if possible (see <src>ConcatTable::canReadParallel</src>).
     void accessRows (const RefRows& rownrs,
 		     const Slicer* ns,
 		     ArrayBase& dataPtr,
-		     AccessRowsFunc*) const;
+		     AccessRowsFunc*,
+                     Bool parallel) const;
 
     // Define the access functions.
     static void getColumnPart (BaseColumn* col,
@@ -265,6 +273,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // The row numbers will be adjusted as needed.
     void setColumnCache (uInt tableNr, const ColumnCache&) const;
 
+    // Call the access function for the given (distinct) table numbers.
+    // If <src>parallel=True</src> and the underlying tables can be read
+    // in parallel, the calls are done concurrently using OpenMP.
+    // Each call must access a disjoint part of the result array.
+    // An exception thrown in one of the calls is rethrown afterwards.
+    void accessTables (const std::vector<uInt>& tableNrs, Bool parallel,
+                       const std::function<void(uInt)>& accessFunc) const;
+
     //# Data members
     ConcatTable*        refTabPtr_p;
     Block<BaseColumn*>  refColPtr_p;
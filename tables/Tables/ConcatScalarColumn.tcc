@@ -49,13 +49,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   void ConcatScalarColumn<T>::getScalarColumn (ArrayBase& arr) const
   {
     Vector<T>& vec = static_cast<Vector<T>&>(arr);
-    rownr_t st = 0;
-    for (uInt i=0; i<refColPtr_p.nelements(); ++i) {
-      rownr_t nr = refColPtr_p[i]->nrow();
-      Vector<T> part = vec(Slice(st, nr));
-      refColPtr_p[i]->getScalarColumn (part);
-      st += nr;
+    // Each table fills its own part of the vector, so they can be
+    // read in parallel.
+    uInt ntab = refColPtr_p.nelements();
+    std::vector<rownr_t> st(ntab, 0);
+    std::vector<uInt> tableNrs(ntab);
+    for (uInt i=0; i<ntab; ++i) {
+      if (i > 0) {
+        st[i] = st[i-1] + refColPtr_p[i-1]->nrow();
+      }
+      tableNrs[i] = i;
     }
+    accessTables (tableNrs, True,
+                  [&](uInt tableNr) {
+                    Vector<T> part = vec(Slice(st[tableNr],
+                                               refColPtr_p[tableNr]->nrow()));
+                    refColPtr_p[tableNr]->getScalarColumn (part);
+                  });
     // Set the column cache to the first table.
     ///setColumnCache (0, refColPtr_p[0]->columnCache());
   }
@@ -37,6 +37,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <set>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -45,7 +46,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 			    int option, const TableLock& lockOptions,
                             const TSMOption& tsmOption)
     : BaseTable (name, option, nrrow),
-      changed_p (False)
+      changed_p (False),
+      parallelRead_p (False)
   {
     //# Read the file in.
     // Set initially to no write in destructor.
@@ -63,7 +65,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       subTableNames_p (subTables),
       subDirName_p    (subDirName),
       tables_p        (tables),
-      changed_p       (True)
+      changed_p       (True),
+      parallelRead_p  (False)
   {
     ///cout<<"cctab1="<<sizeof(*this)<<' '<<this<<' '<<&rows_p<<' '<<&(rows())<<endl;
     noWrite_p = True;
@@ -89,7 +92,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     : BaseTable       ("", Table::Scratch, 0),
       subTableNames_p (subTables),
       subDirName_p    (subDirName),
-      changed_p       (True)
+      changed_p       (True),
+      parallelRead_p  (False)
   {
     ///cout<<"cctab1="<<sizeof(*this)<<' '<<this<<' '<<&rows_p<<' '<<&(rows())<<endl;
     noWrite_p = True;
@@ -357,11 +361,32 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     keywordSet_p = tables_p[0].keywordSet();
     // Handle the possible concatenated subtables.
     handleSubTables();
+    setParallelRead();
     // Create the concatColumns.
     // Do this last, to avoid leaks in case of exceptions above.
     makeConcatCol();
   }
 
+  void ConcatTable::setParallelRead()
+  {
+    // Parallel reading is only safe if no data manager is shared by
+    // multiple parts, thus if the underlying physical tables differ.
+    parallelRead_p = False;
+    if (tables_p.nelements() > 1) {
+      Block<String> names;
+      for (uInt i=0; i<tables_p.nelements(); ++i) {
+        tables_p[i].baseTablePtr()->getPartNames (names, True);
+      }
+      std::set<String> uniqueNames;
+      for (uInt i=0; i<names.nelements(); ++i) {
+        if (names[i].empty()  ||  !uniqueNames.insert(names[i]).second) {
+          return;
+        }
+      }
+      parallelRead_p = True;
+    }
+  }
+
   void ConcatTable::handleSubTables()
   {
     // Check for each subtable if it exists in all tables.
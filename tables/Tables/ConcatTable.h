@@ -308,6 +308,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the column objects in the referenced tables.
     Block<BaseColumn*> getRefColumns (const String& columnName);
 
+    // Can the underlying tables be read concurrently?
+    // This is the case if they consist of more than one table and if all
+    // of them are different physical tables, thus do not share data managers.
+    Bool canReadParallel() const
+      { return parallelRead_p; }
+
   private:
     // Show the extra table structure info (names of used tables).
     void showStructureExtra (std::ostream&) const;
@@ -331,6 +337,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // <br>Create the initial TableInfo as a copy of the original BaseTable.
     void setup (BaseTable* btp, const Vector<String>& columnNames);
 
+    // Determine if the underlying tables can be read in parallel.
+    void setParallelRead();
+
     // Add lines containing the concatenated tables to the info.
     void addInfo();
 
@@ -358,6 +367,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     std::map<String,ConcatColumn*> colMap_p;  //# map name to column
     TableRecord       keywordSet_p;
     Bool              changed_p;           //# True = changed since last write
+    Bool              parallelRead_p;      //# True = parts can be read in parallel
     ConcatRows        rows_p;
   };
 
@@ -451,7 +451,7 @@ void Table::open (const String& name, const String& type, int tableOption,
         }
         //# Read the file type and verify that it is a table
         AipsIO ios (desc);
-        String t = ios.getNextType();
+        const String& t = ios.getNextType();
         if (t != "Table") {
             throw TableInvType(absName, "Table", t);
         }
@@ -432,7 +432,7 @@ void TableRecordRep::getRecord (AipsIO& os, Int& recordType,
 {
     // Support reading scalar, array, and table keyword sets as records.
     uInt version;
-    String type = os.getNextType();
+    const String& type = os.getNextType();
     if (type == "ScalarKeywordSet") {
 	version = os.getstart ("ScalarKeywordSet");
 	getTableKeySet (os, version, parentAttr, 0);
@@ -25,6 +25,9 @@
 
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
@@ -40,6 +43,7 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
 
@@ -331,10 +335,99 @@ void doItMult (const Block<String>& tableNames)
   doIt (tab);
 }
 
+// Make a table with an array and scalar column, where the values
+// are 10*rownr + element.
+Table makePart (const String& name, rownr_t firstRow, rownr_t nrow,
+                uInt nelem)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("sca"));
+  td.addColumn (ArrayColumnDesc<Int>("arr", 1));
+  SetupNewTable newtab(name, td, Table::Scratch);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> sca(tab, "sca");
+  ArrayColumn<Int> arr(tab, "arr");
+  Vector<Int> vec(nelem);
+  for (rownr_t i=0; i<nrow; ++i) {
+    Int rownr = firstRow + i;
+    sca.put (i, rownr);
+    indgen (vec, 10*rownr);
+    arr.put (i, vec);
+  }
+  return tab;
+}
+
+void checkValues (const Array<Int>& arr, const Vector<rownr_t>& rows,
+                  uInt firstElem, uInt nelem)
+{
+  AlwaysAssertExit (arr.shape() == IPosition(2, nelem, rows.size()));
+  for (uInt i=0; i<rows.size(); ++i) {
+    for (uInt j=0; j<nelem; ++j) {
+      AlwaysAssertExit (arr(IPosition(2,j,i)) ==
+                        Int(10*rows[i] + firstElem + j));
+    }
+  }
+}
+
+// Read columns spanning multiple parts using multiple threads.
+void doParallel()
+{
+  OMP::setNumThreads (4);
+  const uInt npart = 4;
+  const rownr_t nrow = 10;
+  Block<Table> parts(npart);
+  for (uInt i=0; i<npart; ++i) {
+    parts[i] = makePart ("tConcatTable_tmp.part" + String::toString(i),
+                         i*nrow, nrow, 4);
+  }
+  Table ctab(parts);
+  AlwaysAssertExit (ctab.nrow() == npart*nrow);
+  ArrayColumn<Int> arr(ctab, "arr");
+  ScalarColumn<Int> sca(ctab, "sca");
+  Vector<rownr_t> allRows(npart*nrow);
+  indgen (allRows);
+  checkValues (arr.getColumn(), allRows, 0, 4);
+  checkValues (arr.getColumn(Slicer(IPosition(1,1), IPosition(1,2))),
+               allRows, 1, 2);
+  checkValues (arr.getColumnRange(Slicer(IPosition(1,5), IPosition(1,27))),
+               allRows(Slice(5,27)), 0, 4);
+  Vector<rownr_t> rows(5);
+  rows[0] = 39; rows[1] = 3; rows[2] = 15; rows[3] = 16; rows[4] = 27;
+  checkValues (arr.getColumnCells(RefRows(rows)), rows, 0, 4);
+  checkValues (arr.getColumnCells(RefRows(rows),
+                                  Slicer(IPosition(1,2), IPosition(1,2))),
+               rows, 2, 2);
+  Vector<Int> scaVals = sca.getColumn();
+  for (uInt i=0; i<scaVals.size(); ++i) {
+    AlwaysAssertExit (scaVals[i] == Int(i));
+  }
+  // An exception in one of the parts must reach the caller.
+  // The last part has arrays of another shape, so reading it fails.
+  Block<Table> badParts(parts);
+  badParts.resize (npart+1, True, True);
+  badParts[npart] = makePart ("tConcatTable_tmp.part" +
+                              String::toString(npart),
+                              npart*nrow, nrow, 3);
+  Table badTab(badParts);
+  ArrayColumn<Int> badArr(badTab, "arr");
+  Bool failed = False;
+  try {
+    badArr.getColumn();
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // The other parts can still be read.
+  checkValues (badArr.getColumnRange(Slicer(IPosition(1,0),
+                                            IPosition(1,npart*nrow))),
+               allRows, 0, 4);
+}
+
 int main (int argc, const char* argv[])
 {
-  // Only execute when table names have been given.
   try {
+    doParallel();
+    // Only execute when table names have been given.
     if (argc > 1) {
       if (argc == 2) {
 	doIt1 (argv[1]);
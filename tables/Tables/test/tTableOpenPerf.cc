@@ -0,0 +1,160 @@
+//# tTableOpenPerf.cc: Time the opening of a table with many data managers
+//# Copyright (C) 2003
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/sstream.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+// This program times the reading of table metadata, i.e. opening a table
+// with many columns (each with its own data manager) and keywords. It also
+// times reading many data manager headers with AipsIO::getnew (a new
+// buffer per header) and AipsIO::getinto (a reused buffer).
+// Run it as:  tTableOpenPerf [nloops]
+
+
+void makeTable (const String& name, uInt ncol, uInt nkey)
+{
+  TableDesc td;
+  for (uInt i=0; i<ncol; ++i) {
+    const String colName = "col" + String::toString(i);
+    if (i%2 == 0) {
+      td.addColumn (ScalarColumnDesc<Int>(colName));
+    } else {
+      td.addColumn (ArrayColumnDesc<Float>(colName, IPosition(1,4),
+                                           ColumnDesc::FixedShape));
+    }
+  }
+  SetupNewTable newtab(name, td, Table::New);
+  for (uInt i=0; i<ncol; ++i) {
+    const String colName = "col" + String::toString(i);
+    if (i%3 == 0) {
+      IncrementalStMan ism("ism" + String::toString(i));
+      newtab.bindColumn (colName, ism);
+    } else {
+      StandardStMan ssm("ssm" + String::toString(i));
+      newtab.bindColumn (colName, ssm);
+    }
+  }
+  Table tab(newtab, 10);
+  TableRecord& keys = tab.rwKeywordSet();
+  for (uInt i=0; i<nkey; ++i) {
+    const String keyName = "key" + String::toString(i);
+    if (i%4 == 0) {
+      TableRecord sub;
+      sub.define ("val", Int(i));
+      sub.define ("name", keyName);
+      keys.defineRecord (keyName, sub);
+    } else {
+      keys.define (keyName, Double(i));
+    }
+  }
+  for (uInt i=0; i<ncol; ++i) {
+    tab.rwKeywordSet().define ("unit" + String::toString(i), "Jy");
+    TableColumn col(tab, "col" + String::toString(i));
+    col.rwKeywordSet().define ("UNIT", "Jy");
+  }
+}
+
+void timeOpen (const String& name, uInt nloops)
+{
+  Timer timer;
+  uInt ncol = 0;
+  for (uInt i=0; i<nloops; ++i) {
+    Table tab(name);
+    ncol += tab.tableDesc().ncolumn();
+  }
+  timer.show ("  open table        ");
+  AlwaysAssertExit (ncol > 0);
+}
+
+void timeHeaders (uInt nhdr, uInt nloops)
+{
+  // Write headers of varying length like ColumnSet::putFile does.
+  std::shared_ptr<MemoryIO> memio = std::make_shared<MemoryIO>();
+  {
+    AipsIO aio(memio);
+    aio.putstart ("Headers", 1);
+    Block<uChar> hdr(500);
+    for (uInt i=0; i<nhdr; ++i) {
+      aio.put (100 + 4*(i%100), hdr.storage());
+    }
+    aio.putend();
+  }
+  Timer timer;
+  for (uInt j=0; j<nloops; ++j) {
+    memio->seek (0);
+    AipsIO aio(memio);
+    aio.getstart ("Headers");
+    for (uInt i=0; i<nhdr; ++i) {
+      uChar* data;
+      uInt leng;
+      aio.getnew (leng, data);
+      delete [] data;
+    }
+    aio.getend();
+  }
+  timer.show ("  headers getnew    ");
+  timer.mark();
+  for (uInt j=0; j<nloops; ++j) {
+    memio->seek (0);
+    AipsIO aio(memio);
+    aio.getstart ("Headers");
+    Block<uChar> data;
+    for (uInt i=0; i<nhdr; ++i) {
+      uInt leng;
+      aio.getinto (leng, data);
+    }
+    aio.getend();
+  }
+  timer.show ("  headers getinto   ");
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt nloops = 100;
+    if (argc > 1) {
+      istringstream istr(argv[1]);
+      istr >> nloops;
+    }
+    const String name("tTableOpenPerf_tmp.data");
+    makeTable (name, 100, 200);
+    cout << "Table with 100 columns/data managers and 300 keywords" << endl;
+    timeOpen (name, nloops);
+    cout << "1000 data manager headers" << endl;
+    timeHeaders (1000, 10*nloops);
+    TableUtil::deleteTable (name);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}